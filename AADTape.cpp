@@ -0,0 +1,58 @@
+#include "AADTape.h"
+#include "Telemetry.h"
+#include <stdexcept>
+
+AADTape::AADTape(std::pmr::memory_resource* resource)
+    : _resource(resource), _blocks(resource), _size(0), _capacity(0), _mark(0)
+{
+    if (!_resource) {
+        throw std::invalid_argument("Null memory resource.");
+    }
+}
+
+AADTape::~AADTape() {
+    for (Node* block : _blocks) {
+        _resource->deallocate(block, BLOCK_SIZE * sizeof(Node), alignof(Node));
+    }
+}
+
+void AADTape::addBlock() {
+    if (_blocks.size() >= (std::size_t(1) << (32 - BLOCK_BITS))) {
+        throw std::length_error("AAD tape is full.");
+    }
+    _blocks.push_back(static_cast<Node*>(_resource->allocate(BLOCK_SIZE * sizeof(Node), alignof(Node))));
+    _capacity += BLOCK_SIZE;
+    TELEMETRY_COUNT(Allocations, 1);
+}
+
+// Parcours à rebours des noeuds [to, from] : chaque noeud transmet son adjoint à ses parents
+void AADTape::sweep(std::size_t from, std::size_t to) {
+    for (std::size_t i = from + 1; i-- > to;) {
+        const Node& n = node(static_cast<std::uint32_t>(i));
+        if (n.adjoint == 0.0) continue;
+        if (n.parent[0] != NO_PARENT) node(n.parent[0]).adjoint += n.partial[0] * n.adjoint;
+        if (n.parent[1] != NO_PARENT) node(n.parent[1]).adjoint += n.partial[1] * n.adjoint;
+    }
+}
+
+void AADTape::propagate(std::uint32_t output, std::uint32_t stop) {
+    if (output >= _size) {
+        throw std::out_of_range("Output node is not on the tape.");
+    }
+    node(output).adjoint = 1.0;
+    sweep(output, stop);
+}
+
+void AADTape::propagateMarked() {
+    if (_mark > 0) sweep(_mark - 1, 0);
+}
+
+AADTape*& AADTape::active() {
+    thread_local AADTape* tape = nullptr;
+    return tape;
+}
+
+AADTape& AADTape::threadLocal() {
+    thread_local AADTape tape;
+    return tape;
+}
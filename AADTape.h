@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/*Bande (tape) de différentiation automatique adjointe (AAD).
+	Chaque opération élémentaire sur des adouble enregistre un noeud : au plus deux parents et les dérivées
+	partielles locales. propagate() parcourt la bande à rebours et accumule les adjoints : toutes les
+	dérivées d'une sortie par rapport à toutes les entrées coûtent un petit multiple d'une évaluation.
+	Les noeuds sont stockés par blocs de taille fixe alloués sur une ressource mémoire (ex : PricingArena) :
+	un bloc n'est jamais déplacé, et clear() conserve les blocs pour le calcul suivant.
+	Pour une simulation Monte Carlo, mark() fige le début de la bande (entrées et pré-calculs) : chaque
+	trajectoire est enregistrée après la marque, propagée jusqu'à la marque puis effacée par rewind().*/
+class AADTape {
+public:
+	static const std::uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+	struct Node {
+		double adjoint;
+		double partial[2];
+		std::uint32_t parent[2];
+	};
+
+	explicit AADTape(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+	~AADTape();
+
+	AADTape(const AADTape&) = delete;
+	AADTape& operator=(const AADTape&) = delete;
+
+	// Enregistre un noeud (entrée si aucun parent) et retourne son indice
+	std::uint32_t record(std::uint32_t p0 = NO_PARENT, double d0 = 0.0, std::uint32_t p1 = NO_PARENT, double d1 = 0.0) {
+		if (_size == _capacity) addBlock();
+		Node& node = _blocks[_size >> BLOCK_BITS][_size & BLOCK_MASK];
+		node.adjoint = 0.0;
+		node.partial[0] = d0;
+		node.partial[1] = d1;
+		node.parent[0] = p0;
+		node.parent[1] = p1;
+		return static_cast<std::uint32_t>(_size++);
+	}
+
+	Node& node(std::uint32_t i) { return _blocks[i >> BLOCK_BITS][i & BLOCK_MASK]; }
+	const Node& node(std::uint32_t i) const { return _blocks[i >> BLOCK_BITS][i & BLOCK_MASK]; }
+
+	double adjoint(std::uint32_t i) const { return node(i).adjoint; }
+
+	// Fixe l'adjoint de la sortie à 1 et propage jusqu'au noeud stop inclus (0 : toute la bande)
+	void propagate(std::uint32_t output, std::uint32_t stop = 0);
+
+	// Fixe l'adjoint de la sortie à 1 et propage jusqu'à la marque (les noeuds de tête accumulent leurs adjoints)
+	void propagateToMark(std::uint32_t output) { propagate(output, static_cast<std::uint32_t>(_mark)); }
+
+	// Propage les adjoints accumulés sur la partie de la bande antérieure à la marque
+	void propagateMarked();
+
+	// Fige la taille courante de la bande
+	void mark() { _mark = _size; }
+
+	// Efface les noeuds postérieurs à la marque
+	void rewind() { _size = _mark; }
+
+	// Vide la bande (les blocs sont conservés)
+	void clear() { _size = 0; _mark = 0; }
+
+	std::size_t size() const { return _size; }
+
+	// Bande propre au thread courant, réutilisée par les calculs de sensibilités des pricers (qui la vident)
+	static AADTape& threadLocal();
+
+	// Bande active du thread courant (nullptr : les adouble se comportent comme des double)
+	static AADTape*& active();
+
+	// Active une bande pour la durée d'une portée
+	class Scope {
+	private:
+		AADTape* _previous;
+	public:
+		explicit Scope(AADTape& tape) : _previous(active()) { active() = &tape; }
+		~Scope() { active() = _previous; }
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+
+private:
+	static const std::size_t BLOCK_BITS = 14;
+	static const std::size_t BLOCK_SIZE = std::size_t(1) << BLOCK_BITS;
+	static const std::size_t BLOCK_MASK = BLOCK_SIZE - 1;
+
+	std::pmr::memory_resource* _resource;
+	std::pmr::vector<Node*> _blocks;
+	std::size_t _size;
+	std::size_t _capacity;
+	std::size_t _mark;
+
+	void addBlock();
+	void sweep(std::size_t from, std::size_t to);
+};
@@ -13,7 +13,7 @@ public:
 	AmericanCallOption(double expiry, double strike)
 		: AmericanOption(expiry), _strike(strike)
 	{
-		//Vrification de la validit des paramtres
+		//Vérification de la validité des paramètres
 		if ( strike < 0.0) {
 			throw std::invalid_argument("Strike must be non-negative.");
 		}
@@ -23,4 +23,14 @@ public:
 	double payoff(double S) const override {
 		return std::max(S - _strike, 0.0);
 	}
+
+	// Accès en lecture au strike
+	double getStrike() const override {
+		return _strike;
+	}
+
+	// Indique que l'option est un Call.
+	optionType GetOptionType() const override {
+		return Call;
+	}
 };
\ No newline at end of file
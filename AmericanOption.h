@@ -1,19 +1,28 @@
 #pragma once
 #include "Option.h"
 
-// Classe abstraite intermdiaire reprsentant une option amricaine.
-// Elle ne dfinit aucun payoff : elle sert uniquement  identifier
-// les options pouvant tre exerces avant maturit.
+// Classe abstraite intermédiaire représentant une option américaine.
+// Elle ne définit aucun payoff : elle sert uniquement à identifier
+// les options pouvant être exercées avant maturité.
 class AmericanOption : public Option {
 public:
+	// Type de l'option américaine
+	enum optionType { Call, Put };
+
 	// Constructeur explicite.
-   // L'expiry est transmis  la classe de base Option, qui se charge de vrifier que celui-ci est non ngatif.
+   // L'expiry est transmis à la classe de base Option, qui se charge de vérifier que celui-ci est non négatif.
 	explicit AmericanOption(double expiry)
 		: Option(expiry) {
 	}
 
-	// Indique que l'option est de type amricain.
+	// Indique que l'option est de type américain.
 	bool isAmericanOption() const override {
 		return true;
 	}
+
+	// Strike de l'option (défini dans AmericanCallOption/AmericanPutOption)
+	virtual double getStrike() const = 0;
+
+	// Retourne le type de l'option (Call ou Put)
+	virtual optionType GetOptionType() const = 0;
 };
\ No newline at end of file
@@ -3,8 +3,8 @@
 #include <algorithm>
 #include <stdexcept>
 
-// Option de vente amricaine (American Put).
-// Le dtenteur peut exercer l'option  tout moment avant l'chance.
+// Option de vente américaine (American Put).
+// Le détenteur peut exercer l'option à tout moment avant l'échéance.
 class AmericanPutOption : public AmericanOption {
 	private:
 		double _strike;
@@ -14,7 +14,7 @@ class AmericanPutOption : public AmericanOption {
 		AmericanPutOption(double expiry, double strike)
 			: AmericanOption(expiry), _strike(strike)
 		{
-			// Le contrle de expiry est effectu dans Option. Ici, on vrifie uniquement la validit du strike.
+			// Le contrôle de expiry est effectué dans Option. Ici, on vérifie uniquement la validité du strike.
 			if (strike < 0.0) {
 				throw std::invalid_argument("Strike must be non-negative.");
 			}
@@ -24,4 +24,14 @@ class AmericanPutOption : public AmericanOption {
 		double payoff(double S) const override {
 			return std::max(_strike - S, 0.0);
 		}
+
+		// Accès en lecture au strike
+		double getStrike() const override {
+			return _strike;
+		}
+
+		// Indique que l'option est un Put.
+		optionType GetOptionType() const override {
+			return Put;
+		}
 };
@@ -0,0 +1,158 @@
+#include "AsianAnalyticPricer.h"
+#include "BlackScholesMCPricer.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    // Fonction de répartition de la loi normale standard N(0,1)
+    inline double N(double x) {
+        return 0.5 * std::erfc(-x / std::sqrt(2.0));
+    }
+}
+
+// Constructeur : mêmes validations que les autres pricers Black-Scholes.
+AsianAnalyticPricer::AsianAnalyticPricer(AsianOption* option,
+    double asset_price,
+    double interest_rate,
+    double volatility)
+    : _option(option), _S(asset_price), _r(interest_rate), _sigma(volatility), _valuationTime(0.0)
+{
+    if (!option) throw std::invalid_argument("Null Asian option pointer.");
+    if (_S <= 0.0) throw std::invalid_argument("Asset price must be positive.");
+    if (_sigma < 0.0) throw std::invalid_argument("Volatility must be non-negative.");
+
+    // Les dates doivent être strictement croissantes (comme dans BlackScholesMCPricer::generate)
+    double t_prev = 0.0;
+    for (double t : _option->getTimeSteps()) {
+        if (t - t_prev <= 0.0) {
+            throw std::invalid_argument("Asian timeSteps must be strictly increasing.");
+        }
+        t_prev = t;
+    }
+}
+
+void AsianAnalyticPricer::setFixings(const AsianFixingState& fixings, double valuation_time) {
+    _option->validateFixings(fixings.getNbFixed(), valuation_time);
+    _fixings = fixings;
+    _valuationTime = valuation_time;
+}
+
+// Prix d'une option de strike K sur X log-normale, E[X] = forward, Var[ln X] = variance, payée à l'expiry.
+double AsianAnalyticPricer::lognormalPrice(double forward, double variance, double strike) const {
+    const double disc = std::exp(-_r * (_option->getExpiry() - _valuationTime));
+    const bool isCall = _option->GetOptionType() == AsianOption::Call;
+
+    // Cas dégénérés : strike négatif ou nul (payoff linéaire) ou variance nulle (payoff déterministe)
+    if (strike <= 0.0) {
+        return isCall ? disc * (forward - strike) : 0.0;
+    }
+    if (variance <= 0.0) {
+        return disc * (isCall ? std::max(forward - strike, 0.0) : std::max(strike - forward, 0.0));
+    }
+
+    const double sd = std::sqrt(variance);
+    const double d1 = (std::log(forward / strike) + 0.5 * variance) / sd;
+    const double d2 = d1 - sd;
+
+    if (isCall) {
+        return disc * (forward * N(d1) - strike * N(d2));
+    }
+    return disc * (strike * N(-d2) - forward * N(-d1));
+}
+
+/*Moments de B = (1/m) sum_{k > n} S(t_k), avec tau_k = t_k - t0 :
+    E[B]   = S/m sum_k exp(r tau_k)
+    E[B^2] = S^2/m^2 sum_k sum_l exp(r (tau_k + tau_l) + sigma^2 min(tau_k, tau_l))
+ La double somme est ramenée à O(m) grâce aux sommes suffixes de exp(r tau_l).*/
+std::vector<double> AsianAnalyticPricer::remainingMoments() const {
+    const std::vector<double>& ts = _option->getTimeSteps();
+    const std::size_t m = ts.size();
+    const std::size_t n = _fixings.getNbFixed();
+    const double s2 = _sigma * _sigma;
+
+    double first = 0.0;
+    double second = 0.0;
+    double suffix = 0.0; // sum_{l > k} exp(r tau_l)
+
+    for (std::size_t k = m; k-- > n;) {
+        const double tau = ts[k] - _valuationTime;
+        const double growth = std::exp(_r * tau);
+        first += growth;
+        // Terme diagonal (k = l) et termes croisés (k < l, min = tau_k) comptés deux fois
+        second += std::exp((2.0 * _r + s2) * tau) + 2.0 * std::exp((_r + s2) * tau) * suffix;
+        suffix += growth;
+    }
+
+    const double md = static_cast<double>(m);
+    return { _S * first / md, _S * _S * second / (md * md) };
+}
+
+std::vector<double> AsianAnalyticPricer::arithmeticMoments() const {
+    const double fixedPart = _fixings.getSum() / static_cast<double>(_option->getTimeSteps().size());
+    const std::vector<double> b = remainingMoments();
+    return { fixedPart + b[0], fixedPart * fixedPart + 2.0 * fixedPart * b[0] + b[1] };
+}
+
+/*Approximation log-normale sur la partie restante B : A = fixedPart + B, donc le payoff est celui d'une option
+  sur B de strike K - fixedPart, avec Var[ln B] = ln(E[B^2] / E[B]^2).*/
+double AsianAnalyticPricer::operator()() const {
+    const std::size_t m = _option->getTimeSteps().size();
+    const double fixedPart = _fixings.getSum() / static_cast<double>(m);
+
+    // Toutes les dates sont fixées : payoff connu
+    if (_fixings.getNbFixed() == m) {
+        return std::exp(-_r * (_option->getExpiry() - _valuationTime)) * _option->payoff(fixedPart);
+    }
+
+    const std::vector<double> b = remainingMoments();
+    const double variance = std::log(b[1] / (b[0] * b[0]));
+    return lognormalPrice(b[0], variance, _option->getStrike() - fixedPart);
+}
+
+/*Moyenne géométrique G = (prod S(t_i))^(1/m) = exp(logSum/m) * G_B, où ln G_B est gaussien avec (p = m - n dates restantes)
+    E[ln G_B]   = (p/m) ln S + (r - sigma^2/2) * sum_k tau_k / m
+    Var[ln G_B] = sigma^2/m^2 sum_k sum_l min(tau_k, tau_l) = sigma^2/m^2 sum_k (2(p - k) - 1) tau_k  (k = 1..p)*/
+double AsianAnalyticPricer::geometricPrice() const {
+    if (!_fixings.hasLogSum()) {
+        throw std::runtime_error("Geometric price requires the log-sum of the observed fixings.");
+    }
+    const std::vector<double>& ts = _option->getTimeSteps();
+    const std::size_t m = ts.size();
+    const std::size_t n = _fixings.getNbFixed();
+    const std::size_t p = m - n;
+    const double md = static_cast<double>(m);
+
+    double sumT = 0.0;
+    double sumMin = 0.0;
+    for (std::size_t k = 0; k < p; ++k) {
+        const double tau = ts[n + k] - _valuationTime;
+        sumT += tau;
+        sumMin += (2.0 * static_cast<double>(p - k) - 1.0) * tau;
+    }
+
+    const double mean = _fixings.getLogSum() / md
+        + static_cast<double>(p) / md * std::log(_S) + (_r - 0.5 * _sigma * _sigma) * sumT / md;
+    const double variance = _sigma * _sigma * sumMin / (md * md);
+    return lognormalPrice(std::exp(mean + 0.5 * variance), variance, _option->getStrike());
+}
+
+// Estimation de l'erreur contre Monte Carlo (la précision de la mesure est donnée par l'IC).
+AsianAnalyticPricer::ErrorEstimate AsianAnalyticPricer::errorEstimate(int nb_paths) const {
+    if (nb_paths < 2) {
+        throw std::invalid_argument("At least two paths are required to estimate the error.");
+    }
+    BlackScholesMCPricer mc(_option, _S, _r, _sigma);
+    if (_fixings.getNbFixed() > 0 || _valuationTime > 0.0) {
+        mc.setAsianFixings(_fixings, _valuationTime);
+    }
+    mc.generate(nb_paths);
+    const std::vector<double> ci = mc.confidenceInterval();
+
+    ErrorEstimate e;
+    e.analytic = (*this)();
+    e.monteCarlo = mc();
+    e.ciHalfWidth = 0.5 * (ci[1] - ci[0]);
+    e.error = std::fabs(e.analytic - e.monteCarlo);
+    return e;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "AsianOption.h"
+#include "AsianFixingState.h"
+#include <vector>
+
+/*Pricer analytique des options asiatiques à moyenne discrète (dates AsianOption::getTimeSteps()) sous Black-Scholes.
+	 - moyenne géométrique : prix exact (la moyenne géométrique est log-normale) ;
+	 - moyenne arithmétique : approximation de Turnbull-Wakeman / Levy, la moyenne est remplacée par une loi
+	   log-normale ayant les mêmes deux premiers moments.
+ Les moments sont calculés en O(m) pour m dates d'observation. Pour une option en cours de vie (setFixings),
+ seules les dates restantes interviennent : la partie fixée de la moyenne décale simplement le strike.*/
+class AsianAnalyticPricer {
+private:
+	AsianOption* _option;	// option à pricer
+	double _S;		// prix de l'actif sous-jacent
+	double _r;		// taux d'intérêt (continu)
+	double _sigma;	// volatilité
+
+	AsianFixingState _fixings;	// fixings déjà observés
+	double _valuationTime;		// date de valorisation (date à laquelle le spot vaut _S)
+
+	// Prix d'une option de strike K sur une variable log-normale de moyenne forward et de variance (du log) variance
+	double lognormalPrice(double forward, double variance, double strike) const;
+
+	// Moments E[B], E[B^2] de la contribution des dates restantes B = (1/m) sum_{k > n} S(t_k)
+	std::vector<double> remainingMoments() const;
+
+public:
+	// Comparaison du prix analytique avec une estimation Monte Carlo
+	struct ErrorEstimate {
+		double analytic;	// prix analytique (moment matching)
+		double monteCarlo;	// estimation Monte Carlo (BlackScholesMCPricer)
+		double ciHalfWidth;	// demi-largeur de l'intervalle de confiance à 95 % de l'estimation MC
+		double error;		// |analytic - monteCarlo|
+	};
+
+	AsianAnalyticPricer(AsianOption* option, double asset_price, double interest_rate, double volatility);
+
+	// Option en cours de vie : fixings observés et date de valorisation (le spot du constructeur est celui de cette date).
+	// La mise à jour est en O(1) ; le prochain prix ne porte que sur les dates restantes.
+	void setFixings(const AsianFixingState& fixings, double valuation_time);
+
+	// Prix de l'option à moyenne arithmétique (approximation par moment matching)
+	double operator()() const;
+
+	// Prix exact de la même option sur la moyenne géométrique des fixings (l'état des fixings doit fournir la somme
+	// des logarithmes, sinon std::runtime_error)
+	double geometricPrice() const;
+
+	// Moments de la moyenne arithmétique (conditionnellement aux fixings observés) : E[A] et E[A^2]
+	std::vector<double> arithmeticMoments() const;
+
+	// Erreur de l'approximation mesurée contre une simulation Monte Carlo de nb_paths trajectoires.
+	ErrorEstimate errorEstimate(int nb_paths) const;
+};
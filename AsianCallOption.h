@@ -3,7 +3,7 @@
 #include <algorithm> 
 #include <stdexcept>
 
-// Option asiatique de type Call. Le payoff est appliqu  la moyenne arithmtique calcule dans AsianOption::payoffPath.
+// Option asiatique de type Call. Le payoff est appliqué à la moyenne arithmétique calculée dans AsianOption::payoffPath.
 class AsianCallOption : public AsianOption {
 private:
     double _strike;
@@ -17,8 +17,18 @@ public:
         }
     }
 
-    // Payoff final : h(x) = max(x - K, 0), o x est la moyenne arithmtique calcule dans AsianOption.
+    // Payoff final : h(x) = max(x - K, 0), où x est la moyenne arithmétique calculée dans AsianOption.
     double payoff(double x) const override {
         return std::max(x - _strike, 0.0);
     }
+
+    // Accès en lecture au strike
+    double getStrike() const override {
+        return _strike;
+    }
+
+    // Indique que l'option est un Call.
+    optionType GetOptionType() const override {
+        return Call;
+    }
 };
@@ -0,0 +1,53 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+/*État des fixings déjà observés d'une option asiatique en cours de vie.
+	Seuls le nombre de fixings, leur somme (moyenne arithmétique) et la somme de leurs logarithmes
+	(moyenne géométrique) sont conservés : l'arrivée d'un nouveau fixing est une mise à jour en O(1).
+	Les pricers (BlackScholesMCPricer, AsianAnalyticPricer) ne traitent alors que les dates restantes.*/
+class AsianFixingState {
+private:
+	std::size_t _nbFixed;	// Nombre de dates d'observation déjà fixées
+	double _sum;			// Somme des fixings observés
+	double _logSum;			// Somme des logarithmes des fixings observés
+	bool _hasLogSum;		// Faux si l'état a été reconstruit sans la somme des logarithmes
+
+public:
+	// État initial : aucun fixing observé
+	AsianFixingState() : _nbFixed(0), _sum(0.0), _logSum(0.0), _hasLogSum(true) {}
+
+	// État reconstruit à partir d'un nombre de fixings et de leur somme : la moyenne géométrique est inconnue.
+	AsianFixingState(std::size_t nb_fixed, double sum)
+		: _nbFixed(nb_fixed), _sum(sum), _logSum(0.0), _hasLogSum(nb_fixed == 0)
+	{
+		if (nb_fixed > 0 && sum <= 0.0) {
+			throw std::invalid_argument("Sum of fixings must be positive.");
+		}
+	}
+
+	// État reconstruit à partir d'un nombre de fixings, de leur somme et de la somme de leurs logarithmes.
+	AsianFixingState(std::size_t nb_fixed, double sum, double log_sum)
+		: AsianFixingState(nb_fixed, sum)
+	{
+		_logSum = log_sum;
+		_hasLogSum = true;
+	}
+
+	// Enregistre un nouveau fixing (prix du sous-jacent observé à la date suivante).
+	void addFixing(double spot) {
+		if (spot <= 0.0) {
+			throw std::invalid_argument("Fixing must be positive.");
+		}
+		++_nbFixed;
+		_sum += spot;
+		_logSum += std::log(spot);
+	}
+
+	// Accès en lecture
+	std::size_t getNbFixed() const { return _nbFixed; }
+	double getSum() const { return _sum; }
+	double getLogSum() const { return _logSum; }
+	bool hasLogSum() const { return _hasLogSum; }
+};
@@ -4,13 +4,16 @@
 #include <stdexcept>
 #include <numeric>
 
-// Option asiatique : le payoff dpend de la moyenne arithmtique du chemin (S(t1), ..., S(tm)).
+// Option asiatique : le payoff dépend de la moyenne arithmétique du chemin (S(t1), ..., S(tm)).
 class AsianOption : public Option {
 private:
     std::vector<double> _timeSteps;  // (t1, t2, ..., tm)
 
 public:
-    // Constructeur : prend les dates d'observation (t1,...,tm).L'expiry est fixe  tm (= dernier lment).
+    // Type de l'option asiatique
+    enum optionType { Call, Put };
+
+    // Constructeur : prend les dates d'observation (t1,...,tm).L'expiry est fixée à tm (= dernier élément).
     explicit AsianOption(const std::vector<double>& timeSteps)
         :Option(timeSteps.empty() ? 0.0 : timeSteps.back()), _timeSteps(timeSteps)
     {
@@ -25,7 +28,14 @@ public:
     bool isAsianOption() const override {
         return true;
     }
-    // Payoff path-dependent : moyenne arithmtique du chemin, puis application du payoff(double) (dfini dans AsianCallOption/AsianPutOption).
+
+    // Strike appliqué à la moyenne (défini dans AsianCallOption/AsianPutOption)
+    virtual double getStrike() const = 0;
+
+    // Retourne le type de l'option (Call ou Put)
+    virtual optionType GetOptionType() const = 0;
+
+    // Payoff path-dependent : moyenne arithmétique du chemin, puis application du payoff(double) (défini dans AsianCallOption/AsianPutOption).
     double payoffPath(const std::vector<double>& path) const override {
 
         if (path.empty()) {
@@ -41,5 +51,32 @@ public:
 
         return payoff(average);
     
-    }  
+    }
+
+    // Vérifie qu'une date de valorisation est compatible avec nbFixed fixings déjà observés :
+    // elle doit être postérieure à la dernière date fixée et antérieure à la prochaine date d'observation.
+    void validateFixings(std::size_t nbFixed, double valuationTime) const {
+        if (nbFixed > _timeSteps.size()) {
+            throw std::invalid_argument("More fixings than observation dates.");
+        }
+        if (valuationTime < 0.0 || (nbFixed > 0 && valuationTime < _timeSteps[nbFixed - 1])) {
+            throw std::invalid_argument("Valuation time precedes the last observed fixing.");
+        }
+        if (nbFixed < _timeSteps.size() ? valuationTime >= _timeSteps[nbFixed] : valuationTime > _timeSteps.back()) {
+            throw std::invalid_argument("Valuation time is past an unobserved fixing date.");
+        }
+    }
+
+    // Payoff d'une option partiellement fixée : fixedSum est la somme des nbFixed premiers fixings,
+    // remainingPath contient les valeurs simulées aux dates restantes (t_{nbFixed+1}, ..., tm).
+    double payoffPartial(double fixedSum, std::size_t nbFixed, const std::vector<double>& remainingPath) const {
+        if (nbFixed + remainingPath.size() != _timeSteps.size()) {
+            throw std::invalid_argument("Fixed and remaining path sizes do not match the number of time steps.");
+        }
+
+        const double sum = std::accumulate(remainingPath.begin(), remainingPath.end(), fixedSum);
+        const double average = sum / static_cast<double>(_timeSteps.size());
+
+        return payoff(average);
+    }
 };
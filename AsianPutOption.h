@@ -3,7 +3,7 @@
 #include <algorithm>
 #include <stdexcept>
 
-// Option asiatique de type Put. Le payoff est appliqu  la moyenne arithmtique calcule dans AsianOption::payoffPath.
+// Option asiatique de type Put. Le payoff est appliqué à la moyenne arithmétique calculée dans AsianOption::payoffPath.
 class AsianPutOption : public AsianOption {
 private:
     double _strike;
@@ -17,8 +17,18 @@ public:
     }
 
    
-    // Payoff : h(x) = max(K - x, 0), o x est la moyenne arithmtique du chemin.
+    // Payoff : h(x) = max(K - x, 0), où x est la moyenne arithmétique du chemin.
     double payoff(double x) const override {
         return std::max(_strike - x, 0.0);
     }
+
+    // Accès en lecture au strike
+    double getStrike() const override {
+        return _strike;
+    }
+
+    // Indique que l'option est un Put.
+    optionType GetOptionType() const override {
+        return Put;
+    }
 };
@@ -0,0 +1,24 @@
+#pragma once
+#include "BarrierOption.h"
+#include <algorithm>
+#include <vector>
+
+// Option barrière de type Call : payoff vanille max(S_T - K, 0) conditionné par la barrière.
+class BarrierCallOption : public BarrierOption {
+public:
+    // Constructeur : maturité, strike, barrière, type de barrière, rebate et dates de surveillance (vide : continue).
+    BarrierCallOption(double expiry, double strike, double barrier, barrierType type, double rebate = 0.0,
+        const std::vector<double>& monitoring_dates = {})
+        : BarrierOption(expiry, strike, barrier, type, rebate, monitoring_dates) {
+    }
+
+    // Payoff vanille : max(S - K, 0)
+    double payoff(double S) const override {
+        return std::max(S - getStrike(), 0.0);
+    }
+
+    // Indique que l'option est un Call.
+    optionType GetOptionType() const override {
+        return Call;
+    }
+};
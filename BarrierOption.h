@@ -0,0 +1,91 @@
+#pragma once
+#include "Option.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+/*Option barrière européenne : le payoff vanille (défini dans BarrierCallOption/BarrierPutOption) n'est versé
+  que si la barrière a été franchie (knock-in) ou au contraire jamais franchie (knock-out) ; sinon le porteur
+  reçoit le rebate, versé à maturité. La barrière est surveillée en continu si aucune date de surveillance
+  n'est fournie, aux seules dates fournies sinon (la dernière doit être la maturité).*/
+class BarrierOption : public Option {
+private:
+    double _strike;
+    double _barrier;
+    double _rebate;
+    std::vector<double> _monitoringDates;  // vide : surveillance continue
+
+public:
+    // Type de l'option barrière
+    enum optionType { Call, Put };
+
+    // Sens de la barrière et effet de son franchissement
+    enum barrierType { UpAndOut, UpAndIn, DownAndOut, DownAndIn };
+
+    BarrierOption(double expiry, double strike, double barrier, barrierType type, double rebate,
+        const std::vector<double>& monitoring_dates)
+        : Option(expiry), _strike(strike), _barrier(barrier), _rebate(rebate),
+        _monitoringDates(monitoring_dates), _type(type)
+    {
+        if (strike < 0.0) {
+            throw std::invalid_argument("Strike must be non-negative.");
+        }
+        if (barrier <= 0.0) {
+            throw std::invalid_argument("Barrier must be positive.");
+        }
+        if (rebate < 0.0) {
+            throw std::invalid_argument("Rebate must be non-negative.");
+        }
+        // Dates de surveillance strictement croissantes, la dernière étant la maturité
+        double t_prev = 0.0;
+        for (const double t : _monitoringDates) {
+            if (t <= t_prev) {
+                throw std::invalid_argument("Monitoring dates must be positive and strictly increasing.");
+            }
+            t_prev = t;
+        }
+        if (!_monitoringDates.empty() && _monitoringDates.back() != expiry) {
+            throw std::invalid_argument("The last monitoring date must be the expiry.");
+        }
+    }
+
+    bool isBarrierOption() const override {
+        return true;
+    }
+
+    // Accès en lecture aux caractéristiques de la barrière
+    double getStrike() const { return _strike; }
+    double getBarrier() const { return _barrier; }
+    double getRebate() const { return _rebate; }
+    barrierType getBarrierType() const { return _type; }
+    const std::vector<double>& getMonitoringDates() const { return _monitoringDates; }
+
+    bool isUp() const { return _type == UpAndOut || _type == UpAndIn; }
+    bool isKnockIn() const { return _type == UpAndIn || _type == DownAndIn; }
+    bool isContinuouslyMonitored() const { return _monitoringDates.empty(); }
+
+    // Indique si le niveau S est au-delà de la barrière (barrière atteinte)
+    bool isBreached(double S) const {
+        return isUp() ? S >= _barrier : S <= _barrier;
+    }
+
+    // Retourne le type de l'option (Call ou Put)
+    virtual optionType GetOptionType() const = 0;
+
+    // Payoff à maturité connaissant S_T et le franchissement (ou non) de la barrière
+    double payoffKnocked(double ST, bool knocked) const {
+        return knocked == isKnockIn() ? payoff(ST) : _rebate;
+    }
+
+    // Payoff path-dependent : la barrière est testée en chaque point du chemin (dates de surveillance).
+    double payoffPath(const std::vector<double>& path) const override {
+        if (path.empty()) {
+            throw std::invalid_argument("Path is empty.");
+        }
+        const bool knocked = std::any_of(path.begin(), path.end(), [this](double S) { return isBreached(S); });
+        return payoffKnocked(path.back(), knocked);
+    }
+
+private:
+    barrierType _type;
+};
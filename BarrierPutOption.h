@@ -0,0 +1,24 @@
+#pragma once
+#include "BarrierOption.h"
+#include <algorithm>
+#include <vector>
+
+// Option barrière de type Put : payoff vanille max(K - S_T, 0) conditionné par la barrière.
+class BarrierPutOption : public BarrierOption {
+public:
+    // Constructeur : maturité, strike, barrière, type de barrière, rebate et dates de surveillance (vide : continue).
+    BarrierPutOption(double expiry, double strike, double barrier, barrierType type, double rebate = 0.0,
+        const std::vector<double>& monitoring_dates = {})
+        : BarrierOption(expiry, strike, barrier, type, rebate, monitoring_dates) {
+    }
+
+    // Payoff vanille : max(K - S, 0)
+    double payoff(double S) const override {
+        return std::max(getStrike() - S, 0.0);
+    }
+
+    // Indique que l'option est un Put.
+    optionType GetOptionType() const override {
+        return Put;
+    }
+};
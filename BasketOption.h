@@ -0,0 +1,26 @@
+#pragma once
+#include "MultiAssetOption.h"
+#include <stdexcept>
+#include <vector>
+
+// Option sur panier : l'agrégat est la somme pondérée sum_a w_a S_a(T). Les poids peuvent être négatifs (écart).
+class BasketOption : public MultiAssetOption {
+private:
+    std::vector<double> _weights;
+
+public:
+    BasketOption(double expiry, const std::vector<double>& weights, double strike)
+        : MultiAssetOption(expiry, weights.size(), strike), _weights(weights) {
+    }
+
+    // Accès en lecture aux poids du panier
+    const std::vector<double>& getWeights() const { return _weights; }
+
+    double aggregate(const double* spots) const override {
+        double value = 0.0;
+        for (std::size_t a = 0; a < _weights.size(); ++a) {
+            value += _weights[a] * spots[a];
+        }
+        return value;
+    }
+};
@@ -0,0 +1,23 @@
+#pragma once
+#include "BasketOption.h"
+#include <algorithm>
+#include <vector>
+
+// Option sur panier de type Put : max(K - x, 0), x = sum_a w_a S_a(T).
+class BasketPutOption : public BasketOption {
+public:
+    // Constructeur : maturité, poids du panier (un par sous-jacent) et strike.
+    BasketPutOption(double expiry, const std::vector<double>& weights, double strike)
+        : BasketOption(expiry, weights, strike) {
+    }
+
+    // Payoff sur la valeur du panier
+    double payoff(double x) const override {
+        return std::max(getStrike() - x, 0.0);
+    }
+
+    // Indique que l'option est un Put.
+    optionType GetOptionType() const override {
+        return Put;
+    }
+};
@@ -1,32 +1,42 @@
 #pragma once
 #include <vector>
+#include <memory_resource>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include "Telemetry.h"
 
-// Classe template reprsentant un arbre binaire sous forme triangulaire. Le noeud (n,i) correspond  la ligne n et  la position i (0 <= i <= n).
+/*Classe template représentant un arbre binaire sous forme triangulaire. Le noeud (n,i) correspond à la ligne n et à la position i (0 <= i <= n).
+	La mémoire provient d'une std::pmr::memory_resource (par défaut le tas global), ce qui permet de
+	construire l'arbre sur une arène (voir PricingArena).*/
 template<typename T>
 class BinaryTree {
 private:
 	int _depth; // Profondeur de l'arbre
-	std::vector<std::vector<T>> _tree; // Structure triangulaire stockant les valeurs des noeuds
+	std::pmr::vector<std::pmr::vector<T>> _tree; // Structure triangulaire stockant les valeurs des noeuds
 
 public:
-	// Constructeur par dfaut : arbre vide de profondeur 0
-	BinaryTree() : _depth(0) {}
+	// Constructeur par défaut : arbre vide de profondeur 0, alloué sur la ressource mémoire fournie
+	explicit BinaryTree(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		: _depth(0), _tree(resource) {}
 
-	// Initialise la profondeur de l'arbre et alloue la structure triangulaire. La ligne n contient exactement n+1 noeuds.
+	// Initialise la profondeur de l'arbre et remet les noeuds à leur valeur par défaut. La ligne n contient exactement n+1 noeuds.
+	// Les lignes déjà allouées sont réutilisées : changer de profondeur ne réalloue que les lignes qui grandissent.
 	void setDepth(int depth) {
 		_depth = depth;
-		_tree.clear();
-		_tree.resize(depth + 1);
+		if (_tree.size() < static_cast<std::size_t>(depth) + 1) {
+			_tree.resize(depth + 1);
+		}
 
 		for (int n = 0; n <= depth; ++n) {
-			_tree[n].resize(n + 1);
+			if (_tree[n].capacity() < static_cast<std::size_t>(n) + 1) {
+				TELEMETRY_COUNT(Allocations, 1);
+			}
+			_tree[n].assign(n + 1, T());
 		}
 	}
 
-	// Affecte la valeur du noeud (n,i). Des vrifications sont effectues pour viter les accs invalides.
+	// Affecte la valeur du noeud (n,i). Des vérifications sont effectuées pour éviter les accès invalides.
 	void setNode(int n, int i, const T& value) {
 				if (n < 0 || n > _depth || i < 0 || i > n) {
 			throw std::out_of_range("Invalid node indices");
@@ -34,7 +44,7 @@ public:
 		_tree[n][i] = value;
 	}
 
-	// Retourne la valeur stocke au noeud (n,i). Les indices sont vrifis afin d'assurer la scurit
+	// Retourne la valeur stockée au noeud (n,i). Les indices sont vérifiés afin d'assurer la sécurité
 	T getNode(int n, int i) const {
 		if (n < 0 || n > _depth || i < 0 || i > n) {
 			throw std::out_of_range("Invalid node indices");
@@ -48,11 +58,11 @@ public:
 	}
 
 	/*Affiche le contenu de l'arbre. L'affichage se fait en deux parties :
-		-1) une reprsentation triangulaire type "tableau"
-		-2) une reprsentation graphique en forme d'arbre avec branches "/ \"
-	 Cette prsentation correspond aux figures fournies dans l'nonc.*/
+		-1) une représentation triangulaire type "tableau"
+		-2) une représentation graphique en forme d'arbre avec branches "/ \"
+	 Cette présentation correspond aux figures fournies dans l'énoncé.*/
 	void display() const {
-		// Formatage numrique uniforme pour l'affichage
+		// Formatage numérique uniforme pour l'affichage
 		std::cout << std::fixed << std::setprecision(4);
 
 		//Affichage sous forme triangulaire simple
@@ -65,7 +75,7 @@ public:
 		std::cout << '\n';
 		if (_depth < 0) return;
 
-		//Calcul dynamique de la largeur maximale d'un noeud. Cela permet un affichage centr et lisible, quelle que soit la taille des valeurs.
+		//Calcul dynamique de la largeur maximale d'un noeud. Cela permet un affichage centré et lisible, quelle que soit la taille des valeurs.
 		int maxValWidth = 1;
 		for (int n = 0; n <= _depth; ++n)
 			for (int i = 0; i <= n; ++i)
@@ -96,7 +106,7 @@ public:
 				std::cout << std::string(indentBranches, ' ');
 
 				for (int i = 0; i <= n; ++i) {
-					// Reprsentation des liens entre les noeuds
+					// Représentation des liens entre les noeuds
 					std::cout << "/ \\";
 					if (i < n) std::cout << std::string(BETWEEN + COL - 3, ' ');
 				}
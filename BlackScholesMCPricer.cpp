@@ -1,10 +1,177 @@
 #include "BlackScholesMCPricer.h"
+#include <algorithm>
 #include <cmath>
 #include "AsianOption.h"
+#include "BarrierOption.h"
+#include "LookbackOption.h"
+#include "PricingCache.h"
+#include "ScriptedOption.h"
+#include "Telemetry.h"
+#include "adouble.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
 #include <stdexcept>
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
 
-// Constructeur du pricer Monte Carlo Black-Scholes. Initialise les paramtres du modle et l'estimateur incrmental.
+namespace {
+    const char* CHECKPOINT_MAGIC = "BSMC-CHECKPOINT";
+    const int CHECKPOINT_VERSION = 1;
+
+    // Seuil de probabilité du support en deçà duquel le mode Automatic passe en ImportanceStratified
+    const double TAIL_PROBABILITY = 0.10;
+
+    double norm_pdf(double x) {
+        return 0.3989422804014327 * std::exp(-0.5 * x * x);
+    }
+
+    /*Quantile de la loi normale (approximation rationnelle d'Acklam, erreur relative 1.15e-9) suivi d'un pas
+      de Halley sur la fonction de répartition, ce qui ramène l'erreur à la précision machine.*/
+    double inverse_norm_cdf(double p) {
+        static const double a[] = { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+            1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00 };
+        static const double b[] = { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+            6.680131188771972e+01, -1.328068155288572e+01 };
+        static const double c[] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+            -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+        static const double d[] = { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+            3.754408661907416e+00 };
+        const double low = 0.02425;
+
+        p = std::min(std::max(p, std::numeric_limits<double>::min()), 1.0 - std::numeric_limits<double>::epsilon());
+        double x;
+        if (p < low) {
+            const double q = std::sqrt(-2.0 * std::log(p));
+            x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+                / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+        }
+        else if (p <= 1.0 - low) {
+            const double q = p - 0.5;
+            const double r = q * q;
+            x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+                / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+        }
+        else {
+            const double q = std::sqrt(-2.0 * std::log(1.0 - p));
+            x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+                / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+        }
+
+        // Pas de Halley
+        const double e = 0.5 * std::erfc(-x / std::sqrt(2.0)) - p;
+        const double u = e * 2.5066282746310002 * std::exp(0.5 * x * x);
+        return x - u / (1.0 + 0.5 * x * u);
+    }
+
+    // Écriture exacte d'un réel (format hexadécimal, relu par std::strtod)
+    std::string hex(double x) {
+        std::ostringstream os;
+        os << std::hexfloat << x;
+        return os.str();
+    }
+
+    double parseHex(const std::string& s) {
+        char* end = nullptr;
+        const double x = std::strtod(s.c_str(), &end);
+        if (end == s.c_str() || *end != '\0') {
+            throw std::runtime_error("Invalid number in checkpoint: " + s);
+        }
+        return x;
+    }
+
+    // Empreinte FNV-1a (64 bits) d'un texte : type concret de l'option et source d'un script
+    std::uint64_t fingerprint(const std::string& text) {
+        std::uint64_t h = 0xcbf29ce484222325ull;
+        for (const unsigned char c : text) {
+            h = (h ^ c) * 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    /*Suivi d'une trajectoire pour les options à barrière et lookback. En surveillance continue, seules les dates
+      du schéma sont simulées ; entre deux dates, ln S conditionné à ses extrémités est un pont brownien de
+      variance totale v, ce qui donne exactement :
+        - la probabilité de franchir la barrière B, exp(-2 ln(B/S_a) ln(B/S_b) / v) : on accumule la probabilité
+          de survie (espérance conditionnelle, sans tirage supplémentaire) ;
+        - le minimum (ou le maximum) de l'intervalle, (x_a + x_b -/+ sqrt((x_b - x_a)^2 - 2 v ln U)) / 2.
+      Aucune grille fine n'est donc nécessaire. En surveillance discrète, seules les dates simulées comptent.*/
+    class PathMonitor {
+    private:
+        const BarrierOption* _barrier;
+        const LookbackOption* _lookback;
+        bool _continuous, _useMinimum;
+        bool _knocked;
+        double _survival, _minimum, _maximum;
+
+    public:
+        explicit PathMonitor(const Option* option)
+            : _barrier(option->isBarrierOption() ? static_cast<const BarrierOption*>(option) : nullptr),
+            _lookback(option->isLookbackOption() ? static_cast<const LookbackOption*>(option) : nullptr),
+            _continuous(_barrier ? _barrier->isContinuouslyMonitored() : _lookback && _lookback->isContinuouslyMonitored()),
+            _useMinimum(_lookback && _lookback->usesMinimum()),
+            _knocked(false), _survival(1.0), _minimum(0.0), _maximum(0.0) {
+        }
+
+        bool active() const { return _barrier || _lookback; }
+        bool continuous() const { return _continuous; }
+
+        // Tirages uniformes supplémentaires par intervalle (extrême du pont brownien)
+        bool drawsExtremes() const { return _lookback && _continuous; }
+
+        // Début de trajectoire : le spot initial n'est surveillé qu'en continu
+        void start(double S0) {
+            _knocked = _continuous && _barrier && _barrier->isBreached(S0);
+            _survival = 1.0;
+            _minimum = _continuous ? S0 : std::numeric_limits<double>::infinity();
+            _maximum = _continuous ? S0 : -std::numeric_limits<double>::infinity();
+        }
+
+        // Intervalle de S_a à S_b, de variance v pour ln S
+        void observe(double Sa, double Sb, double variance) {
+            if (_barrier) {
+                if (_barrier->isBreached(Sb)) {
+                    _knocked = true;
+                }
+                else if (_continuous && !_knocked && variance > 0.0) {
+                    const double B = _barrier->getBarrier();
+                    _survival *= 1.0 - std::exp(-2.0 * std::log(B / Sa) * std::log(B / Sb) / variance);
+                }
+            }
+            if (_lookback) {
+                double extreme = Sb;
+                if (_continuous) {
+                    const double xa = std::log(Sa), xb = std::log(Sb);
+                    const double spread = std::sqrt((xb - xa) * (xb - xa) - 2.0 * variance * std::log(1.0 - MT::rand_unif()));
+                    extreme = std::exp(0.5 * (xa + xb + (_useMinimum ? -spread : spread)));
+                }
+                _minimum = std::min(_minimum, extreme);
+                _maximum = std::max(_maximum, extreme);
+            }
+        }
+
+        double payoff(double ST) const {
+            if (_lookback) {
+                return _lookback->payoffExtremes(ST, _minimum, _maximum);
+            }
+            if (_knocked || _survival == 1.0) {
+                return _barrier->payoffKnocked(ST, _knocked);
+            }
+            return _survival * _barrier->payoffKnocked(ST, false) + (1.0 - _survival) * _barrier->payoffKnocked(ST, true);
+        }
+    };
+}
+
+// Constructeur du pricer Monte Carlo Black-Scholes. Initialise les paramètres du modèle et l'estimateur incrémental.
 BlackScholesMCPricer::BlackScholesMCPricer(Option* option,
     double initial_price,
     double interest_rate,
@@ -15,12 +182,23 @@ BlackScholesMCPricer::BlackScholesMCPricer(Option* option,
     _sigma(volatility),
     _nbPaths(0),
     _estimate(0.0),
-    _M2(0.0)
+    _M2(0.0),
+    _valuationTime(0.0),
+    _localVolStepsPerYear(0),
+    _samplingMode(Automatic),
+    _nbStrata(64),
+    _plainMoment(0.0),
+    _momentPaths(0),
+    _precision(DoublePrecision),
+    _control(nullptr)
 {
-    // Vrification de la validit des paramtres
+    // Vérification de la validité des paramètres
     if (!_option) {
         throw std::invalid_argument("Option pointer is null.");
     }
+    if (_option->isMultiAssetOption()) {
+        throw std::invalid_argument("Multi-asset options are priced by MultiAssetMCPricer.");
+    }
     if (_S0 <= 0.0) {
         throw std::invalid_argument("Initial price must be positive.");
     }
@@ -29,98 +207,744 @@ BlackScholesMCPricer::BlackScholesMCPricer(Option* option,
     }
 }
 
-// Gnre nb_paths trajectoires supplmentaires sous Black-Scholes et met  jour l'estimation du prix par moyenne incrmentale.
-void BlackScholesMCPricer::generate(int nb_paths) {
-    if (nb_paths <= 0) {
-        throw std::invalid_argument("Number of paths must be positive.");
+// Enregistre l'état des fixings ; l'estimation précédente portait sur un autre problème et est abandonnée.
+void BlackScholesMCPricer::setAsianFixings(const AsianFixingState& fixings, double valuation_time) {
+    const AsianOption* asian = dynamic_cast<const AsianOption*>(_option);
+    if (!asian) {
+        throw std::invalid_argument("Fixings can only be set for Asian options.");
     }
+    asian->validateFixings(fixings.getNbFixed(), valuation_time);
 
-    // Maturit de l'option
-    const double T = _option->getExpiry();
-    if (T < 0.0) {
-        throw std::invalid_argument("Expiry must be non-negative.");
+    _fixings = fixings;
+    _valuationTime = valuation_time;
+    resetEstimator();
+}
+
+void BlackScholesMCPricer::setTermStructures(const TermStructure& rate, const TermStructure& volatility) {
+    _rateCurve = std::make_shared<const TermStructure>(rate);
+    _volatilityCurve = std::make_shared<const TermStructure>(volatility);
+    resetEstimator();
+}
+
+void BlackScholesMCPricer::setLocalVolatility(std::shared_ptr<const LocalVolSurface> surface, int steps_per_year) {
+    if (!surface) {
+        throw std::invalid_argument("Local volatility surface is null.");
+    }
+    if (steps_per_year <= 0) {
+        throw std::invalid_argument("Number of steps per year must be positive.");
     }
+    _localVol = std::move(surface);
+    _localVolStepsPerYear = steps_per_year;
+    resetEstimator();
+}
 
-    // Facteur d'actualisation
-    const double disc = std::exp(-_r * T);
+void BlackScholesMCPricer::setSampling(samplingMode mode, int nb_strata) {
+    if (nb_strata <= 0) {
+        throw std::invalid_argument("Number of strata must be positive.");
+    }
+    _samplingMode = mode;
+    _nbStrata = nb_strata;
+    resetEstimator();
+}
 
-    // Identification du type d'option
-    const bool isAsian = _option->isAsianOption();
+void BlackScholesMCPricer::setPrecision(computePrecision precision) {
+    _precision = precision;
+    resetEstimator();
+}
 
-    // Pr-calculs pour le cas europen (m = 1)
-    const double driftT = (_r - 0.5 * _sigma * _sigma) * T;
-    const double diffT = _sigma * std::sqrt(T);
+PrecisionReport BlackScholesMCPricer::comparePrecision(int nb_paths) const {
+    BlackScholesMCPricer reference(*this), single(*this);
+    reference.setPrecision(DoublePrecision);
+    single.setPrecision(SinglePrecision);
 
-    // Pointeurs utiliss uniquement dans le cas asiatique
-    const AsianOption* asian = nullptr;
-    const std::vector<double>* ts = nullptr;
+    // Mêmes tirages pour les deux calculs
+    const std::string rng = MT::getState();
+    PrecisionReport report;
+    auto t0 = std::chrono::steady_clock::now();
+    reference.generate(nb_paths);
+    auto t1 = std::chrono::steady_clock::now();
+    MT::setState(rng);
+    single.generate(nb_paths);
+    auto t2 = std::chrono::steady_clock::now();
 
-    if (isAsian) {
+    report.setValues(reference(), single());
+    report.doubleSeconds = std::chrono::duration<double>(t1 - t0).count();
+    report.singleSeconds = std::chrono::duration<double>(t2 - t1).count();
+    if (reference._nbPaths >= 2) {
+        const std::vector<double> ci = reference.confidenceInterval();
+        report.statisticalError = 0.5 * (ci[1] - ci[0]);
+    }
+    return report;
+}
+
+BlackScholesMCPricer::samplingMode BlackScholesMCPricer::getSampling() const {
+    return _schedule.ready ? _schedule.sampling : _samplingMode;
+}
+
+double BlackScholesMCPricer::getVarianceReduction() const {
+    if (_nbPaths < 2 || _momentPaths == 0) {
+        throw std::runtime_error("At least two paths are required to compute the variance reduction.");
+    }
+    const double plain = _plainMoment / static_cast<double>(_momentPaths) - _estimate * _estimate;
+    const double achieved = _M2 / static_cast<double>(_nbPaths - 1) * _schedule.strata;
+    if (achieved <= 0.0) {
+        return plain > 0.0 ? std::numeric_limits<double>::infinity() : 1.0;
+    }
+    return std::max(plain, 0.0) / achieved;
+}
 
-        // Rcupration des dates d'observation
-        asian = dynamic_cast<const AsianOption*>(_option);
+void BlackScholesMCPricer::resetEstimator() {
+    _schedule.ready = false;
+    _nbPaths = 0;
+    _estimate = 0.0;
+    _M2 = 0.0;
+    _plainMoment = 0.0;
+    _momentPaths = 0;
+}
+
+double BlackScholesMCPricer::rateIntegral(double t0, double t1) const {
+    return _rateCurve ? _rateCurve->integral(t0, t1) : _r * (t1 - t0);
+}
 
+std::vector<double> BlackScholesMCPricer::simulationDates() const {
+    // Maturité de l'option
+    const double T = _option->getExpiry();
+    if (T < 0.0) {
+        throw std::invalid_argument("Expiry must be non-negative.");
+    }
+
+    std::vector<double> dates;
+    if (_option->isAsianOption()) {
+        const AsianOption* asian = dynamic_cast<const AsianOption*>(_option);
         if (!asian) {
             throw std::runtime_error("Option says it is Asian, but cannot cast to AsianOption.");
         }
-        ts = &asian->getTimeSteps();
-        if (ts->empty()) {
+        const std::vector<double>& ts = asian->getTimeSteps();
+        if (ts.empty()) {
             throw std::runtime_error("Asian timeSteps vector is empty.");
         }
+        dates.assign(ts.begin() + static_cast<std::ptrdiff_t>(_fixings.getNbFixed()), ts.end());
+    }
+    else if (_option->isScriptedOption()) {
+        dates = static_cast<const ScriptedOption*>(_option)->getSimulationDates();
+    }
+    else if (_option->isBarrierOption() && !static_cast<const BarrierOption*>(_option)->isContinuouslyMonitored()) {
+        dates = static_cast<const BarrierOption*>(_option)->getMonitoringDates();
+    }
+    else if (_option->isLookbackOption() && !static_cast<const LookbackOption*>(_option)->isContinuouslyMonitored()) {
+        dates = static_cast<const LookbackOption*>(_option)->getMonitoringDates();
+    }
+    else {
+        // Cas européen, et surveillance continue (pont brownien entre les dates du schéma). Le pont n'est exact
+        // qu'à dérive et volatilité constantes : les piliers des courbes deviennent alors des dates simulées.
+        if (_option->isBarrierOption() || _option->isLookbackOption()) {
+            for (const TermStructure* curve : { _rateCurve.get(), _volatilityCurve.get() }) {
+                if (!curve) continue;
+                for (const double t : curve->getTimes()) {
+                    if (t > _valuationTime && t < T) dates.push_back(t);
+                }
+            }
+            std::sort(dates.begin(), dates.end());
+            dates.erase(std::unique(dates.begin(), dates.end()), dates.end());
+        }
+        dates.push_back(T);
     }
 
-    // Boucle principale de Monte Carlo
-    for (int p = 0; p < nb_paths; ++p) {
-        double payoff = 0.0;
+    // Les dates doivent suivre la date de valorisation et être strictement croissantes (cas asiatique)
+    double t_prev = _valuationTime;
+    for (const double t : dates) {
+        if (t < t_prev || (t == t_prev && _option->isAsianOption())) {
+            throw std::invalid_argument("Asian timeSteps must be non-decreasing.");
+        }
+        t_prev = t;
+    }
+    return dates;
+}
 
-        //Cas europen : une seule simulation  maturit
-        if (!isAsian) {
-            
-            const double Z = MT::rand_norm();
-            const double ST = _S0 * std::exp(driftT + diffT * Z);
-            payoff = _option->payoff(ST);
+// Pré-calcule les dérives, diffusions et lignes de surface de chaque pas : à la charge de generate() ne reste que le tirage.
+void BlackScholesMCPricer::buildSchedule() {
+    const double T = _option->getExpiry();
+    const std::vector<double> dates = simulationDates();
+
+    Schedule schedule;
+    schedule.lastStep.reserve(dates.size());
+
+    double t_prev = _valuationTime;
+    for (const double t : dates) {
+        const double dt = t - t_prev;
+
+        if (_localVol) {
+            // Sous-pas réguliers entre deux dates simulées
+            const int nbSub = std::max(1, static_cast<int>(std::ceil(dt * _localVolStepsPerYear)));
+            const double step = dt / nbSub;
+            for (int j = 0; j < nbSub; ++j) {
+                const double t0 = t_prev + j * step;
+                schedule.drift.push_back(rateIntegral(t0, t0 + step));
+                schedule.h.push_back(step);
+                schedule.diffusion.push_back(std::sqrt(step));
+                schedule.slices.emplace_back();
+                _localVol->timeSlice(t0, schedule.slices.back());
+            }
+        }
+        else if (_volatilityCurve) {
+            // Intégration exacte des courbes constantes par morceaux sur l'intervalle
+            const double variance = _volatilityCurve->integralSquared(t_prev, t);
+            schedule.drift.push_back(rateIntegral(t_prev, t) - 0.5 * variance);
+            schedule.diffusion.push_back(std::sqrt(variance));
         }
-        //Cas asiatique : simulation d'un chemin discret
         else {
-            std::vector<double> path;
-            path.reserve(ts->size());
+            schedule.drift.push_back((_r - 0.5 * _sigma * _sigma) * dt);
+            schedule.diffusion.push_back(_sigma * std::sqrt(dt));
+        }
 
-            double S = _S0;
-            double t_prev = 0.0;
+        schedule.lastStep.push_back(schedule.drift.size() - 1);
+        t_prev = t;
+    }
 
-            // Simulation incrmentale du processus de Black-Scholes
-            for (double t : *ts) {
-                const double dt = t - t_prev;
-                if (dt <= 0.0) {
-                    throw std::invalid_argument("Asian timeSteps must be non-decreasing.");
-                }
+    // Facteur d'actualisation (de la maturité à la date de valorisation)
+    schedule.discount = std::exp(-rateIntegral(_valuationTime, T));
+    chooseSampling(schedule);
+    schedule.ready = true;
+    _schedule = std::move(schedule);
+}
 
-                const double drift_dt = (_r - 0.5 * _sigma * _sigma) * dt;
-                const double diff_dt = _sigma * std::sqrt(dt);
+void BlackScholesMCPricer::chooseSampling(Schedule& schedule) const {
+    schedule.sampling = Plain;
+    schedule.shift = 0.0;
+    schedule.strata = 1;
 
-                const double Z = MT::rand_norm();
-                S *= std::exp(drift_dt + diff_dt * Z);
+    // Un seul tirage normal détermine S(T)
+    const bool terminal = !_localVol && !_option->isAsianOption() && !_option->isBarrierOption()
+        && !_option->isLookbackOption() && schedule.drift.size() == 1 && schedule.diffusion[0] > 0.0;
+    if (!terminal) {
+        if (_samplingMode != Plain && _samplingMode != Automatic) {
+            throw std::invalid_argument("Importance sampling and stratification require a European payoff simulated in a single step.");
+        }
+        return;
+    }
+    if (_samplingMode == Plain) return;
+
+    // Quadrature de |f| phi, de z |f| phi et de la probabilité du support
+    const double h = 1.0 / 64.0;
+    double mass = 0.0, moment = 0.0, support = 0.0;
+    for (double z = -8.5; z <= 8.5; z += h) {
+        const double weight = norm_pdf(z) * h;
+        const double f = std::abs(_option->payoff(_S0 * std::exp(schedule.drift[0] + schedule.diffusion[0] * z)));
+        mass += f * weight;
+        moment += z * f * weight;
+        if (f > 0.0) support += weight;
+    }
+
+    samplingMode mode = _samplingMode;
+    if (mode == Automatic) {
+        mode = mass > 0.0 && support < TAIL_PROBABILITY ? ImportanceStratified : Plain;
+    }
+    schedule.sampling = mode;
+    if ((mode == ImportanceSampling || mode == ImportanceStratified) && mass > 0.0) {
+        schedule.shift = moment / mass;
+    }
+    if (mode == Stratified || mode == ImportanceStratified) {
+        schedule.strata = _nbStrata;
+    }
+}
+
+/*Aléa terminal Z = mu + Y, Y tiré dans N(0,1) ou, en mode stratifié, Y = N^-1((j + U) / M) pour la strate j
+  d'un lot. Sous la loi de Z, f(Z) exp(-mu Y - mu^2 / 2) est un estimateur sans biais du prix ; f^2 w a pour
+  espérance le moment d'ordre 2 de f sous la loi d'origine (variance du Monte Carlo simple). Real : précision
+  du sous-jacent et du payoff ; le rapport de vraisemblance et l'accumulation restent en double. Les lots sont
+  traités par blocs d'au moins TERMINAL_BLOCK tirages (tirages, sous-jacents, payoffs, puis accumulation par lot),
+  dans le même ordre de tirage qu'un traitement lot par lot.*/
+template<typename Real>
+void BlackScholesMCPricer::generateTerminal(int nb_paths) {
+    const Schedule& schedule = _schedule;
+    const int M = schedule.strata;
+    const bool stratified = schedule.sampling == Stratified || schedule.sampling == ImportanceStratified;
+    const double mu = schedule.shift;
+    const Real S0 = static_cast<Real>(_S0);
+    const Real drift = static_cast<Real>(schedule.drift[0]);
+    const Real diffusion = static_cast<Real>(schedule.diffusion[0]);
+    const Real shift = static_cast<Real>(mu);
+    const long long nbBatches = (static_cast<long long>(nb_paths) + M - 1) / M;
+    const long long checkBatches = std::max(1, PricingControl::CHECK_PATHS / M);	// lots entre deux points de contrôle
+    const long long blockBatches = std::max(1, TERMINAL_BLOCK / M);					// lots par bloc
+
+    std::vector<double> Y(static_cast<std::size_t>(blockBatches * M));
+    std::vector<Real> payoffs(Y.size());
+
+    for (long long first = 0; first < nbBatches; first += blockBatches) {
+        const long long batches = std::min(blockBatches, nbBatches - first);
+        const std::size_t n = static_cast<std::size_t>(batches * M);
+
+        {
+            TELEMETRY_SCOPE(MCRng);
+            for (std::size_t i = 0; i < n; ++i) {
+                const int j = static_cast<int>(i % static_cast<std::size_t>(M));
+                Y[i] = stratified ? inverse_norm_cdf((j + MT::rand_unif()) / M) : MT::rand_norm();
+            }
+        }
+        {
+            TELEMETRY_SCOPE(MCPathBuild);
+            for (std::size_t i = 0; i < n; ++i) {
+                payoffs[i] = S0 * std::exp(drift + diffusion * (shift + static_cast<Real>(Y[i])));
+            }
+        }
+        {
+            TELEMETRY_SCOPE(MCPayoff);
+            for (std::size_t i = 0; i < n; ++i) {
+                payoffs[i] = static_cast<Real>(_option->payoff(payoffs[i]));
+            }
+        }
+
+        for (long long b = 0; b < batches; ++b) {
+            double sum = 0.0;
+            for (int j = 0; j < M; ++j) {
+                const std::size_t i = static_cast<std::size_t>(b * M + j);
+                const double discounted = schedule.discount * payoffs[i];
+                const double likelihood = mu != 0.0 ? std::exp(-mu * Y[i] - 0.5 * mu * mu) : 1.0;
+                sum += discounted * likelihood;
+                _plainMoment += discounted * discounted * likelihood;
+            }
+
+            // Un tirage de l'estimateur par lot (moyenne des strates)
+            const double sample = sum / M;
+            ++_nbPaths;
+            const double delta = sample - _estimate;
+            _estimate += delta / static_cast<double>(_nbPaths);
+            _M2 += delta * (sample - _estimate);
+            _momentPaths += M;
+
+            if (_control && (first + b + 1) % checkBatches == 0) {
+                reportPaths((first + b + 1) * M, nbBatches * M);
+            }
+        }
+    }
+    reportPaths(nbBatches * M, nbBatches * M);
+
+    TELEMETRY_COUNT(PathsGenerated, nbBatches * M);
+    TELEMETRY_COUNT(RngDraws, nbBatches * M);
+}
+
+/*Boucle de Monte Carlo du mode Plain. Real est la précision des trajectoires (tirage, exponentielle, sous-jacent)
+  et du payoff ; l'actualisation et la mise à jour de Welford restent en double. Real = double reproduit
+  exactement les opérations d'origine. La volatilité locale est toujours simulée en double.
+  Tirages et construction du chemin sont entrelacés (la surveillance d'une barrière tire ses propres aléas) :
+  la boucle n'a que des compteurs, son temps est compté dans MCGenerate sans détail par phase.*/
+template<typename Real>
+void BlackScholesMCPricer::simulate(int nb_paths) {
+    const Schedule& schedule = _schedule;
+    const std::size_t nbSteps = schedule.drift.size();
+    const std::size_t nbDates = schedule.lastStep.size();
+
+    // Identification du type d'option
+    const bool isAsian = _option->isAsianOption();
+    const AsianOption* asian = isAsian ? static_cast<const AsianOption*>(_option) : nullptr;
+    const bool scripted = _option->isScriptedOption();
+
+    // Options à barrière et lookback : suivi de la trajectoire (inactif sinon)
+    PathMonitor monitor(_option);
+    const bool monitored = monitor.active();
+    const bool monitorSteps = monitored && monitor.continuous();
+
+    // Le tampon n'est réalloué que s'il est trop petit (premier appel)
+    std::vector<double>& path = _path;
+    if (path.capacity() < nbDates) {
+        TELEMETRY_COUNT(Allocations, 1);
+        path.reserve(nbDates);
+    }
+
+    // Boucle principale de Monte Carlo
+    for (int p = 0; p < nb_paths; ++p) {
+        path.clear();
+
+        // Simulation incrémentale du processus, à partir du spot à la date de valorisation
+        Real S = static_cast<Real>(_S0);
+        if (monitored) {
+            monitor.start(_S0);
+        }
+        if (!_localVol) {
+            for (std::size_t k = 0; k < nbSteps; ++k) {
+                const Real Z = static_cast<Real>(MT::rand_norm());
+                const Real S_prev = S;
+                S *= std::exp(static_cast<Real>(schedule.drift[k]) + static_cast<Real>(schedule.diffusion[k]) * Z);
+                if (monitored) {
+                    monitor.observe(S_prev, S, schedule.diffusion[k] * schedule.diffusion[k]);
+                }
 
                 path.push_back(S); // Stocke S(t_k)
-                t_prev = t;
             }
+        }
+        else {
+            double x = std::log(_S0);
+            double S_prev = _S0;    // dernier point surveillé
+            std::size_t k = 0;
+            for (std::size_t j = 0; j < nbSteps; ++j) {
+                const double Z = MT::rand_norm();
+                const double sigma = _localVol->sliceValue(schedule.slices[j], x);
+                x += schedule.drift[j] - 0.5 * sigma * sigma * schedule.h[j] + sigma * schedule.diffusion[j] * Z;
 
-            // Calcul du payoff  partir du chemin simul
-            payoff = asian->payoffPath(path);
+                // Surveillance continue : pont brownien sur chaque sous-pas, de variance locale sigma^2 h
+                if (monitorSteps) {
+                    S = static_cast<Real>(std::exp(x));
+                    monitor.observe(S_prev, S, sigma * sigma * schedule.h[j]);
+                    S_prev = S;
+                }
+
+                if (j == schedule.lastStep[k]) {
+                    S = static_cast<Real>(std::exp(x));
+                    if (monitored && !monitorSteps) {
+                        monitor.observe(S_prev, S, 0.0);
+                        S_prev = S;
+                    }
+                    path.push_back(S); // Stocke S(t_k)
+                    ++k;
+                }
+            }
         }
 
+        // Calcul du payoff à partir du chemin simulé
+        const Real payoff = static_cast<Real>(isAsian ? asian->payoffPartial(_fixings.getSum(), _fixings.getNbFixed(), path)
+                   : monitored ? monitor.payoff(S)
+                   : scripted ? _option->payoffPath(path)
+                             : _option->payoff(S));
+
         // Actualisation du payoff
-        const double discounted = disc * payoff;
+        const double discounted = schedule.discount * payoff;
 
-        // Mise  jour incrmentale (algorithme de Welford)
+        // Mise à jour incrémentale (algorithme de Welford)
+        _plainMoment += discounted * discounted;
         ++_nbPaths;
         const double delta = discounted - _estimate;
         _estimate += delta / static_cast<double>(_nbPaths);
         _M2 += delta * (discounted - _estimate);
+        ++_momentPaths;
+
+        if (_control && (p + 1) % PricingControl::CHECK_PATHS == 0) {
+            reportPaths(p + 1, nb_paths);
+        }
     }
+    reportPaths(nb_paths, nb_paths);
+
+    TELEMETRY_COUNT(PathsGenerated, nb_paths);
+    TELEMETRY_COUNT(RngDraws, static_cast<long long>(nb_paths) * static_cast<long long>(nbSteps) * (monitor.drawsExtremes() ? 2 : 1));
+}
+
+// Avancement de l'appel et largeur de l'intervalle à 95 % de l'estimation courante (NaN avant deux tirages)
+void BlackScholesMCPricer::reportPaths(long long done, long long total) const {
+    if (!_control) return;
+    PricingProgress progress;
+    progress.done = done;
+    progress.total = total;
+    if (_nbPaths >= 2) {
+        progress.confidenceWidth = 2.0 * 1.96 * std::sqrt(_M2 / static_cast<double>(_nbPaths - 1) / static_cast<double>(_nbPaths));
+    }
+    _control->report(progress);
+}
+
+// Génère nb_paths trajectoires supplémentaires sous Black-Scholes et met à jour l'estimation du prix par moyenne incrémentale.
+void BlackScholesMCPricer::generate(int nb_paths) {
+    if (nb_paths <= 0) {
+        throw std::invalid_argument("Number of paths must be positive.");
+    }
+
+    TELEMETRY_SCOPE(MCGenerate);
+
+    if (!_schedule.ready) {
+        buildSchedule();
+    }
+    const bool single = _precision == SinglePrecision && !_localVol;
+    if (_schedule.sampling != Plain) {
+        if (single) generateTerminal<float>(nb_paths);
+        else generateTerminal<double>(nb_paths);
+        return;
+    }
+    if (_option->isScriptedOption() && !_localVol) {
+        generateScripted(nb_paths);
+        return;
+    }
+    if (single && !_option->isBarrierOption() && !_option->isLookbackOption()) simulateLanes(nb_paths);
+    else if (single) simulate<float>(nb_paths);
+    else simulate<double>(nb_paths);
+}
+
+/*Les normales sont tirées dans l'ordre des chemins (celui de simulate<double>, pour que comparePrecision() compare
+  les mêmes trajectoires) et rangées par pas, colonne de FLOAT_LANES valeurs ; chaque colonne est ensuite
+  remplacée par le sous-jacent à cette date. Le log-spot relatif X = ln(S / S0) est cumulé en float : les boucles
+  par pas portent sur des tableaux float contigus, sans dépendance entre chemins (vectorisables, deux fois plus de
+  chemins par registre qu'en double).*/
+void BlackScholesMCPricer::simulateLanes(int nb_paths) {
+    const Schedule& schedule = _schedule;
+    const std::size_t nbSteps = schedule.drift.size();
+    const std::size_t L = FLOAT_LANES;
+
+    const bool isAsian = _option->isAsianOption();
+    const AsianOption* asian = isAsian ? static_cast<const AsianOption*>(_option) : nullptr;
+
+    if (_floatPaths.size() < nbSteps * L) {
+        TELEMETRY_COUNT(Allocations, 1);
+        _floatPaths.resize(nbSteps * L);
+    }
+    std::vector<double>& path = _path;
+    if (isAsian) {
+        if (path.capacity() < nbSteps) {
+            TELEMETRY_COUNT(Allocations, 1);
+        }
+        path.resize(nbSteps);
+    }
+
+    std::vector<float> drift(nbSteps), diffusion(nbSteps);
+    for (std::size_t k = 0; k < nbSteps; ++k) {
+        drift[k] = static_cast<float>(schedule.drift[k]);
+        diffusion[k] = static_cast<float>(schedule.diffusion[k]);
+    }
+    const float S0 = static_cast<float>(_S0);
+    float X[FLOAT_LANES], payoffs[FLOAT_LANES];
+
+    for (int first = 0; first < nb_paths; first += FLOAT_LANES) {
+        const std::size_t lanes = static_cast<std::size_t>(std::min(FLOAT_LANES, nb_paths - first));
+
+        {
+            TELEMETRY_SCOPE(MCRng);
+            for (std::size_t l = 0; l < lanes; ++l) {
+                for (std::size_t k = 0; k < nbSteps; ++k) {
+                    _floatPaths[k * L + l] = static_cast<float>(MT::rand_norm());
+                }
+            }
+        }
+
+        {
+            TELEMETRY_SCOPE(MCPathBuild);
+            std::fill(X, X + lanes, 0.0f);
+            for (std::size_t k = 0; k < nbSteps; ++k) {
+                float* column = _floatPaths.data() + k * L;
+                const float a = drift[k], b = diffusion[k];
+                for (std::size_t l = 0; l < lanes; ++l) {
+                    X[l] += a + b * column[l];
+                }
+                // Un payoff européen n'observe que la maturité
+                if (isAsian || k + 1 == nbSteps) {
+                    for (std::size_t l = 0; l < lanes; ++l) {
+                        column[l] = S0 * std::exp(X[l]);
+                    }
+                }
+            }
+        }
+
+        const float* terminal = nbSteps > 0 ? _floatPaths.data() + (nbSteps - 1) * L : nullptr;
+        {
+            TELEMETRY_SCOPE(MCPayoff);
+            for (std::size_t l = 0; l < lanes; ++l) {
+                if (isAsian) {
+                    for (std::size_t k = 0; k < nbSteps; ++k) {
+                        path[k] = _floatPaths[k * L + l];
+                    }
+                    payoffs[l] = static_cast<float>(asian->payoffPartial(_fixings.getSum(), _fixings.getNbFixed(), path));
+                }
+                else {
+                    payoffs[l] = static_cast<float>(_option->payoff(terminal ? terminal[l] : S0));
+                }
+            }
+        }
+
+        for (std::size_t l = 0; l < lanes; ++l) {
+            const double discounted = schedule.discount * payoffs[l];
+            _plainMoment += discounted * discounted;
+            ++_nbPaths;
+            const double delta = discounted - _estimate;
+            _estimate += delta / static_cast<double>(_nbPaths);
+            _M2 += delta * (discounted - _estimate);
+            ++_momentPaths;
+        }
+
+        if (_control && (first / FLOAT_LANES + 1) % (PricingControl::CHECK_PATHS / FLOAT_LANES) == 0) {
+            reportPaths(first + static_cast<long long>(lanes), nb_paths);
+        }
+    }
+    reportPaths(nb_paths, nb_paths);
+
+    TELEMETRY_COUNT(PathsGenerated, nb_paths);
+    TELEMETRY_COUNT(RngDraws, static_cast<long long>(nb_paths) * static_cast<long long>(nbSteps));
+}
+
+/*Les observations d'un lot sont rangées par date (colonne de SCRIPT_LANES valeurs par date) : c'est la
+  disposition attendue par PayoffScript::evaluate(), qui traite chaque instruction sur tout le lot.*/
+void BlackScholesMCPricer::generateScripted(int nb_paths) {
+    const Schedule& schedule = _schedule;
+    const PayoffScript& script = static_cast<const ScriptedOption*>(_option)->getScript();
+    const std::size_t nbSteps = schedule.drift.size();
+    const std::size_t L = SCRIPT_LANES;
+
+    if (_scriptPaths.size() < nbSteps * L) {
+        TELEMETRY_COUNT(Allocations, 1);
+        _scriptPaths.resize(nbSteps * L);
+    }
+    double S[SCRIPT_LANES], payoffs[SCRIPT_LANES];
+
+    for (int first = 0; first < nb_paths; first += SCRIPT_LANES) {
+        const std::size_t lanes = static_cast<std::size_t>(std::min(SCRIPT_LANES, nb_paths - first));
+
+        {
+            TELEMETRY_SCOPE(MCRng);
+            for (std::size_t k = 0; k < nbSteps; ++k) {
+                double* column = _scriptPaths.data() + k * L;
+                for (std::size_t l = 0; l < lanes; ++l) column[l] = MT::rand_norm();
+            }
+        }
+        {
+            TELEMETRY_SCOPE(MCPathBuild);
+            std::fill(S, S + lanes, _S0);
+            for (std::size_t k = 0; k < nbSteps; ++k) {
+                double* column = _scriptPaths.data() + k * L;
+                const double drift = schedule.drift[k], diffusion = schedule.diffusion[k];
+                for (std::size_t l = 0; l < lanes; ++l) {
+                    S[l] *= std::exp(drift + diffusion * column[l]);
+                    column[l] = S[l];
+                }
+            }
+        }
+
+        {
+            TELEMETRY_SCOPE(MCPayoff);
+            script.evaluate(_scriptPaths.data(), L, lanes, payoffs, _scriptWorkspace);
+        }
+
+        for (std::size_t l = 0; l < lanes; ++l) {
+            const double discounted = schedule.discount * payoffs[l];
+            _plainMoment += discounted * discounted;
+            ++_nbPaths;
+            const double delta = discounted - _estimate;
+            _estimate += delta / static_cast<double>(_nbPaths);
+            _M2 += delta * (discounted - _estimate);
+            ++_momentPaths;
+        }
+
+        if (_control && (first / SCRIPT_LANES + 1) % (PricingControl::CHECK_PATHS / SCRIPT_LANES) == 0) {
+            reportPaths(first + static_cast<long long>(lanes), nb_paths);
+        }
+    }
+    reportPaths(nb_paths, nb_paths);
+
+    TELEMETRY_COUNT(PathsGenerated, nb_paths);
+    TELEMETRY_COUNT(RngDraws, static_cast<long long>(nb_paths) * static_cast<long long>(nbSteps));
+}
+
+namespace {
+    /*Intégrale de 0 à t1 moins intégrale de 0 à t0 d'une courbe constante par morceaux dont les valeurs sont
+      actives (entrées AAD) : somme des valeurs (ou de leurs carrés) pondérées par le recouvrement de chaque morceau.*/
+    adouble curveIntegral(const std::vector<double>& times, const std::vector<adouble>& values, double t0, double t1, bool squared) {
+        adouble total(0.0);
+        double start = 0.0;
+        for (std::size_t j = 0; j < times.size(); ++j) {
+            const double end = j + 1 == times.size() ? std::max(t1, times[j]) : times[j];
+            const double overlap = std::min(t1, end) - std::max(t0, start);
+            if (overlap > 0.0) {
+                total += (squared ? values[j] * values[j] : values[j]) * overlap;
+            }
+            start = end;
+        }
+        return total;
+    }
+}
+
+/*Dérivées trajectorielles : les dérives, diffusions et l'actualisation (fonctions des entrées) sont enregistrées
+  une fois en tête de bande, puis marquées. Chaque trajectoire est enregistrée après la marque, propagée jusqu'à
+  la marque (les adjoints s'accumulent sur les noeuds de tête) et effacée : la bande reste de la taille d'un
+  chemin. Une dernière propagation de la tête donne la somme des dérivées par rapport aux entrées.*/
+Greeks BlackScholesMCPricer::greeks(int nb_paths) {
+    if (nb_paths <= 0) {
+        throw std::invalid_argument("Number of paths must be positive.");
+    }
+    if (_localVol) {
+        throw std::invalid_argument("AAD sensitivities are not available with local volatility.");
+    }
+    if (_option->isBarrierOption() || _option->isLookbackOption() || _option->isScriptedOption()) {
+        throw std::invalid_argument("AAD sensitivities are not available for barrier, lookback and scripted options.");
+    }
+
+    TELEMETRY_SCOPE(MCGenerate);
+
+    AADTape& tape = AADTape::threadLocal();
+    tape.clear();
+    AADTape::Scope scope(tape);
+
+    const double T = _option->getExpiry();
+    const std::vector<double> dates = simulationDates();
+    const bool isAsian = _option->isAsianOption();
+    const AsianOption* asian = isAsian ? static_cast<const AsianOption*>(_option) : nullptr;
+
+    // Entrées : spot, taux et volatilité (ou valeurs des piliers des courbes)
+    const adouble S0 = adouble::input(_S0);
+    std::vector<adouble> rates, vols;
+    if (_rateCurve) {
+        for (const double v : _rateCurve->getValues()) rates.push_back(adouble::input(v));
+        for (const double v : _volatilityCurve->getValues()) vols.push_back(adouble::input(v));
+    }
+    else {
+        rates.push_back(adouble::input(_r));
+        vols.push_back(adouble::input(_sigma));
+    }
+    auto rateIntegral = [&](double t0, double t1) {
+        return _rateCurve ? curveIntegral(_rateCurve->getTimes(), rates, t0, t1, false) : rates[0] * (t1 - t0);
+    };
+    auto varianceIntegral = [&](double t0, double t1) {
+        return _volatilityCurve ? curveIntegral(_volatilityCurve->getTimes(), vols, t0, t1, true) : vols[0] * vols[0] * (t1 - t0);
+    };
+
+    // Schéma en tête de bande
+    std::vector<adouble> drift, diffusion;
+    double t_prev = _valuationTime;
+    for (const double t : dates) {
+        const adouble variance = varianceIntegral(t_prev, t);
+        drift.push_back(rateIntegral(t_prev, t) - 0.5 * variance);
+        diffusion.push_back(variance.value() > 0.0 ? sqrt(variance) : adouble(0.0));
+        t_prev = t;
+    }
+    const adouble disc = exp(-rateIntegral(_valuationTime, T));
+    tape.mark();
+
+    const Option* option = _option;
+    auto payoff = [option](double x) { return option->payoff(x); };
+    const double nbDates = isAsian ? static_cast<double>(asian->getTimeSteps().size()) : 1.0;
+
+    double sum = 0.0;
+    for (int p = 0; p < nb_paths; ++p) {
+        adouble S = S0;
+        adouble pathSum(isAsian ? _fixings.getSum() : 0.0);
+        for (std::size_t k = 0; k < dates.size(); ++k) {
+            const double Z = MT::rand_norm();
+            S = S * exp(drift[k] + diffusion[k] * Z);
+            if (isAsian) pathSum += S;
+        }
+
+        // Payoff sur S(T) ou sur la moyenne (fixings observés compris)
+        const adouble discounted = disc * adouble::blackBox(payoff, isAsian ? pathSum / nbDates : S);
+        sum += discounted.value();
+        if (!discounted.isConstant()) {
+            tape.propagateToMark(discounted.index());
+        }
+        tape.rewind();
+    }
+    tape.propagateMarked();
+
+    // Moyennes des dérivées trajectorielles
+    const double inv = 1.0 / static_cast<double>(nb_paths);
+    Greeks result;
+    result.price = sum * inv;
+    result.delta = S0.adjoint() * inv;
+    for (const adouble& r : rates) {
+        result.rho += r.adjoint() * inv;
+        if (_rateCurve) result.rateBuckets.push_back(r.adjoint() * inv);
+    }
+    for (const adouble& sigma : vols) {
+        result.vega += sigma.adjoint() * inv;
+        if (_volatilityCurve) result.volatilityBuckets.push_back(sigma.adjoint() * inv);
+    }
+
+    TELEMETRY_COUNT(PathsGenerated, nb_paths);
+    TELEMETRY_COUNT(RngDraws, static_cast<long long>(nb_paths) * static_cast<long long>(dates.size()));
+    return result;
 }
 
-// Retourne l'estimation courante du prix.Une exception est leve si aucun chemin n'a t gnr.
+// Retourne l'estimation courante du prix.Une exception est levée si aucun chemin n'a été généré.
 double BlackScholesMCPricer::operator()() const {
     if (_nbPaths == 0) {
         throw std::runtime_error("No paths generated. Call generate() before pricing.");
@@ -128,7 +952,7 @@ double BlackScholesMCPricer::operator()() const {
     return _estimate;
 }
 
-// Calcule l'intervalle de confiance  95 % autour de l'estimation.
+// Calcule l'intervalle de confiance à 95 % autour de l'estimation.
 std::vector<double> BlackScholesMCPricer::confidenceInterval() const {
     if (_nbPaths < 2) {
         throw std::runtime_error("At least two paths are required to compute confidence interval.");
@@ -137,4 +961,192 @@ std::vector<double> BlackScholesMCPricer::confidenceInterval() const {
     const double stddev = std::sqrt(variance);
     const double margin = 1.96 * stddev / std::sqrt(static_cast<double>(_nbPaths));
     return { _estimate - margin, _estimate + margin };
-}
\ No newline at end of file
+}
+
+MCEstimatorState BlackScholesMCPricer::getState() const {
+    MCEstimatorState state;
+    state.nbPaths = _nbPaths;
+    state.estimate = _estimate;
+    state.M2 = _M2;
+    state.strata = _schedule.ready ? _schedule.strata : 1;
+    state.rngState = MT::getState();
+    return state;
+}
+
+void BlackScholesMCPricer::setState(const MCEstimatorState& state, bool restore_rng) {
+    if (state.nbPaths < 0 || state.M2 < 0.0) {
+        throw std::invalid_argument("Invalid estimator state.");
+    }
+    if (restore_rng && state.rngState.empty()) {
+        throw std::invalid_argument("Estimator state has no generator position.");
+    }
+
+    // Le schéma fixe le nombre de trajectoires par tirage (getNbPaths())
+    if (!_schedule.ready) {
+        buildSchedule();
+    }
+    if (state.nbPaths > 0 && state.strata != _schedule.strata) {
+        throw std::invalid_argument("Estimator state was produced with a different number of strata.");
+    }
+    if (restore_rng) {
+        MT::setState(state.rngState);
+    }
+    _nbPaths = state.nbPaths;
+    _estimate = state.estimate;
+    _M2 = state.M2;
+    _plainMoment = 0.0;
+    _momentPaths = 0;
+}
+
+// Seul l'estimateur est combiné : la position du générateur n'est ni lue ni modifiée.
+void BlackScholesMCPricer::merge(const MCEstimatorState& other) {
+    if (other.nbPaths == 0) return;
+    if (!_schedule.ready) {
+        buildSchedule();
+    }
+    if (other.strata != _schedule.strata) {
+        throw std::invalid_argument("Cannot merge estimator states with different strata.");
+    }
+    MCEstimatorState state;
+    state.nbPaths = _nbPaths;
+    state.estimate = _estimate;
+    state.M2 = _M2;
+    state.strata = _schedule.strata;
+    state.merge(other);
+    _nbPaths = state.nbPaths;
+    _estimate = state.estimate;
+    _M2 = state.M2;
+}
+
+/*Format texte : en-tête versionné, paramètres du problème, identité de l'option (empreinte du type et du script,
+  valeurs de sa PricingKey), échantillonnage et précision, estimateur (réels en hexadécimal, donc exacts) puis
+  position du générateur. Le fichier est écrit à côté puis renommé pour ne jamais laisser de point de reprise
+  partiel en cas d'interruption.*/
+void BlackScholesMCPricer::saveCheckpoint(const std::string& path) const {
+    if (_rateCurve || _localVol) {
+        throw std::runtime_error("Checkpoints are only supported for constant rate and volatility.");
+    }
+    const PricingKey key(*_option, "MonteCarlo", { _S0, _r, _sigma }, {});
+    const std::vector<double>& values = key.getValues();
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot open file for writing: " + tmp);
+        }
+        out << CHECKPOINT_MAGIC << ' ' << CHECKPOINT_VERSION << '\n'
+            << "problem " << hex(_S0) << ' ' << hex(_r) << ' ' << hex(_sigma) << ' '
+            << hex(_option->getExpiry()) << ' ' << hex(_valuationTime) << ' '
+            << _fixings.getNbFixed() << ' ' << hex(_fixings.getSum()) << '\n'
+            << "option " << std::hex << fingerprint(key.getOptionType() + '\n' + key.getSource()) << std::dec << ' '
+            << values.size();
+        for (const double v : values) {
+            out << ' ' << hex(v);
+        }
+        out << '\n'
+            << "sampling " << static_cast<int>(_samplingMode) << ' ' << _nbStrata << '\n'
+            << "precision " << static_cast<int>(_precision) << '\n'
+            << "estimator " << _nbPaths << ' ' << (_schedule.ready ? _schedule.strata : 1) << ' '
+            << hex(_estimate) << ' ' << hex(_M2) << '\n'
+            << "rng " << MT::getState() << '\n';
+        if (!out) {
+            throw std::runtime_error("Error while writing file: " + tmp);
+        }
+    }
+    // Remplacement atomique : l'ancien point de reprise reste en place tant que le nouveau n'est pas renommé
+#ifdef _WIN32
+    const bool moved = MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    const bool moved = std::rename(tmp.c_str(), path.c_str()) == 0;
+#endif
+    if (!moved) {
+        throw std::runtime_error("Cannot move checkpoint to " + path);
+    }
+}
+
+void BlackScholesMCPricer::loadCheckpoint(const std::string& path) {
+    if (_rateCurve || _localVol) {
+        throw std::runtime_error("Checkpoints are only supported for constant rate and volatility.");
+    }
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    std::string magic, tag;
+    int version = 0;
+    in >> magic >> version;
+    if (magic != CHECKPOINT_MAGIC || version < 1 || version > CHECKPOINT_VERSION) {
+        throw std::runtime_error("Not a supported Monte Carlo checkpoint: " + path);
+    }
+
+    // Paramètres du problème : doivent être identiques à ceux du pricer
+    std::string S0, r, sigma, expiry, valuationTime, fixedSum;
+    std::size_t nbFixed = 0;
+    in >> tag >> S0 >> r >> sigma >> expiry >> valuationTime >> nbFixed >> fixedSum;
+    if (!in || tag != "problem") {
+        throw std::runtime_error("Corrupted checkpoint (problem): " + path);
+    }
+    if (parseHex(S0) != _S0 || parseHex(r) != _r || parseHex(sigma) != _sigma
+        || parseHex(expiry) != _option->getExpiry() || parseHex(valuationTime) != _valuationTime
+        || nbFixed != _fixings.getNbFixed() || parseHex(fixedSum) != _fixings.getSum()) {
+        throw std::invalid_argument("Checkpoint was produced for a different pricing problem: " + path);
+    }
+
+    // Identité de l'option : type, strike, dates, barrière, script...
+    const PricingKey key(*_option, "MonteCarlo", { _S0, _r, _sigma }, {});
+    std::uint64_t optionFingerprint = 0;
+    std::size_t nbValues = 0;
+    in >> tag >> std::hex >> optionFingerprint >> std::dec >> nbValues;
+    if (!in || tag != "option") {
+        throw std::runtime_error("Corrupted checkpoint (option): " + path);
+    }
+    bool sameOption = optionFingerprint == fingerprint(key.getOptionType() + '\n' + key.getSource())
+        && nbValues == key.getValues().size();
+    for (std::size_t k = 0; k < nbValues; ++k) {
+        std::string value;
+        in >> value;
+        if (!in) {
+            throw std::runtime_error("Corrupted checkpoint (option): " + path);
+        }
+        sameOption = sameOption && parseHex(value) == key.getValues()[k];
+    }
+    if (!sameOption) {
+        throw std::invalid_argument("Checkpoint was produced for a different option: " + path);
+    }
+
+    int mode = 0, nbStrata = 0;
+    in >> tag >> mode >> nbStrata;
+    if (!in || tag != "sampling") {
+        throw std::runtime_error("Corrupted checkpoint (sampling): " + path);
+    }
+    if (mode != static_cast<int>(_samplingMode) || nbStrata != _nbStrata) {
+        throw std::invalid_argument("Checkpoint was produced with a different sampling mode: " + path);
+    }
+
+    int precision = 0;
+    in >> tag >> precision;
+    if (!in || tag != "precision") {
+        throw std::runtime_error("Corrupted checkpoint (precision): " + path);
+    }
+    if (precision != static_cast<int>(_precision)) {
+        throw std::invalid_argument("Checkpoint was produced with a different precision: " + path);
+    }
+
+    MCEstimatorState state;
+    std::string estimate, M2;
+    in >> tag >> state.nbPaths >> state.strata >> estimate >> M2;
+    if (!in || tag != "estimator") {
+        throw std::runtime_error("Corrupted checkpoint (estimator): " + path);
+    }
+    state.estimate = parseHex(estimate);
+    state.M2 = parseHex(M2);
+
+    in >> tag;
+    std::getline(in, state.rngState);
+    if (!in || tag != "rng") {
+        throw std::runtime_error("Corrupted checkpoint (generator): " + path);
+    }
+
+    setState(state, true);
+}
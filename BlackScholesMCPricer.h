@@ -1,34 +1,212 @@
 #pragma once
 #include "Option.h"
+#include "AsianFixingState.h"
+#include "MCEstimatorState.h"
+#include "Greeks.h"
 #include "MT.h"
+#include "Precision.h"
+#include "PricingControl.h"
+#include "TermStructure.h"
+#include "LocalVolSurface.h"
+#include <memory>
+#include <string>
 #include <vector>
 
 /*Pricer Monte Carlo sous BlackScholes:
 	- Ne stocke aucun chemin : uniquement une estimation courante.
-	- Met  jour l'estimation de manire incrmentale  chaque appel  generate().*/
+	- Met à jour l'estimation de manière incrémentale à chaque appel à generate().*/
 class BlackScholesMCPricer {
+public:
+	/*Échantillonnage de l'aléa terminal (option européenne simulée en un seul pas) :
+		- Plain : tirages normaux indépendants ;
+		- ImportanceSampling : tirages décalés de mu vers le support du payoff, pondérés par le rapport de
+		  vraisemblance exp(-mu Z + mu^2 / 2) ;
+		- Stratified : le quantile normal terminal est stratifié en M strates équiprobables, un tirage par strate ;
+		- ImportanceStratified : les deux ;
+		- Automatic : ImportanceStratified si le payoff est nul hors d'une queue de probabilité inférieure à 10 %,
+		  Plain sinon (et pour toute option qui n'est pas simulée en un seul pas).*/
+	enum samplingMode { Plain, ImportanceSampling, Stratified, ImportanceStratified, Automatic };
+
 private:
-	Option* _option; // option  pricer 
+	Option* _option; // option à pricer 
 	double _S0;	// prix spot initial
 	double _r;	 // taux sans risque 
-	double _sigma;	// volatilit
+	double _sigma;	// volatilité
 
-	long long _nbPaths;	// nombre total de trajectoires gnres
-	double _estimate; //estimation courante du prix(moyenne des payoffs actualiss)
+	long long _nbPaths;	// nombre de tirages de l'estimateur (trajectoires, ou lots stratifiés de M trajectoires)
+	double _estimate; //estimation courante du prix(moyenne des payoffs actualisés)
 	double _M2;	// accumulateur pour variance (Welford), pour l'IC
 
+	std::vector<double> _path;	// tampon de trajectoire réutilisé d'un chemin à l'autre (options asiatiques)
+	std::vector<double> _scriptPaths;		// observations d'un lot de chemins, par date (ScriptedOption)
+	std::vector<float> _floatPaths;			// tirages puis sous-jacent d'un lot de chemins, par date (simple précision)
+	std::vector<double> _scriptWorkspace;	// registres de travail du bytecode (ScriptedOption)
+
+	AsianFixingState _fixings;	// fixings déjà observés (options asiatiques en cours de vie)
+	double _valuationTime;		// date de valorisation (date à laquelle le spot vaut _S0)
+
+	std::shared_ptr<const TermStructure> _rateCurve;		// taux dépendant du temps (remplace _r si non nul)
+	std::shared_ptr<const TermStructure> _volatilityCurve;	// volatilité dépendant du temps (remplace _sigma si non nul)
+	std::shared_ptr<const LocalVolSurface> _localVol;		// volatilité locale (remplace _sigma et la courbe si non nul)
+	int _localVolStepsPerYear;	// finesse du schéma d'Euler en volatilité locale
+
+	samplingMode _samplingMode;	// échantillonnage demandé
+	int _nbStrata;				// nombre de strates M (modes stratifiés)
+	double _plainMoment;		// somme des f^2 w : moment d'ordre 2 qu'aurait l'estimateur sans réduction de variance
+	long long _momentPaths;		// trajectoires comptées dans _plainMoment
+
+	computePrecision _precision;	// précision des trajectoires et des payoffs
+	PricingControl* _control;		// annulation et progression de generate() (nullptr : aucun contrôle)
+
+	/*Schéma de simulation commun à toutes les trajectoires, construit au premier appel à generate() puis
+	  réutilisé : chaque pas j fait évoluer x = ln S de drift[j] + diffusion[j] * Z ou, en volatilité locale,
+	  de drift[j] - 0.5 sigma^2 h[j] + sigma diffusion[j] Z avec sigma lue dans slices[j].*/
+	struct Schedule {
+		std::vector<double> drift, diffusion, h;
+		std::vector<std::vector<double>> slices;	// lignes de la surface aux dates des pas
+		std::vector<std::size_t> lastStep;	// indice du pas qui atteint chaque date simulée
+		double discount = 1.0;
+		samplingMode sampling = Plain;	// échantillonnage effectif (Automatic résolu)
+		double shift = 0.0;				// décalage mu de l'échantillonnage préférentiel
+		int strata = 1;					// trajectoires par tirage de l'estimateur
+		bool ready = false;
+	};
+	Schedule _schedule;
+
+	void buildSchedule();
+
+	/*Résout l'échantillonnage du schéma. Le décalage mu est la moyenne de la densité optimale |f(z)| phi(z)
+	  (f : payoff en fonction de l'aléa terminal z), calculée par quadrature sur [-8.5, 8.5].*/
+	void chooseSampling(Schedule& schedule) const;
+
+	// Boucle de generate() pour un payoff terminal avec échantillonnage préférentiel et/ou stratification
+	template<typename Real>
+	void generateTerminal(int nb_paths);
+
+	// Boucle de generate() en tirages simples, trajectoires en précision Real
+	template<typename Real>
+	void simulate(int nb_paths);
+
+	/*Boucle de generate() en simple précision pour les options européennes, digitales et asiatiques (taux et
+	  volatilité constants ou par morceaux) : FLOAT_LANES chemins avancés ensemble en log-spot sur des colonnes
+	  float contiguës, l'exponentielle n'étant prise qu'aux dates observées par le payoff.*/
+	void simulateLanes(int nb_paths);
+
+	/*Boucle de generate() pour une ScriptedOption (tirages simples, taux et volatilité constants ou par
+	  morceaux) : SCRIPT_LANES chemins avancés ensemble, payoffs évalués par le bytecode en un appel par lot.*/
+	void generateScripted(int nb_paths);
+
+	// Dates simulées : la maturité (cas européen), les dates d'observation non encore fixées ou les dates de surveillance
+	std::vector<double> simulationDates() const;
+
+	// Taux intégré entre t0 et t1 (constant ou courbe)
+	double rateIntegral(double t0, double t1) const;
+
+	// Abandonne l'estimation courante (le problème a changé)
+	void resetEstimator();
+
+	// Point de contrôle de generate() après done trajectoires sur total
+	void reportPaths(long long done, long long total) const;
+
 public:
+	static const int SCRIPT_LANES = 64;	// chemins par lot d'évaluation d'un script
+	static const int FLOAT_LANES = 64;	// chemins par lot en simple précision
+	static const int TERMINAL_BLOCK = 256;	// tirages minimum par bloc de generateTerminal()
+
 	BlackScholesMCPricer(Option* option, double initial_price, double interest_rate, double volatility);
 
-	// Accs en lecture au nombre de chemins gnrs
-	long long getNbPaths() const { return _nbPaths; }
+	/*Option asiatique partiellement fixée : initial_price est le spot à valuation_time et seules les dates
+	  d'observation restantes sont simulées. L'estimation courante est réinitialisée.*/
+	void setAsianFixings(const AsianFixingState& fixings, double valuation_time);
+
+	/*Taux et volatilité constants par morceaux, à la place de interest_rate et volatility. Les dérives et
+	  diffusions de chaque intervalle d'observation sont intégrées exactement une fois par appel à generate() :
+	  le coût par pas reste celui du cas constant. L'estimation courante est réinitialisée.*/
+	void setTermStructures(const TermStructure& rate, const TermStructure& volatility);
+
+	/*Volatilité locale sigma(S, t) : schéma d'Euler en ln S, avec au moins steps_per_year pas par an entre deux
+	  dates d'observation. Les lignes de la surface aux dates du schéma sont extraites une fois par appel à
+	  generate(). Le taux reste celui du constructeur ou de setTermStructures(). L'estimation est réinitialisée.*/
+	void setLocalVolatility(std::shared_ptr<const LocalVolSurface> surface, int steps_per_year = 252);
+
+	/*Choix de l'échantillonnage (Automatic par défaut) et du nombre de strates. Les modes autres que Plain et
+	  Automatic sont réservés aux options européennes simulées en un seul pas (ni volatilité locale, ni option
+	  asiatique, à barrière ou lookback) ; generate() lève sinon une exception. L'estimation est réinitialisée.*/
+	void setSampling(samplingMode mode, int nb_strata = 64);
+
+	// Échantillonnage effectif (Automatic résolu) une fois generate() appelé, le mode demandé avant
+	samplingMode getSampling() const;
+
+	/*Réduction de variance obtenue : variance d'une trajectoire en Monte Carlo simple, estimée sur les mêmes
+	  tirages (moyenne des f^2 w, moins le carré du prix), rapportée à la variance par trajectoire de l'estimateur.
+	  C'est le facteur de trajectoires économisé à précision égale (proche de 1 en mode Plain). Calculée sur les
+	  tirages de generate() depuis la dernière réinitialisation ou setState() (merge() n'en tient pas compte).*/
+	double getVarianceReduction() const;
+
+	/*Simple précision : trajectoires (exponentielle, sous-jacent) et payoffs en float, actualisation et
+	  accumulation de Welford en double. Les options européennes, digitales et asiatiques sont simulées par lots
+	  de FLOAT_LANES chemins (simulateLanes()), avec les mêmes tirages que le calcul en double ; les options à
+	  barrière et lookback gardent la boucle par chemin (seule l'arithmétique passe en float) et la volatilité
+	  locale reste en double. L'estimation est réinitialisée.*/
+	void setPrecision(computePrecision precision);
+	computePrecision getPrecision() const { return _precision; }
 
-	// Gnre nb_paths trajectoires supplmentaires et met  jour l'estimation.
+	/*Génère nb_paths trajectoires en double puis les mêmes tirages en simple précision, sur deux copies du pricer
+	  (l'estimation courante n'est pas modifiée ; le générateur avance de nb_paths trajectoires).*/
+	PrecisionReport comparePrecision(int nb_paths) const;
+
+	/*Contrôle d'annulation et de progression (voir PricingControl), consulté par generate() tous les
+	  PricingControl::CHECK_PATHS chemins (lots entiers en mode stratifié), avec la largeur courante de
+	  l'intervalle de confiance. Un generate() annulé lève PricingCancelled ; les trajectoires déjà simulées
+	  restent dans l'estimation, qui peut être complétée par un nouvel appel. nullptr : aucun contrôle.*/
+	void setControl(PricingControl* control) { _control = control; }
+
+	// Accès en lecture au nombre de chemins générés
+	long long getNbPaths() const { return _nbPaths * (_schedule.ready ? _schedule.strata : 1); }
+
+	/*Génère nb_paths trajectoires supplémentaires et met à jour l'estimation. En mode stratifié, chaque tirage de
+	  l'estimateur est la moyenne d'un lot de M trajectoires (une par strate) : nb_paths est arrondi au multiple
+	  de M supérieur et l'intervalle de confiance porte sur les moyennes de lots.
+	  Options à barrière et lookback : en surveillance discrète, seules les dates de surveillance sont simulées ;
+	  en surveillance continue, le franchissement de la barrière et les extrêmes entre deux dates simulées sont
+	  traités exactement par pont brownien (un seul pas à paramètres constants).
+	  Option scriptée : seules les dates utilisées par le script sont simulées ; hors volatilité locale, les
+	  payoffs sont évalués par le bytecode par lots de SCRIPT_LANES chemins, toujours en double précision.*/
 	void generate(int nb_paths);
 
+	/*Prix et sensibilités trajectorielles par différentiation adjointe sur nb_paths nouvelles trajectoires
+	  (estimation indépendante de celle de generate()). Avec des courbes (setTermStructures), les sensibilités
+	  à chaque pilier sont dans rateBuckets / volatilityBuckets. Le payoff est dérivé par différence finie
+	  locale : un payoff discontinu (digitale) n'a pas de dérivée trajectorielle et donne un delta nul.
+	  Non disponible en volatilité locale, ni pour les options à barrière, lookback et scriptées. Toujours en
+	  tirages simples.*/
+	Greeks greeks(int nb_paths);
+
 	// Retourne l'estimation courante 
 	double operator()() const;
 
-	// Retourne l'intervalle de confiance  95% sous la forme [borne_inf, borne_sup]
+	// Retourne l'intervalle de confiance à 95% sous la forme [borne_inf, borne_sup]
 	std::vector<double> confidenceInterval() const;
+
+	/*État de l'estimateur, avec la position courante du générateur MT. Le générateur est propre à chaque thread :
+	  c'est la position du moteur du thread appelant, qui doit être celui qui a exécuté generate() (le thread du
+	  job sous PricingScheduler) pour que la reprise soit à l'identique.*/
+	MCEstimatorState getState() const;
+
+	/*Restaure un état ; si restore_rng, la position du générateur du thread appelant est aussi restaurée. Un état
+	  non vide doit avoir la stratification du pricer (invalid_argument sinon).*/
+	void setState(const MCEstimatorState& state, bool restore_rng = true);
+
+	/*Agrège les tirages d'une exécution indépendante (autre processus, autre graine) sur le même problème, avec la
+	  même stratification (invalid_argument sinon).*/
+	void merge(const MCEstimatorState& other);
+
+	/*Point de reprise : écrit (de manière atomique) l'état de l'estimateur, la position du générateur et
+	  les paramètres du problème (marché, identité de l'option comme dans PricingKey, échantillonnage et
+	  précision). loadCheckpoint() refuse un fichier produit pour un autre problème. Réservé aux paramètres
+	  constants : les courbes et surfaces ne sont pas enregistrées. Comme getState(), la position enregistrée est
+	  celle du générateur du thread appelant : sous PricingScheduler, le point de reprise s'écrit depuis le job
+	  qui simule.*/
+	void saveCheckpoint(const std::string& path) const;
+	void loadCheckpoint(const std::string& path);
 };
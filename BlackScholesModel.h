@@ -0,0 +1,23 @@
+#pragma once
+#include "CharacteristicFunctionModel.h"
+#include <stdexcept>
+
+// Modèle de Black-Scholes vu par sa fonction caractéristique : X_T ~ N(-sigma^2 T / 2, sigma^2 T).
+class BlackScholesModel : public CharacteristicFunctionModel {
+private:
+	double _sigma;	// volatilité
+
+public:
+	explicit BlackScholesModel(double volatility) : _sigma(volatility) {
+		if (volatility <= 0.0) {
+			throw std::invalid_argument("Volatility must be positive.");
+		}
+	}
+
+	double getVolatility() const { return _sigma; }
+
+	std::complex<double> characteristicFunction(std::complex<double> u, double expiry) const override {
+		const std::complex<double> i(0.0, 1.0);
+		return std::exp(-0.5 * _sigma * _sigma * expiry * (i * u + u * u));
+	}
+};
@@ -1,4 +1,6 @@
 #include "BlackScholesPricer.h"
+#include "Telemetry.h"
+#include "adouble.h"
 #include <cmath>
 #include <stdexcept>
 #ifndef M_PI
@@ -6,19 +8,19 @@
 #endif
 
 namespace {
-    // Fonction de rpartition de la loi normale standard N(0,1)
+    // Fonction de répartition de la loi normale standard N(0,1)
     inline double N(double x) { // Standard normal CDF
         return 0.5 * std::erfc(-x / std::sqrt(2.0));
     }
 
-    // Densit de la loi normale standard n(x)
+    // Densité de la loi normale standard n(x)
     inline double n_pdf(double x) { 
         static const double INV_SQRT_2PI = 1.0 / std::sqrt(2.0 * M_PI);
         return INV_SQRT_2PI * std::exp(-0.5 * x * x);
     }
 }
 
-// Constructeur pour option europenne vanilla (Call/Put).
+// Constructeur pour option européenne vanilla (Call/Put).
 BlackScholesPricer::BlackScholesPricer(EuropeanVanillaOption* option,
     double asset_price,
     double interest_rate,
@@ -32,7 +34,7 @@ BlackScholesPricer::BlackScholesPricer(EuropeanVanillaOption* option,
     if (_sigma <= 0.0) throw std::invalid_argument("Volatility must be non-negative.");
 }
 
-// Constructeur pour option europenne digitale (Digital Call/Put).
+// Constructeur pour option européenne digitale (Digital Call/Put).
 BlackScholesPricer::BlackScholesPricer(EuropeanDigitalOption* option,
     double asset_price,
     double interest_rate,
@@ -45,60 +47,53 @@ BlackScholesPricer::BlackScholesPricer(EuropeanDigitalOption* option,
     if (_sigma < 0.0) throw std::invalid_argument("Volatility must be non-negative.");
 }
 
-// Prix Black-Scholes (formule ferme).
-double BlackScholesPricer::operator()() const {
-    //Cas option vanilla
-    if (_vanilla) {
-        const double T = _vanilla->getExpiry();
-        const double K = _vanilla->_strike; // friend access
-
-        // Prconditions (sinon d1/d2 non dfinis)
-        if (T <= 0.0) throw std::invalid_argument("Expiry must be positive for BS pricing.");
-        if (K <= 0.0) throw std::invalid_argument("Strike must be positive for BS pricing.");
-        if (_sigma <= 0.0) throw std::invalid_argument("Volatility must be positive for BS pricing.");
-
-        const double sT = _sigma * std::sqrt(T);
-        const double d1 = (std::log(_S / K) + (_r + 0.5 * _sigma * _sigma) * T) / sT;
-        const double d2 = d1 - sT;
-
-        // Formule Call/Put standard
-        if (_vanilla->GetOptionType() == EuropeanVanillaOption::Call) {
-            return _S * N(d1) - K * std::exp(-_r * T) * N(d2);
-        }
-        else {
-            return K * std::exp(-_r * T) * N(-d2) - _S * N(-d1);
-        }
-    }
-
-    // Cas option digital
-    if (_digital) {
-        const double T = _digital->getExpiry();
-        const double K = _digital->getStrike();
-
-        if (T <= 0.0) throw std::invalid_argument("Expiry must be positive for BS pricing.");
-        if (K <= 0.0) throw std::invalid_argument("Strike must be positive for BS pricing.");
-        if (_sigma <= 0.0) throw std::invalid_argument("Volatility must be positive for BS pricing.");
-
-        const double sT = _sigma * std::sqrt(T);
-        const double d2 = (std::log(_S / K) + (_r - 0.5 * _sigma * _sigma) * T) / sT;
+// Constructeur pour option barrière (surveillance continue ou discrète).
+BlackScholesPricer::BlackScholesPricer(BarrierOption* option,
+    double asset_price,
+    double interest_rate,
+    double volatility)
+    : _barrier(option),
+    _S(asset_price), _r(interest_rate), _sigma(volatility)
+{
+    if (!option) throw std::invalid_argument("Null barrier option pointer.");
+    if (_S <= 0.0) throw std::invalid_argument("Asset price must be positive.");
+    if (_sigma <= 0.0) throw std::invalid_argument("Volatility must be positive.");
+}
 
-        // Prix d'une digitale
-        if (_digital->GetOptionType() == EuropeanDigitalOption::Call) {
-            return std::exp(-_r * T) * N(d2);
-        }
-        else { 
-            return std::exp(-_r * T) * N(-d2);
-        }
+// Prix Black-Scholes (formule fermée).
+double BlackScholesPricer::operator()() const {
+    TELEMETRY_SCOPE(BlackScholes);
+    return price(_S, _r, _sigma);
+}
 
-        throw std::invalid_argument("Unsupported digital option type.");
+// Sensibilités par différentiation adjointe de la formule fermée
+Greeks BlackScholesPricer::greeks() const {
+    TELEMETRY_SCOPE(BlackScholes);
+
+    AADTape& tape = AADTape::threadLocal();
+    tape.clear();
+    AADTape::Scope scope(tape);
+
+    const adouble S = adouble::input(_S);
+    const adouble r = adouble::input(_r);
+    const adouble sigma = adouble::input(_sigma);
+    const adouble value = price(S, r, sigma);
+
+    Greeks result;
+    result.price = value.value();
+    if (!value.isConstant()) {
+        tape.propagate(value.index());
+        result.delta = S.adjoint();
+        result.rho = r.adjoint();
+        result.vega = sigma.adjoint();
     }
-
-    // Si aucun pointeur d'option n'est fourni (situation anormale)
-    throw std::runtime_error("No option provided to BlackScholesPricer.");
+    return result;
 }
 
 // Delta Black-Scholes.
 double BlackScholesPricer::delta() const {
+    TELEMETRY_SCOPE(BlackScholes);
+
     // as option vanilla
     if (_vanilla) {
         const double T = _vanilla->getExpiry();
@@ -143,5 +138,10 @@ double BlackScholesPricer::delta() const {
         throw std::invalid_argument("Unsupported digital option type.");
     }
 
+    // Cas option barrière : la formule est dérivée sur la bande AAD
+    if (_barrier) {
+        return greeks().delta;
+    }
+
     throw std::runtime_error("No option provided to BlackScholesPricer.");
 }
@@ -1,31 +1,185 @@
 #pragma once
 #include "EuropeanVanillaOption.h"
 #include "EuropeanDigitalOption.h"
+#include "BarrierOption.h"
+#include "Greeks.h"
 #include <cmath>
 #include <stdexcept>
 
-/*Pricer BlackScholes en formule ferme.
+/*Pricer BlackScholes en formule fermée.
 	Permet de pricer :
-	 - options europennes vanilles (Call / Put)
-	 - options digitales europennes (Call / Put)
- Le pricer contient soit une option vanilla, soit une option digitale, jamais les deux simultanment.*/
+	 - options européennes vanilles (Call / Put)
+	 - options digitales européennes (Call / Put)
+	 - options barrières (Call / Put, up/down, in/out, rebate versé à maturité)
+ Le pricer contient une seule option.*/
 class BlackScholesPricer {
 
 private:
 	EuropeanVanillaOption* _vanilla=nullptr;	// option vanilla (si non nulle)
 	EuropeanDigitalOption* _digital = nullptr;	// option digitale (si non nulle)
+	BarrierOption* _barrier = nullptr;	// option barrière (si non nulle)
 
 	double _S; // prix de l'actif sous-jacent
-	double _r; // taux d'intrt (continu)
-	double _sigma; // volatilit 
+	double _r; // taux d'intérêt (continu)
+	double _sigma; // volatilité 
+
+	/*Formules de Reiner-Rubinstein (barrière continue). En surveillance discrète (m dates), la barrière est
+	  déplacée de exp(+/- 0.5826 sigma sqrt(T/m)) vers l'extérieur (correction de Broadie-Glasserman-Kou).*/
+	template <typename Real>
+	Real barrierPrice(const Real& S, const Real& r, const Real& sigma) const;
 
 public:
-	BlackScholesPricer(EuropeanVanillaOption* option, double asset_price, double interest_rate, double volatility);	// Constructeur pour options europennes vanilles
-	BlackScholesPricer(EuropeanDigitalOption* option, double asset_price, double interest_rate, double volatility);	// Constructeur pour options digitales europennes
+	BlackScholesPricer(EuropeanVanillaOption* option, double asset_price, double interest_rate, double volatility);	// Constructeur pour options européennes vanilles
+	BlackScholesPricer(EuropeanDigitalOption* option, double asset_price, double interest_rate, double volatility);	// Constructeur pour options digitales européennes
+	BlackScholesPricer(BarrierOption* option, double asset_price, double interest_rate, double volatility);	// Constructeur pour options barrières
 
 	// Retourne le prix BlackScholes de l'option
 	double operator()() const;
 
-	// Retourne le Delta BlackScholes de l'option
+	// Retourne le Delta BlackScholes de l'option (par différentiation adjointe pour une barrière)
 	double delta() const;
-};
\ No newline at end of file
+
+	// Prix en formule fermée pour un type réel quelconque : double, ou adouble pour la différentiation adjointe
+	template <typename Real>
+	Real price(const Real& S, const Real& r, const Real& sigma) const;
+
+	// Prix, delta, rho et vega en une évaluation sur la bande AAD du thread
+	Greeks greeks() const;
+};
+
+template <typename Real>
+Real BlackScholesPricer::price(const Real& S, const Real& r, const Real& sigma) const {
+	using std::erfc;
+	using std::exp;
+	using std::log;
+	using std::sqrt;
+
+	// Fonction de répartition de la loi normale standard N(0,1)
+	auto N = [](const Real& x) { return 0.5 * erfc(-x / std::sqrt(2.0)); };
+
+	//Cas option vanilla
+	if (_vanilla) {
+		const double T = _vanilla->getExpiry();
+		const double K = _vanilla->_strike; // friend access
+
+		// Préconditions (sinon d1/d2 non définis)
+		if (T <= 0.0) throw std::invalid_argument("Expiry must be positive for BS pricing.");
+		if (K <= 0.0) throw std::invalid_argument("Strike must be positive for BS pricing.");
+		if (sigma <= 0.0) throw std::invalid_argument("Volatility must be positive for BS pricing.");
+
+		const Real sT = sigma * std::sqrt(T);
+		const Real d1 = (log(S / K) + (r + 0.5 * sigma * sigma) * T) / sT;
+		const Real d2 = d1 - sT;
+
+		// Formule Call/Put standard
+		if (_vanilla->GetOptionType() == EuropeanVanillaOption::Call) {
+			return S * N(d1) - K * exp(-r * T) * N(d2);
+		}
+		else {
+			return K * exp(-r * T) * N(-d2) - S * N(-d1);
+		}
+	}
+
+	// Cas option digital
+	if (_digital) {
+		const double T = _digital->getExpiry();
+		const double K = _digital->getStrike();
+
+		if (T <= 0.0) throw std::invalid_argument("Expiry must be positive for BS pricing.");
+		if (K <= 0.0) throw std::invalid_argument("Strike must be positive for BS pricing.");
+		if (sigma <= 0.0) throw std::invalid_argument("Volatility must be positive for BS pricing.");
+
+		const Real sT = sigma * std::sqrt(T);
+		const Real d2 = (log(S / K) + (r - 0.5 * sigma * sigma) * T) / sT;
+
+		// Prix d'une digitale
+		if (_digital->GetOptionType() == EuropeanDigitalOption::Call) {
+			return exp(-r * T) * N(d2);
+		}
+		else {
+			return exp(-r * T) * N(-d2);
+		}
+	}
+
+	// Cas option barrière
+	if (_barrier) {
+		return barrierPrice(S, r, sigma);
+	}
+
+	// Si aucun pointeur d'option n'est fourni (situation anormale)
+	throw std::runtime_error("No option provided to BlackScholesPricer.");
+}
+
+template <typename Real>
+Real BlackScholesPricer::barrierPrice(const Real& S, const Real& r, const Real& sigma) const {
+	using std::erfc;
+	using std::exp;
+	using std::log;
+	using std::sqrt;
+
+	auto N = [](const Real& x) { return 0.5 * erfc(-x / std::sqrt(2.0)); };
+
+	const double T = _barrier->getExpiry();
+	const double K = _barrier->getStrike();
+	const double rebate = _barrier->getRebate();
+
+	if (T <= 0.0) throw std::invalid_argument("Expiry must be positive for BS pricing.");
+	if (K <= 0.0) throw std::invalid_argument("Strike must be positive for BS pricing.");
+	if (sigma <= 0.0) throw std::invalid_argument("Volatility must be positive for BS pricing.");
+
+	const double phi = _barrier->GetOptionType() == BarrierOption::Call ? 1.0 : -1.0;	// Call / Put
+	const double eta = _barrier->isUp() ? -1.0 : 1.0;	// barrière haute / basse
+	const Real sT = sigma * std::sqrt(T);
+	const Real discount = exp(-r * T);
+
+	// Barrière effective (décalée vers l'extérieur en surveillance discrète)
+	Real H = Real(_barrier->getBarrier());
+	if (!_barrier->isContinuouslyMonitored()) {
+		const double dt = T / static_cast<double>(_barrier->getMonitoringDates().size());
+		H = H * exp(-eta * 0.5826 * sigma * std::sqrt(dt));
+	}
+
+	// Vanille, au sens du payoff de l'option
+	const Real x1 = log(S / K) / sT + 0.5 * sT + r * T / sT;
+	const Real vanilla = phi * S * N(phi * x1) - phi * K * discount * N(phi * (x1 - sT));
+
+	// Barrière déjà franchie : la knock-in est devenue vanille, la knock-out ne vaut plus que son rebate
+	const bool breached = _barrier->isUp() ? S >= H : S <= H;
+	if (breached) {
+		return _barrier->isKnockIn() ? vanilla : rebate * discount;
+	}
+
+	// Notations de Haug : mu = (r - sigma^2/2) / sigma^2, (H/S)^a = exp(a ln(H/S))
+	const Real mu = (r - 0.5 * sigma * sigma) / (sigma * sigma);
+	const Real logHS = log(H / S);
+	const Real x2 = -logHS / sT + (1.0 + mu) * sT;
+	const Real y1 = (2.0 * logHS - log(K / S)) / sT + (1.0 + mu) * sT;
+	const Real y2 = logHS / sT + (1.0 + mu) * sT;
+	const Real powA = exp(2.0 * (mu + 1.0) * logHS);
+	const Real powB = exp(2.0 * mu * logHS);
+
+	const Real A = vanilla;
+	const Real B = phi * S * N(phi * x2) - phi * K * discount * N(phi * (x2 - sT));
+	const Real C = phi * S * powA * N(eta * y1) - phi * K * discount * powB * N(eta * (y1 - sT));
+	const Real D = phi * S * powA * N(eta * y2) - phi * K * discount * powB * N(eta * (y2 - sT));
+
+	// Knock-out sans rebate
+	const bool call = phi > 0.0;
+	const bool strikeAbove = K > H;
+	Real knockOut;
+	if (!_barrier->isUp()) {
+		knockOut = call ? (strikeAbove ? A - C : B - D) : (strikeAbove ? A - B + C - D : Real(0.0));
+	}
+	else {
+		knockOut = call ? (strikeAbove ? Real(0.0) : A - B + C - D) : (strikeAbove ? B - D : A - C);
+	}
+
+	// Probabilité (risque-neutre) de ne jamais atteindre la barrière, pour le rebate versé à maturité
+	const Real survival = N(eta * (x2 - sT)) - powB * N(eta * (y2 - sT));
+	const Real rebateIfSurvives = rebate * discount * survival;
+
+	if (_barrier->isKnockIn()) {
+		return A - knockOut + rebateIfSurvives;
+	}
+	return knockOut + rebate * discount - rebateIfSurvives;
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "CRRBatchPricer.h"
+#include "AmericanOption.h"
+#include "EuropeanVanillaOption.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+CRRBatchPricer::CRRBatchPricer(int depth)
+    : _depth(depth)
+{
+    if (depth < 0) {
+        throw std::invalid_argument("Depth must be non-negative.");
+    }
+}
+
+/*Mêmes paramètres que le constructeur Black-Scholes de CRRPricer :
+    -U = exp(sigma sqrt(dt)) - 1, D = exp(-sigma sqrt(dt)) - 1, R = exp(r dt) - 1, q = (R - D) / (U - D)*/
+void CRRBatchPricer::add(Option* option, double asset_price, double interest_rate, double volatility) {
+    if (!option) {
+        throw std::invalid_argument("Null option pointer.");
+    }
+
+    Lane lane;
+    if (const EuropeanVanillaOption* vanilla = dynamic_cast<const EuropeanVanillaOption*>(option)) {
+        lane.K = vanilla->getStrike();
+        lane.phi = vanilla->GetOptionType() == EuropeanVanillaOption::Call ? 1.0 : -1.0;
+        lane.early = 0.0;
+    }
+    else if (const AmericanOption* american = dynamic_cast<const AmericanOption*>(option)) {
+        lane.K = american->getStrike();
+        lane.phi = american->GetOptionType() == AmericanOption::Call ? 1.0 : -1.0;
+        lane.early = 1.0;
+    }
+    else {
+        throw std::invalid_argument("Batch lattice only prices vanilla European and American options.");
+    }
+    if (asset_price <= 0.0) {
+        throw std::invalid_argument("Asset price must be positive.");
+    }
+
+    const double dt = option->getExpiry() / _depth;
+    const double U = std::exp(volatility * std::sqrt(dt)) - 1.0;
+    const double D = std::exp(-volatility * std::sqrt(dt)) - 1.0;
+    const double R = std::exp(interest_rate * dt) - 1.0;
+
+    // Condition d'absence d'arbitrage : D < R < U
+    if (!(D < R && R < U)) {
+        throw std::invalid_argument("Arbitrage condition violated: require D < R < U");
+    }
+
+    lane.S0 = asset_price;
+    lane.q = (R - D) / (U - D);
+    lane.disc = 1.0 / (1.0 + R);
+    lane.d = 1.0 + D;
+    lane.ud = (1.0 + U) / lane.d;
+    _lanes.push_back(lane);
+}
+
+/*Les options sont traitées par groupes de LANES (le dernier complété par des copies de la première voie,
+  dont les prix sont ignorés). Pour chaque groupe, S(n,0) = S0 d^n est tabulé pour tous les niveaux (même
+  suite de produits que StockLattice), puis l'induction ne garde qu'une ligne de (N+1) x LANES valeurs.*/
+std::vector<double> CRRBatchPricer::operator()() const {
+    TELEMETRY_SCOPE(CRRCompute);
+
+    const int N = _depth;
+    const std::size_t L = LANES;
+    std::vector<double> prices(_lanes.size());
+    std::vector<double> values((static_cast<std::size_t>(N) + 1) * L);
+    std::vector<double> levelStart((static_cast<std::size_t>(N) + 1) * L);
+
+    for (std::size_t first = 0; first < _lanes.size(); first += L) {
+        const std::size_t nb = std::min(L, _lanes.size() - first);
+
+        // Paramètres du groupe, en tableaux alignés sur les voies
+        alignas(64) double K[LANES], phi[LANES], early[LANES], pu[LANES], pd[LANES], disc[LANES], ud[LANES], S[LANES];
+        for (std::size_t l = 0; l < L; ++l) {
+            const Lane& lane = _lanes[first + (l < nb ? l : 0)];
+            K[l] = lane.K;
+            phi[l] = lane.phi;
+            early[l] = lane.early;
+            pu[l] = lane.q;
+            pd[l] = 1.0 - lane.q;
+            disc[l] = lane.disc;
+            ud[l] = lane.ud;
+
+            double d_pow_n = 1.0;
+            for (int n = 0; n <= N; ++n) {
+                levelStart[static_cast<std::size_t>(n) * L + l] = lane.S0 * d_pow_n;
+                d_pow_n *= lane.d;
+            }
+        }
+
+        // Payoff à maturité
+        for (std::size_t l = 0; l < L; ++l) S[l] = levelStart[static_cast<std::size_t>(N) * L + l];
+        for (int i = 0; i <= N; ++i) {
+            double* v = &values[static_cast<std::size_t>(i) * L];
+            for (std::size_t l = 0; l < L; ++l) {
+                v[l] = std::max(phi[l] * (S[l] - K[l]), 0.0);
+                S[l] *= ud[l];
+            }
+        }
+
+        // Backward induction, sans branchement sur les voies
+        for (int n = N - 1; n >= 0; --n) {
+            for (std::size_t l = 0; l < L; ++l) S[l] = levelStart[static_cast<std::size_t>(n) * L + l];
+            for (int i = 0; i <= n; ++i) {
+                double* v = &values[static_cast<std::size_t>(i) * L];
+                const double* up = v + L;
+                for (std::size_t l = 0; l < L; ++l) {
+                    const double continuation = (pu[l] * up[l] + pd[l] * v[l]) * disc[l];
+                    const double intrinsic = std::max(phi[l] * (S[l] - K[l]), 0.0);
+                    v[l] = std::max(continuation, early[l] * intrinsic);
+                    S[l] *= ud[l];
+                }
+            }
+        }
+
+        for (std::size_t l = 0; l < nb; ++l) prices[first + l] = values[l];
+    }
+
+    TELEMETRY_COUNT(NodesVisited, static_cast<long long>(_lanes.size()) * (static_cast<long long>(N) + 1) * (N + 2) / 2);
+    return prices;
+}
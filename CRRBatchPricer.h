@@ -0,0 +1,41 @@
+#pragma once
+#include "Option.h"
+#include <cstddef>
+#include <vector>
+
+/*Pricer CRR par lots : plusieurs options vanilles (européennes ou américaines) de même profondeur N, mais de
+	strikes, spots, taux et volatilités différents, sont valorisées ensemble, une option par voie (lane).
+	L'induction rétrograde de LANES arbres est entrelacée (valeur du noeud i de la voie l en i * LANES + l) :
+	le mélange hausse/baisse, l'actualisation et l'exercice anticipé, max(continuation, e * intrinsèque) avec
+	e = 1 (américaine) ou 0 (européenne, les valeurs étant positives), sont calculés sans branchement sur
+	toutes les voies, ce qui permet au compilateur de vectoriser la boucle interne (SSE/AVX/NEON selon la cible).
+	Les noeuds et les valeurs sont calculés par les mêmes opérations que StockLattice et CRRPricer::compute() :
+	les prix sont identiques à ceux de CRRPricer construit à partir de (r, sigma).*/
+class CRRBatchPricer {
+private:
+	int _depth;		// profondeur commune des arbres
+
+	// Paramètres d'une option, ramenés à ce qu'utilise l'induction
+	struct Lane {
+		double S0, K;
+		double phi;		// +1 Call, -1 Put
+		double early;	// 1 si exercice anticipé, 0 sinon
+		double q, disc;	// probabilité risque-neutre et actualisation d'un pas
+		double d, ud;	// 1 + D et (1 + U) / (1 + D)
+	};
+	std::vector<Lane> _lanes;
+
+public:
+	static const int LANES = 8;	// options traitées ensemble (deux registres AVX2, un AVX-512)
+
+	explicit CRRBatchPricer(int depth);
+
+	// Ajoute une option vanille européenne ou américaine avec ses paramètres Black-Scholes (même discrétisation que CRRPricer).
+	void add(Option* option, double asset_price, double interest_rate, double volatility);
+
+	// Nombre d'options du lot
+	std::size_t size() const { return _lanes.size(); }
+
+	// Prix de toutes les options, dans l'ordre d'ajout
+	std::vector<double> operator()() const;
+};
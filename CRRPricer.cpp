@@ -1,4 +1,16 @@
 ﻿#include "CRRPricer.h"
+#include "BarrierOption.h"
+#include "ScriptedOption.h"
+#include "Telemetry.h"
+#include "adouble.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
 
 /*Constructeur CRR explicite
     Paramètres :
@@ -13,16 +25,73 @@ CRRPricer::CRRPricer(Option* option,
     double asset_price,
     double up,
     double down,
-    double interest_rate)
+    double interest_rate,
+    std::pmr::memory_resource* resource)
     : _option(option),
     _depth(depth),
-    _S0(asset_price),
     _U(up),
     _D(down),
     _R(interest_rate),
     _q(0.0),
-    _computed(false)
+    _rate(std::numeric_limits<double>::quiet_NaN()),
+    _volatility(std::numeric_limits<double>::quiet_NaN()),
+    _priceTree(resource),
+    _exerciseTree(resource),
+    _singlePriceTree(resource),
+    _computed(false),
+    _precision(DoublePrecision),
+    _singleTree(false),
+    _nbThreads(0),
+    _tileWidth(4096),
+    _blockLevels(64),
+    _pruneWidth(0.0),
+    _control(nullptr)
 {
+    validate();
+
+    // L'arbre du sous-jacent ne sera construit qu'au premier accès ; il est alloué sur la même ressource
+    _lattice = std::allocate_shared<StockLattice>(std::pmr::polymorphic_allocator<StockLattice>(resource),
+        asset_price, _U, _D, _depth, resource);
+}
+
+/*Constructeur CRR à partir d'un arbre du sous-jacent partagé
+    Paramètres :
+      - option        : option a pricer (européenne ou américaine)
+      - lattice       : arbre du sous-jacent (S0, U, D, N), éventuellement utilisé par d'autres pricers
+      - interest_rate : rendement sans risque par pas (R)
+      - resource      : ressource mémoire des arbres de prix et d'exercice*/
+CRRPricer::CRRPricer(Option* option,
+    std::shared_ptr<const StockLattice> lattice,
+    double interest_rate,
+    std::pmr::memory_resource* resource)
+    : _option(option),
+    _depth(lattice ? lattice->getDepth() : 0),
+    _U(lattice ? lattice->getU() : 0.0),
+    _D(lattice ? lattice->getD() : 0.0),
+    _R(interest_rate),
+    _q(0.0),
+    _rate(std::numeric_limits<double>::quiet_NaN()),
+    _volatility(std::numeric_limits<double>::quiet_NaN()),
+    _lattice(std::move(lattice)),
+    _priceTree(resource),
+    _exerciseTree(resource),
+    _singlePriceTree(resource),
+    _computed(false),
+    _precision(DoublePrecision),
+    _singleTree(false),
+    _nbThreads(0),
+    _tileWidth(4096),
+    _blockLevels(64),
+    _pruneWidth(0.0),
+    _control(nullptr)
+{
+    if (!_lattice) {
+        throw std::invalid_argument("Null lattice pointer.");
+    }
+    validate();
+}
+
+void CRRPricer::validate() {
     // Verification pointeur option
     if (!_option) {
         throw std::invalid_argument("Null option pointer.");
@@ -32,6 +101,16 @@ CRRPricer::CRRPricer(Option* option,
     if (_option->isAsianOption()) {
         throw std::invalid_argument("CRR Pricer does not support Asian options.");
     }
+    if (_option->isLookbackOption()) {
+        throw std::invalid_argument("CRR Pricer does not support lookback options.");
+    }
+    if (_option->isMultiAssetOption()) {
+        throw std::invalid_argument("CRR Pricer does not support multi-asset options.");
+    }
+    // Un script n'est évalué qu'aux noeuds de l'échéance
+    if (_option->isScriptedOption() && !static_cast<const ScriptedOption*>(_option)->observesExpiryOnly()) {
+        throw std::invalid_argument("CRR Pricer supports scripted options observing the expiry only.");
+    }
 
     if (_depth < 0) {
         throw std::invalid_argument("Depth must be non-negative.");
@@ -42,31 +121,8 @@ CRRPricer::CRRPricer(Option* option,
         throw std::invalid_argument("Arbitrage condition violated: require D < R < U");
     }
 
-
     // Probabilite neutre au risque
     _q = (_R - _D) / (_U - _D);
-
-    // Initialisation des arbres binomiaux
-    _stockTree.setDepth(_depth);
-    _priceTree.setDepth(_depth);
-    _exerciseTree.setDepth(_depth);
-
-  
-    // Construction de l'arbre du sous-jacent, S(n,0) = S0 * (1+D)^n, and S(n,i+1) = S(n,i) * (1+U)/(1+D)
-    const double u = 1.0 + _U;
-    const double d = 1.0 + _D;
-    const double ud = u / d;
-
-    double d_pow_n = 1.0; // d^0
-    for (int n = 0; n <= _depth; ++n) {
-        double S = _S0 * d_pow_n; // S(n,0)
-        for (int i = 0; i <= n; ++i) {
-            _stockTree.setNode(n, i, S);
-            _exerciseTree.setNode(n, i, false); // initialiser à faux
-			S *= ud; //Prochain noeud au meme niveau
-        }
-		d_pow_n *= d; //Prochain niveau
-    }
 }
 
 /*Constructeur CRR à partir de Black - Scholes
@@ -79,14 +135,92 @@ CRRPricer::CRRPricer(Option* option,
     int depth,
     double asset_price,
     double r,
-    double volatility)
+    double volatility,
+    std::pmr::memory_resource* resource)
+    : CRRPricer(option, AlignedDepth{ alignedDepth(option, depth, asset_price, volatility) }, asset_price, r, volatility, resource)
+{
+}
+
+CRRPricer::CRRPricer(Option* option,
+    AlignedDepth depth,
+    double asset_price,
+    double r,
+    double volatility,
+    std::pmr::memory_resource* resource)
+    : CRRPricer(option,
+        depth.value,
+        asset_price,
+        std::exp(volatility* std::sqrt(option->getExpiry() / depth.value)) - 1.0,   // U
+        std::exp(-volatility * std::sqrt(option->getExpiry() / depth.value)) - 1.0,  // D
+        std::exp(r* (option->getExpiry() / depth.value)) - 1.0,                     // R
+        resource)
+{
+    _rate = r;
+    _volatility = volatility;
+}
+
+/*La couche j est à la distance j sigma sqrt(T/N) de ln S0 : avec N = floor(j^2 sigma^2 T / L^2), L = |ln(B/S0)|,
+  elle est au-delà de la barrière (de moins d'une fraction de pas) et la couche j-1 en deçà. En surveillance
+  discrète, la barrière est placée à mi-chemin entre deux couches (j + 1/2), ce qui stabilise la convergence.*/
+int CRRPricer::alignedDepth(const Option* option, int depth, double asset_price, double volatility) {
+    if (!option || !option->isBarrierOption() || depth <= 0 || volatility <= 0.0 || asset_price <= 0.0) {
+        return depth;
+    }
+    const BarrierOption* barrier = static_cast<const BarrierOption*>(option);
+    const double T = option->getExpiry();
+    const double L = std::abs(std::log(barrier->getBarrier() / asset_price));
+    if (T <= 0.0 || L == 0.0) {
+        return depth;
+    }
+
+    const double c = volatility * volatility * T / (L * L);
+    const double offset = barrier->isContinuouslyMonitored() ? 0.0 : 0.5;
+    for (long long j = std::max(1LL, static_cast<long long>(std::sqrt(depth / c))); ; ++j) {
+        const double N = std::floor((j + offset) * (j + offset) * c);
+        if (N >= depth) {
+            if (N > std::numeric_limits<int>::max()) return depth;
+            return static_cast<int>(N);
+        }
+    }
+}
+
+/*Constructeur CRR à partir de courbes constantes par morceaux
+    Avec V la variance intégrée jusqu'à maturité :
+        -U = exp(sqrt(V/N)) - 1, D = exp(-sqrt(V/N)) - 1
+        -tau_n tel que int_0^tau_n sigma^2 = n V / N
+        -R_n = exp(int_{tau_n}^{tau_{n+1}} r) - 1*/
+CRRPricer::CRRPricer(Option* option,
+    int depth,
+    double asset_price,
+    const TermStructure& rate,
+    const TermStructure& volatility,
+    std::pmr::memory_resource* resource)
     : CRRPricer(option,
         depth,
         asset_price,
-        std::exp(volatility* std::sqrt(option->getExpiry() / depth)) - 1.0,   // U
-        std::exp(-volatility * std::sqrt(option->getExpiry() / depth)) - 1.0,  // D
-        std::exp(r* (option->getExpiry() / depth)) - 1.0)                     // R
+        std::exp(std::sqrt(volatility.integralSquared(0.0, option->getExpiry()) / depth)) - 1.0,   // U
+        std::exp(-std::sqrt(volatility.integralSquared(0.0, option->getExpiry()) / depth)) - 1.0,  // D
+        std::exp(rate.integral(0.0, option->getExpiry()) / depth) - 1.0,                           // R moyen
+        resource)
 {
+    // Courbes constantes : l'arbre CRR usuel convient
+    if (rate.isFlat() && volatility.isFlat()) return;
+
+    const double T = _option->getExpiry();
+    const double V = volatility.integralSquared(0.0, T);
+
+    _stepR.resize(_depth);
+    double tau = 0.0;
+    for (int n = 0; n < _depth; ++n) {
+        const double next = n + 1 == _depth ? T : volatility.inverseIntegralSquared(V * (n + 1) / _depth);
+        _stepR[n] = std::exp(rate.integral(tau, next)) - 1.0;
+
+        // Condition d'absence d'arbitrage à chaque pas
+        if (!(_D < _stepR[n] && _stepR[n] < _U)) {
+            throw std::invalid_argument("Arbitrage condition violated at some step: require D < R < U");
+        }
+        tau = next;
+    }
 }
 
 // Construction complete de l'arbre de prix (backward induction)
@@ -94,14 +228,38 @@ void CRRPricer::compute() {
     // Si déjà calcule, on ne refait rien
     if (_computed) return;
 
+    TELEMETRY_SCOPE(CRRCompute);
+
+    if (_option->isBarrierOption()) {
+        computeBarrier();
+        _computed = true;
+        return;
+    }
+
+    if (_pruneWidth > 0.0) {
+        computePruned();
+        _computed = true;
+        return;
+    }
+
+    if (_precision == SinglePrecision) {
+        computeSingle();
+        _singleTree = true;
+        _computed = true;
+        return;
+    }
+
     const int N = _depth;
     const bool isAmerican = _option->isAmericanOption();
-    // Facteur d'actualisation par pas
-    const double disc = 1.0 / (1.0 + _R);
+    const bool timeDependent = !_stepR.empty();
+
+    // Allocation des arbres de prix et d'exercice (uniquement pour l'induction rétrograde)
+    _priceTree.setDepth(N);
+    _exerciseTree.setDepth(N);
 
 	// Payoff a maturite
     for (int i = 0; i <= N; ++i) {
-        const double ST = _stockTree.getNode(N, i);
+        const double ST = _lattice->getNode(N, i);
         const double intrinsic = _option->payoff(ST);
 
         _priceTree.setNode(N, i, intrinsic);
@@ -111,16 +269,21 @@ void CRRPricer::compute() {
 
     // Backward induction
     for (int n = N - 1; n >= 0; --n) {
+        // Probabilité et facteur d'actualisation du pas n -> n+1
+        const double R = timeDependent ? _stepR[n] : _R;
+        const double q = timeDependent ? (R - _D) / (_U - _D) : _q;
+        const double disc = 1.0 / (1.0 + R);
+
         for (int i = 0; i <= n; ++i) {
             // Valeurs futures
             const double upVal = _priceTree.getNode(n + 1, i + 1);
             const double downVal = _priceTree.getNode(n + 1, i);
 
             // Valeur de continuation
-            const double continuation = (_q * upVal + (1.0 - _q) * downVal) * disc;
+            const double continuation = (q * upVal + (1.0 - q) * downVal) * disc;
 
             // Valeur intrinsèque au noeud courant
-            const double S = _stockTree.getNode(n, i);
+            const double S = _lattice->getNode(n, i);
             const double intrinsic = _option->payoff(S);
 
             double nodeValue = continuation;
@@ -136,16 +299,567 @@ void CRRPricer::compute() {
             _priceTree.setNode(n, i, nodeValue);
             _exerciseTree.setNode(n, i, exerciseNow);
         }
+        reportLevels(N - n);
     }
 
+    TELEMETRY_COUNT(NodesVisited, (static_cast<long long>(N) + 1) * (N + 2) / 2);
     _computed = true;
 }
 
+/*Même induction que compute() : seule la valeur de chaque noeud est arrondie en float. Les valeurs du sous-jacent
+  sont obtenues par les mêmes produits que StockLattice::build(), une ligne à la fois.*/
+void CRRPricer::computeSingle() {
+    const int N = _depth;
+    const bool isAmerican = _option->isAmericanOption();
+    const bool timeDependent = !_stepR.empty();
+    const double S0 = _lattice->getS0();
+    const double d = 1.0 + _D;
+    const double ud = (1.0 + _U) / d;
+
+    _singlePriceTree.setDepth(N);
+    _exerciseTree.setDepth(N);
+
+    std::vector<double> rowStart(N + 1);
+    double d_pow_n = 1.0;
+    for (int n = 0; n <= N; ++n) {
+        rowStart[n] = S0 * d_pow_n;
+        d_pow_n *= d;
+    }
+
+    // Payoff a maturite
+    double S = rowStart[N];
+    for (int i = 0; i <= N; ++i) {
+        const double intrinsic = _option->payoff(S);
+        _singlePriceTree.setNode(N, i, static_cast<float>(intrinsic));
+        _exerciseTree.setNode(N, i, isAmerican && (intrinsic > 0.0));
+        S *= ud;
+    }
+
+    // Backward induction : probabilités et actualisation en double, valeurs stockées en float
+    for (int n = N - 1; n >= 0; --n) {
+        const double R = timeDependent ? _stepR[n] : _R;
+        const double q = timeDependent ? (R - _D) / (_U - _D) : _q;
+        const double disc = 1.0 / (1.0 + R);
+
+        S = rowStart[n];
+        for (int i = 0; i <= n; ++i) {
+            const double upVal = _singlePriceTree.getNode(n + 1, i + 1);
+            const double downVal = _singlePriceTree.getNode(n + 1, i);
+            const double continuation = (q * upVal + (1.0 - q) * downVal) * disc;
+
+            double nodeValue = continuation;
+            bool exerciseNow = false;
+            if (isAmerican) {
+                const double intrinsic = _option->payoff(S);
+                if (intrinsic >= continuation) {
+                    nodeValue = intrinsic;
+                    exerciseNow = true;
+                }
+            }
+
+            _singlePriceTree.setNode(n, i, static_cast<float>(nodeValue));
+            _exerciseTree.setNode(n, i, exerciseNow);
+            S *= ud;
+        }
+        reportLevels(N - n);
+    }
+
+    TELEMETRY_COUNT(NodesVisited, (static_cast<long long>(N) + 1) * (N + 2) / 2);
+}
+
+void CRRPricer::setPrecision(computePrecision precision) {
+    _precision = precision;
+    _computed = false;
+    _singleTree = false;
+}
+
+PrecisionReport CRRPricer::comparePrecision() const {
+    // Arbre complet de compute() dans les deux cas (l'arbre tronqué et le mode parallèle sont en double)
+    CRRPricer reference(*this), single(*this);
+    for (CRRPricer* pricer : { &reference, &single }) {
+        pricer->_nbThreads = 0;
+        pricer->setPruning(0.0);
+    }
+    reference.setPrecision(DoublePrecision);
+    single.setPrecision(SinglePrecision);
+
+    // L'arbre du sous-jacent (partagé, construit au premier accès) ne doit pas être compté dans le temps en double
+    _lattice->getNode(0, 0);
+
+    PrecisionReport report;
+    auto t0 = std::chrono::steady_clock::now();
+    const double referenceValue = reference();
+    auto t1 = std::chrono::steady_clock::now();
+    const double singleValue = single();
+    auto t2 = std::chrono::steady_clock::now();
+
+    report.setValues(referenceValue, singleValue);
+    report.doubleSeconds = std::chrono::duration<double>(t1 - t0).count();
+    report.singleSeconds = std::chrono::duration<double>(t2 - t1).count();
+    return report;
+}
+
+void CRRPricer::setPruning(double nb_std_devs) {
+    if (!(nb_std_devs >= 0.0)) {
+        throw std::invalid_argument("Number of standard deviations must be non-negative.");
+    }
+    _pruneWidth = nb_std_devs;
+
+    // Les arbres déjà calculés ne correspondent plus au mode demandé
+    _computed = false;
+    _singleTree = false;
+    _bandLow.clear();
+    _bandHigh.clear();
+    _bandOffset.clear();
+    _bandValues.clear();
+    _bandExercise.clear();
+    _growth.clear();
+}
+
+/*Le nombre de hausses i_n au niveau n est une somme de Bernoulli de paramètres q_0..q_{n-1} : moyenne c_n = sum q_m,
+  variance v_n = sum q_m (1 - q_m). Les niveaux actifs sont stockés bout à bout ; un noeud du niveau n+1 hors de
+  la bande (au plus un de chaque côté par niveau) est remplacé par sa valeur de bord. S(n, i) est calculé en tête
+  de bande par S0 d^(n-i) u^i, puis par produits successifs par u/d.*/
+void CRRPricer::computePruned() {
+    const int N = _depth;
+    const bool isAmerican = _option->isAmericanOption();
+    const bool timeDependent = !_stepR.empty();
+    const double S0 = _lattice->getS0();
+    const double u = 1.0 + _U;
+    const double d = 1.0 + _D;
+    const double ud = u / d;
+
+    _growth.assign(N + 1, 1.0);
+    for (int n = N - 1; n >= 0; --n) {
+        _growth[n] = _growth[n + 1] * (1.0 + (timeDependent ? _stepR[n] : _R));
+    }
+
+    // Bande de chaque niveau
+    _bandLow.resize(N + 1);
+    _bandHigh.resize(N + 1);
+    _bandOffset.resize(N + 2);
+    _bandOffset[0] = 0;
+    double mean = 0.0, variance = 0.0;
+    for (int n = 0; n <= N; ++n) {
+        const double halfWidth = _pruneWidth * std::sqrt(variance);
+        _bandLow[n] = std::max(0, static_cast<int>(std::floor(mean - halfWidth)));
+        _bandHigh[n] = std::min(n, static_cast<int>(std::ceil(mean + halfWidth)));
+        _bandOffset[n + 1] = _bandOffset[n] + (_bandHigh[n] - _bandLow[n] + 1);
+        if (n < N) {
+            const double q = timeDependent ? (_stepR[n] - _D) / (_U - _D) : _q;
+            mean += q;
+            variance += q * (1.0 - q);
+        }
+    }
+    _bandValues.assign(_bandOffset[N + 1], 0.0);
+    _bandExercise.assign(_bandOffset[N + 1], false);
+
+    // Payoff à maturité
+    {
+        const int low = _bandLow[N];
+        double S = S0 * std::pow(d, N - low) * std::pow(u, low);
+        for (int i = low; i <= _bandHigh[N]; ++i) {
+            const double intrinsic = _option->payoff(S);
+            _bandValues[_bandOffset[N] + (i - low)] = intrinsic;
+            _bandExercise[_bandOffset[N] + (i - low)] = isAmerican && (intrinsic > 0.0);
+            S *= ud;
+        }
+    }
+
+    // Backward induction sur la bande
+    for (int n = N - 1; n >= 0; --n) {
+        const double R = timeDependent ? _stepR[n] : _R;
+        const double q = timeDependent ? (R - _D) / (_U - _D) : _q;
+        const double disc = 1.0 / (1.0 + R);
+
+        const int low = _bandLow[n], nextLow = _bandLow[n + 1], nextHigh = _bandHigh[n + 1];
+        const double* next = _bandValues.data() + _bandOffset[n + 1];
+        auto nextValue = [&](int j, double S) {
+            return j >= nextLow && j <= nextHigh ? next[j - nextLow] : boundaryValue(n + 1, S);
+        };
+
+        double S = S0 * std::pow(d, n - low) * std::pow(u, low);
+        for (int i = low; i <= _bandHigh[n]; ++i) {
+            const double continuation = (q * nextValue(i + 1, S * u) + (1.0 - q) * nextValue(i, S * d)) * disc;
+
+            double nodeValue = continuation;
+            bool exerciseNow = false;
+            if (isAmerican) {
+                const double intrinsic = _option->payoff(S);
+                if (intrinsic >= continuation) {
+                    nodeValue = intrinsic;
+                    exerciseNow = true;
+                }
+            }
+
+            _bandValues[_bandOffset[n] + (i - low)] = nodeValue;
+            _bandExercise[_bandOffset[n] + (i - low)] = exerciseNow;
+            S *= ud;
+        }
+        reportLevels(N - n);
+    }
+
+    TELEMETRY_COUNT(NodesVisited, static_cast<long long>(_bandOffset[N + 1]));
+}
+
+/*Valeur européenne asymptotique : loin du forward, le payoff est affine sur presque toute la loi terminale
+  et la valeur est celle du payoff au forward, actualisée. Une option américaine vaut au moins l'exercice immédiat.*/
+double CRRPricer::boundaryValue(int n, double S) const {
+    const double european = _option->payoff(S * _growth[n]) / _growth[n];
+    return _option->isAmericanOption() ? std::max(_option->payoff(S), european) : european;
+}
+
+void CRRPricer::setParallel(int nb_threads, int tile_width, int block_levels) {
+    if (nb_threads < 0) {
+        throw std::invalid_argument("Number of threads must be non-negative.");
+    }
+    if (tile_width <= 0 || block_levels <= 0) {
+        throw std::invalid_argument("Tile width and block levels must be positive.");
+    }
+    _nbThreads = nb_threads > 0 ? nb_threads : std::max(1u, std::thread::hardware_concurrency());
+    _tileWidth = tile_width;
+    _blockLevels = block_levels;
+}
+
+namespace {
+    // Barrière de synchronisation réutilisable (génération comptée)
+    class ThreadBarrier {
+    private:
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        const int _count;
+        int _waiting = 0;
+        long long _generation = 0;
+
+    public:
+        explicit ThreadBarrier(int count) : _count(count) {}
+
+        void wait() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            const long long generation = _generation;
+            if (++_waiting == _count) {
+                _waiting = 0;
+                ++_generation;
+                _cv.notify_all();
+                return;
+            }
+            _cv.wait(lock, [&] { return generation != _generation; });
+        }
+    };
+}
+
+/*Blocs de niveaux [m, n], m = max(n - B, 0) : la ligne n (cur) donne la ligne m (next). La tuile de sortie
+  [a, b) de la ligne m dépend des noeuds [a, b + n - m) de la ligne n, copiés dans un tampon local puis
+  avancés niveau par niveau (la tuile rétrécit d'un noeud par niveau). Les tuiles d'un bloc sont disjointes en
+  écriture et ne lisent que cur : une barrière par bloc suffit. La valeur du sous-jacent S(L, i) est calculée
+  en tête de tuile par S0 d^(L-i) u^i, puis par produits successifs par u/d comme dans StockLattice.*/
+double CRRPricer::parallelInduction() const {
+    TELEMETRY_SCOPE(CRRCompute);
+
+    const int N = _depth;
+    const bool isAmerican = _option->isAmericanOption();
+    const bool timeDependent = !_stepR.empty();
+    const double S0 = _lattice->getS0();
+    const double u = 1.0 + _U;
+    const double d = 1.0 + _D;
+    const double ud = u / d;
+    const int B = _blockLevels;
+
+    // Probabilité et actualisation du pas L -> L+1
+    std::vector<double> stepQ(N), stepDisc(N);
+    for (int L = 0; L < N; ++L) {
+        const double R = timeDependent ? _stepR[L] : _R;
+        stepQ[L] = timeDependent ? (R - _D) / (_U - _D) : _q;
+        stepDisc[L] = 1.0 / (1.0 + R);
+    }
+
+    /*Largeur des tuiles réduite si la ligne est courte (64 tuiles, pour occuper les threads), sans descendre sous
+      4 B : le travail redondant d'une tuile (triangle de B^2 / 2 noeuds) reste inférieur à 1/8 de son travail
+      utile. Elle ne dépend que de la ligne : le découpage, donc le résultat, ne dépend pas du nombre de threads.*/
+    const int nbThreads = std::max(1, std::min(_nbThreads, N / 2 + 1));
+    auto tileWidth = [&](int rowSize) {
+        return std::max(std::min(4 * B, _tileWidth), std::min(_tileWidth, rowSize / 64));
+    };
+
+    std::vector<double> rows[2] = { std::vector<double>(N + 1), std::vector<double>(N + 1) };
+    ThreadBarrier barrier(nbThreads);
+
+    // Une exception (payoff) interrompt le travail, mais tous les threads continuent d'atteindre les barrières
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+    std::atomic<bool> aborted(false);
+    auto guarded = [&](auto&& work) {
+        if (aborted.load(std::memory_order_relaxed)) return;
+        try {
+            work();
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failure) failure = std::current_exception();
+            aborted.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    auto worker = [&](int id) {
+        std::vector<double> local(static_cast<std::size_t>(_tileWidth) + B + 1);
+
+        // Payoff à maturité
+        guarded([&] {
+            const int W = tileWidth(N + 1);
+            for (int a = id * W; a <= N; a += nbThreads * W) {
+                const int b = std::min(a + W, N + 1);
+                double S = S0 * std::pow(d, N - a) * std::pow(u, a);
+                for (int i = a; i < b; ++i) {
+                    rows[0][i] = _option->payoff(S);
+                    S *= ud;
+                }
+            }
+        });
+        barrier.wait();
+
+        int current = 0;
+        for (int n = N; n > 0; n -= B) {
+            const int m = std::max(n - B, 0);
+            const int steps = n - m;
+            const std::vector<double>& cur = rows[current];
+            std::vector<double>& next = rows[1 - current];
+
+            guarded([&] {
+                const int W = tileWidth(m + 1);
+                for (int a = id * W; a <= m; a += nbThreads * W) {
+                    const int b = std::min(a + W, m + 1);
+                    const int width = b - a + steps;
+                    std::copy(cur.begin() + a, cur.begin() + a + width, local.begin());
+
+                    for (int s = 1; s <= steps; ++s) {
+                        const int L = n - s;
+                        const double q = stepQ[L];
+                        const double p = 1.0 - q;
+                        const double disc = stepDisc[L];
+                        const int count = width - s;
+                        if (isAmerican) {
+                            double S = S0 * std::pow(d, L - a) * std::pow(u, a);
+                            for (int i = 0; i < count; ++i) {
+                                const double continuation = (q * local[i + 1] + p * local[i]) * disc;
+                                const double intrinsic = _option->payoff(S);
+                                local[i] = intrinsic >= continuation ? intrinsic : continuation;
+                                S *= ud;
+                            }
+                        }
+                        else {
+                            for (int i = 0; i < count; ++i) {
+                                local[i] = (q * local[i + 1] + p * local[i]) * disc;
+                            }
+                        }
+                    }
+                    std::copy(local.begin(), local.begin() + (b - a), next.begin() + a);
+                }
+            });
+            barrier.wait();
+            current = 1 - current;
+
+            // Point de contrôle une fois par bloc : une annulation interrompt tous les threads comme une exception
+            if (id == 0) guarded([&] { reportLevels(N - m); });
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < nbThreads; ++t) threads.emplace_back(worker, t);
+    worker(0);
+    for (std::thread& thread : threads) thread.join();
+    if (failure) std::rethrow_exception(failure);
+
+    TELEMETRY_COUNT(NodesVisited, (static_cast<long long>(N) + 1) * (N + 2) / 2);
+    // Nombre de blocs pair ou impair : la ligne 0 est dans rows[0] ou rows[1]
+    const int nbBlocks = (N + B - 1) / B;
+    return rows[nbBlocks % 2][0];
+}
+
+/*Deux lignes glissantes, la vanille et la knock-out, sont induites ensemble ; la ligne stockée dans l'arbre de
+  prix est la knock-out, ou la knock-in obtenue par parité. rebate[n] est le rebate versé à maturité, actualisé
+  au niveau n.*/
+void CRRPricer::computeBarrier() {
+    const BarrierOption* barrier = static_cast<const BarrierOption*>(_option);
+    const int N = _depth;
+    const bool timeDependent = !_stepR.empty();
+    const bool knockIn = barrier->isKnockIn();
+
+    // Niveaux surveillés : tous en continu, sinon le plus proche de chaque date (pas de durée constante)
+    std::vector<char> monitored(N + 1, barrier->isContinuouslyMonitored() ? 1 : 0);
+    if (!barrier->isContinuouslyMonitored()) {
+        if (timeDependent) {
+            throw std::invalid_argument("Discretely monitored barriers require a lattice with constant steps.");
+        }
+        const double T = _option->getExpiry();
+        for (const double t : barrier->getMonitoringDates()) {
+            monitored[static_cast<std::size_t>(std::lround(t / T * N))] = 1;
+        }
+    }
+
+    std::vector<double> rebate(N + 1);
+    rebate[N] = barrier->getRebate();
+    for (int n = N - 1; n >= 0; --n) {
+        rebate[n] = rebate[n + 1] / (1.0 + (timeDependent ? _stepR[n] : _R));
+    }
+
+    _priceTree.setDepth(N);
+    _exerciseTree.setDepth(N);
+
+    // Payoff à maturité
+    std::vector<double> vanilla(N + 1), knockOut(N + 1);
+    for (int i = 0; i <= N; ++i) {
+        const double ST = _lattice->getNode(N, i);
+        vanilla[i] = _option->payoff(ST);
+        knockOut[i] = monitored[N] && barrier->isBreached(ST) ? rebate[N] : vanilla[i];
+        _priceTree.setNode(N, i, knockIn ? vanilla[i] + rebate[N] - knockOut[i] : knockOut[i]);
+        _exerciseTree.setNode(N, i, false);
+    }
+
+    // Backward induction
+    for (int n = N - 1; n >= 0; --n) {
+        const double R = timeDependent ? _stepR[n] : _R;
+        const double q = timeDependent ? (R - _D) / (_U - _D) : _q;
+        const double disc = 1.0 / (1.0 + R);
+
+        for (int i = 0; i <= n; ++i) {
+            vanilla[i] = (q * vanilla[i + 1] + (1.0 - q) * vanilla[i]) * disc;
+            knockOut[i] = (q * knockOut[i + 1] + (1.0 - q) * knockOut[i]) * disc;
+            if (monitored[n] && barrier->isBreached(_lattice->getNode(n, i))) {
+                knockOut[i] = rebate[n];
+            }
+            _priceTree.setNode(n, i, knockIn ? vanilla[i] + rebate[n] - knockOut[i] : knockOut[i]);
+            _exerciseTree.setNode(n, i, false);
+        }
+        reportLevels(N - n);
+    }
+
+    TELEMETRY_COUNT(NodesVisited, (static_cast<long long>(N) + 1) * (N + 2) / 2);
+}
+
+/*Même induction que compute() sur des adouble, sur une seule ligne glissante (aucun arbre stocké).
+  Pour un pricer issu de (r, sigma), U, D et R sont enregistrés comme fonctions de r et sigma, ce qui donne
+  rho et vega par la même propagation que delta.*/
+Greeks CRRPricer::greeks() const {
+    if (_option->isBarrierOption()) {
+        throw std::invalid_argument("Lattice AAD sensitivities are not available for barrier options.");
+    }
+
+    TELEMETRY_SCOPE(CRRCompute);
+
+    AADTape& tape = AADTape::threadLocal();
+    tape.clear();
+    AADTape::Scope scope(tape);
+
+    const int N = _depth;
+    const bool isAmerican = _option->isAmericanOption();
+    const bool fromBlackScholes = !std::isnan(_volatility);
+    const Option* option = _option;
+    auto payoff = [option](double S) { return option->payoff(S); };
+
+    const adouble S0 = adouble::input(_lattice->getS0());
+    adouble r, sigma, U(_U), D(_D), R(_R);
+    if (fromBlackScholes) {
+        r = adouble::input(_rate);
+        sigma = adouble::input(_volatility);
+        const double dt = _option->getExpiry() / N;
+        U = exp(sigma * std::sqrt(dt)) - 1.0;
+        D = exp(-sigma * std::sqrt(dt)) - 1.0;
+        R = exp(r * dt) - 1.0;
+    }
+    const adouble up = 1.0 + U;
+    const adouble down = 1.0 + D;
+    const adouble ratio = up / down;
+
+    // Payoff à maturité : S(N,i) = S0 (1+D)^N ((1+U)/(1+D))^i
+    std::vector<adouble> values(N + 1);
+    adouble S = S0 * pow(down, N);
+    for (int i = 0; i <= N; ++i) {
+        values[i] = adouble::blackBox(payoff, S);
+        S = S * ratio;
+    }
+
+    // Backward induction
+    for (int n = N - 1; n >= 0; --n) {
+        const adouble Rn = _stepR.empty() ? R : adouble(_stepR[n]);
+        const adouble q = (Rn - D) / (U - D);
+        const adouble p = 1.0 - q;
+        const adouble disc = 1.0 / (1.0 + Rn);
+
+        S = S0 * pow(down, n);
+        for (int i = 0; i <= n; ++i) {
+            const adouble continuation = (q * values[i + 1] + p * values[i]) * disc;
+            values[i] = continuation;
+            if (isAmerican) {
+                const adouble intrinsic = adouble::blackBox(payoff, S);
+                if (intrinsic >= continuation) values[i] = intrinsic;
+                S = S * ratio;
+            }
+        }
+    }
+
+    Greeks result;
+    result.price = values[0].value();
+    result.rho = result.vega = fromBlackScholes ? 0.0 : std::numeric_limits<double>::quiet_NaN();
+    if (!values[0].isConstant()) {
+        tape.propagate(values[0].index());
+        result.delta = S0.adjoint();
+        if (fromBlackScholes) {
+            result.rho = r.adjoint();
+            result.vega = sigma.adjoint();
+        }
+    }
+    TELEMETRY_COUNT(NodesVisited, (static_cast<long long>(N) + 1) * (N + 2) / 2);
+    return result;
+}
+
 // Accès a la valeur au noeud (n,i)
 double CRRPricer::get(int n, int i) const {
+    if (!_computed) {
+        if (n < 0 || n > _depth || i < 0 || i > n) {
+            throw std::out_of_range("Invalid node indices");
+        }
+        return 0.0;
+    }
+    if (isPruned()) {
+        if (n < 0 || n > _depth || i < 0 || i > n) {
+            throw std::out_of_range("Invalid node indices");
+        }
+        if (i < _bandLow[n] || i > _bandHigh[n]) {
+            const double S = _lattice->getS0() * std::pow(1.0 + _D, n - i) * std::pow(1.0 + _U, i);
+            return boundaryValue(n, S);
+        }
+        return _bandValues[_bandOffset[n] + (i - _bandLow[n])];
+    }
+    if (_singleTree) {
+        return _singlePriceTree.getNode(n, i);
+    }
     return _priceTree.getNode(n, i);
 }
 
+// Décision d'exercice au noeud (n,i)
+bool CRRPricer::getExercise(int n, int i) const {
+    if (!_computed) {
+        if (n < 0 || n > _depth || i < 0 || i > n) {
+            throw std::out_of_range("Invalid node indices");
+        }
+        return false;
+    }
+    if (isPruned()) {
+        if (n < 0 || n > _depth || i < 0 || i > n) {
+            throw std::out_of_range("Invalid node indices");
+        }
+        // Hors de la bande : exercice si la valeur de bord est l'exercice immédiat
+        if (i < _bandLow[n] || i > _bandHigh[n]) {
+            if (!_option->isAmericanOption()) return false;
+            const double S = _lattice->getS0() * std::pow(1.0 + _D, n - i) * std::pow(1.0 + _U, i);
+            const double intrinsic = _option->payoff(S);
+            return intrinsic > 0.0 && intrinsic >= boundaryValue(n, S);
+        }
+        return _bandExercise[_bandOffset[n] + (i - _bandLow[n])];
+    }
+    return _exerciseTree.getNode(n, i);
+}
+
 // Prix final de l'option
 //  - closed_form = true : formule binomiale fermer (EUROPEEN uniquement)
 //  - sinon : valeur issue de l'arbre
@@ -157,12 +871,26 @@ double CRRPricer::operator()(bool closed_form) {
         throw std::invalid_argument("Closed-form CRR formula is not available for American options.");
     }
 
+    // La formule fermée ne voit que la dernière ligne : la barrière n'y est pas observable
+    if (closed_form && _option->isBarrierOption()) {
+        throw std::invalid_argument("Closed-form CRR formula is not available for barrier options.");
+    }
+
+    // Avec une probabilité différente à chaque pas, la loi terminale n'est plus binomiale
+    if (closed_form && !_stepR.empty()) {
+        throw std::invalid_argument("Closed-form CRR formula requires constant rate and volatility.");
+    }
+
     //Formule fermer CRR(option européenne)
     if (closed_form) {
+        TELEMETRY_SCOPE(CRRClosedForm);
         double price = 0.0;
 
+        // Seule la dernière ligne de l'arbre est nécessaire
+        const std::vector<double> terminal = _lattice->level(N);
+
         for (int i = 0; i <= N; ++i) {
-            const double ST = _stockTree.getNode(N, i);
+            const double ST = terminal[i];
             const double h = _option->payoff(ST);
 
             // Binomial coefficient C(N,i) 
@@ -181,6 +909,9 @@ double CRRPricer::operator()(bool closed_form) {
     }
 
     //Pricing par arbre
+    if (_nbThreads > 0 && !_option->isBarrierOption()) {
+        return parallelInduction();
+    }
     compute();
-    return _priceTree.getNode(0, 0);
+    return get(0, 0);
 }
@@ -1,47 +1,188 @@
 #pragma once
 #include "BinaryTree.h"
+#include "Greeks.h"
 #include "Option.h"
+#include "Precision.h"
+#include "PricingControl.h"
+#include "StockLattice.h"
+#include "TermStructure.h"
 #include <cmath>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
 
-// Pricer binomial de Cox-Ross-Rubinstein (CRR).Permet de pricer des options europennes et amricaines  l'aide d'un arbre binomial de profondeur N.
+/*Pricer binomial de Cox-Ross-Rubinstein (CRR).Permet de pricer des options européennes et américaines à l'aide d'un arbre binomial de profondeur N.
+	L'arbre du sous-jacent (StockLattice) est construit à la demande et peut être partagé entre plusieurs pricers
+	(ex : toute une chaîne de strikes sur le même sous-jacent). Les arbres de prix et d'exercice ne sont alloués
+	que par compute() ; la formule fermée n'utilise que la dernière ligne de l'arbre.*/
 class CRRPricer {
 private:
-	Option* _option;	// Option  pricer
+	Option* _option;	// Option à pricer
 	int _depth;			 // Profondeur de l'arbre binomial
-	double _S0;			// Prix initial du sous-jacent
-	double _U, _D, _R;	//Paramtres du modle (hausse,baisse,actualisation)
-	double _q;			//Probabilit neutre du risque
+	double _U, _D, _R;	//Paramètres du modèle (hausse,baisse,actualisation)
+	double _q;			//Probabilité neutre du risque
+	std::vector<double> _stepR;	// rendement sans risque de chaque pas (paramètres dépendant du temps ; vide sinon)
+	double _rate, _volatility;	// paramètres Black-Scholes (r, sigma) si le pricer en est issu, NaN sinon
 
-	BinaryTree<double> _stockTree;	// Valeurs du sous-jacent
+	std::shared_ptr<const StockLattice> _lattice;	// Valeurs du sous-jacent (éventuellement partagées)
 	BinaryTree<double> _priceTree;	 // Valeurs de l'option
-	BinaryTree<bool> _exerciseTree;	// Dcisions d'exercice (options amricaines)
+	BinaryTree<bool> _exerciseTree;	// Décisions d'exercice (options américaines)
+	BinaryTree<float> _singlePriceTree;	// Valeurs de l'option en simple précision (voir setPrecision())
 
-	bool _computed;	// Indique si l'arbre a dj t construit
+	bool _computed;	// Indique si l'arbre a déjà été construit
+	computePrecision _precision;	// précision de l'arbre de prix de compute()
+	bool _singleTree;	// vrai si compute() a rempli _singlePriceTree
+
+	int _nbThreads;		// threads de l'induction parallèle (0 : mode désactivé, compute())
+	int _tileWidth;		// noeuds produits par tuile
+	int _blockLevels;	// niveaux avancés par tuile entre deux synchronisations
+
+	double _pruneWidth;		// demi-largeur de la bande en écarts-types (0 : arbre complet)
+	std::vector<int> _bandLow, _bandHigh;	// premier et dernier noeud actif de chaque niveau
+	std::vector<std::size_t> _bandOffset;	// position du niveau n dans _bandValues
+	std::vector<double> _bandValues;		// valeurs des noeuds actifs (niveaux concaténés)
+	std::vector<bool> _bandExercise;		// décisions d'exercice des noeuds actifs
+	std::vector<double> _growth;			// capitalisation prod (1 + R_m), m = n..N-1, du niveau n à maturité
+
+	PricingControl* _control;	// annulation et progression de l'induction (nullptr : aucun contrôle)
+
+	// Vérifications communes à tous les constructeurs
+	void validate();
+
+	/*Profondeur alignée sur la barrière (Boyle-Lau) : plus petite profondeur N >= depth
+	  de la forme floor(j^2 sigma^2 T / ln(B/S0)^2), pour laquelle la j-ième couche de noeuds se trouve juste
+	  au-delà de la barrière (à mi-chemin entre deux couches en surveillance discrète). Renvoie depth pour toute
+	  autre option.*/
+	static int alignedDepth(const Option* option, int depth, double asset_price, double volatility);
+
+	// Profondeur déjà ajustée par alignedDepth() (constructeur Black-Scholes)
+	struct AlignedDepth { int value; };
+	CRRPricer(Option* option, AlignedDepth depth, double asset_price, double r, double volatility,
+		std::pmr::memory_resource* resource);
+
+	// Induction rétrograde d'une option à barrière (appelée par compute())
+	void computeBarrier();
+
+	// Induction rétrograde restreinte à la bande de +/- _pruneWidth écarts-types (appelée par compute())
+	void computePruned();
+
+	// Induction rétrograde sur l'arbre de prix en simple précision (appelée par compute())
+	void computeSingle();
+
+	// Valeur de bord d'un noeud hors de la bande au niveau n, de sous-jacent S
+	double boundaryValue(int n, double S) const;
+
+	// Indique si compute() a utilisé l'arbre tronqué
+	bool isPruned() const { return !_bandOffset.empty(); }
+
+	// Induction rétrograde parallèle par tuiles sur deux lignes glissantes (voir setParallel())
+	double parallelInduction() const;
+
+	// Point de contrôle après levels_done niveaux de l'induction (sans effet sans contrôle attaché)
+	void reportLevels(int levels_done) const {
+		if (_control) _control->report({ levels_done, _depth });
+	}
 
 
 public:
-	// Constructeur CRR avec paramtres explicites (U, D, R).
+	// Constructeur CRR avec paramètres explicites (U, D, R).
 
-	CRRPricer(Option* option, int depth, double asset_price, double up, double down, double interest_rate);
-	// Constructeur CRR  partir des paramtres Black-Scholes (r, sigma).Les paramtres U, D, R sont calculs  partir de ces valeurs.
+	// Le dernier paramètre (optionnel) est la ressource mémoire des arbres, par exemple une PricingArena.
+	CRRPricer(Option* option, int depth, double asset_price, double up, double down, double interest_rate,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+	/*Constructeur CRR à partir des paramètres Black-Scholes (r, sigma).Les paramètres U, D, R sont calculés à partir de ces valeurs.
+	  Pour une option à barrière, la profondeur est augmentée jusqu'à la première profondeur
+	  alignée sur la barrière (voir getDepth()) : sans cela, le prix oscille fortement avec N.*/
 	CRRPricer(Option* option,
 		int depth,
 		double asset_price,
 		double r,
-		double volatility);
+		double volatility,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
-	// Construit l'arbre binomial et calcule les valeurs de l'option.
+	// Constructeur à partir d'un arbre du sous-jacent partagé. interest_rate est le rendement sans risque par pas (R).
+	CRRPricer(Option* option, std::shared_ptr<const StockLattice> lattice, double interest_rate,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	/*Constructeur à partir de courbes de taux et de volatilité constantes par morceaux. Les dates des pas sont
+	  choisies pour que chaque pas porte la même variance intégrée : U et D sont constants et l'arbre reste
+	  recombinant ; seul le rendement sans risque R (donc q) change d'un pas à l'autre, une fois par niveau
+	  de l'induction rétrograde. La formule fermée n'est disponible que si les deux courbes sont constantes.*/
+	CRRPricer(Option* option,
+		int depth,
+		double asset_price,
+		const TermStructure& rate,
+		const TermStructure& volatility,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	// Profondeur effective de l'arbre
+	int getDepth() const { return _depth; }
+
+	// Arbre du sous-jacent utilisé, pour le partager avec d'autres pricers
+	std::shared_ptr<const StockLattice> getLattice() const { return _lattice; }
+
+	/*Construit l'arbre binomial et calcule les valeurs de l'option.
+	  Option à barrière : aux niveaux surveillés (tous en continu, les plus proches des dates de surveillance
+	  sinon), un noeud au-delà de la barrière vaut le rebate actualisé pour une option knock-out. Une option
+	  knock-in est valorisée par parité in/out : vanille + rebate actualisé - knock-out.*/
 	void compute();
 
 	// Retourne la valeur de l'option au noeud (n,i).
 	double get(int n, int i) const;
 
-	// Indique si l'exercice est optimal au noeud (n,i)
-	bool getExercise(int n, int i) const {
-		return _exerciseTree.getNode(n, i);
-	}
+	// Indique si l'exercice est optimal au noeud (n,i) (faux tant que compute() n'a pas été appelé)
+	bool getExercise(int n, int i) const;
+
+	/*Prix et sensibilités par différentiation adjointe de l'induction rétrograde (mêmes décisions d'exercice
+	  que compute()). delta est toujours disponible ; rho et vega seulement pour un pricer construit à partir
+	  de (r, sigma), NaN sinon.*/
+	Greeks greeks() const;
+
+	/*Mode parallèle pour les arbres très profonds (N de l'ordre de 10^5) : operator()() n'appelle plus compute()
+	  mais une induction rétrograde sur deux lignes glissantes, sans stocker les arbres (get() et getExercise()
+	  restent ceux de compute()). Chaque bloc de block_levels niveaux est découpé en tuiles de tile_width noeuds
+	  de sortie, réparties entre nb_threads threads : une tuile copie les tile_width + block_levels noeuds dont
+	  elle dépend, avance localement de block_levels niveaux (trapèze, en cache) puis écrit sa sortie. Les threads
+	  ne se synchronisent qu'une fois par bloc. Les prix ne diffèrent de compute() que par l'arrondi des valeurs
+	  du sous-jacent (calculées par tuile). nb_threads = 0 : nombre de coeurs. Même avec un seul thread, le
+	  parcours par tuiles est plus rapide que compute() et sa mémoire est en O(N) au lieu de O(N^2).
+	  Les options à barrière restent valorisées par compute().*/
+	void setParallel(int nb_threads, int tile_width = 4096, int block_levels = 64);
+	bool isParallel() const { return _nbThreads > 0; }
+	int getTileWidth() const { return _tileWidth; }
+	int getBlockLevels() const { return _blockLevels; }
+
+	/*Arbre tronqué : compute() ne visite au niveau n que les noeuds i tels que |i - c_n| <= k sqrt(v_n), où c_n
+	  et v_n sont la moyenne et la variance du nombre de hausses sous la probabilité risque neutre (k = nb_std_devs).
+	  Hors de la bande, la valeur est celle du bord : disc^(N-n) payoff(F), F forward du noeud à maturité,
+	  et max(payoff(S), disc^(N-n) payoff(F)) pour une option américaine. Le travail et la mémoire passent de
+	  O(N^2) à O(k N^1.5), et l'arbre du sous-jacent n'est pas construit (valeurs calculées par bande).
+	  Borne d'erreur (Hoeffding) : la probabilité qu'un chemin issu de (0,0) sorte de la bande avant maturité est
+	  au plus 2 N exp(-2 k^2 q(1-q)), soit 2 N exp(-k^2/2) pour q proche de 1/2 ; l'écart au prix non tronqué est
+	  borné par cette probabilité fois l'écart maximal entre la valeur exacte et la valeur de bord, lui-même
+	  inférieur au strike pour un call ou un put. Avec k = 8 et N = 10^4, la borne vaut 3e-10 K ; l'écart observé
+	  est de l'ordre de l'arrondi (valeurs du sous-jacent calculées par bande et non lues dans StockLattice).
+	  nb_std_devs = 0 : arbre complet (défaut). Sans effet pour les options à barrière et en mode parallèle.*/
+	void setPruning(double nb_std_devs);
+	double getPruning() const { return _pruneWidth; }
+
+	/*Simple précision : l'arbre de prix de compute() est en float (mémoire divisée par deux) ; les valeurs du
+	  sous-jacent, les probabilités et les facteurs d'actualisation restent en double, et l'arbre du sous-jacent
+	  n'est pas construit. L'écart relatif au calcul en double est de l'ordre de 1e-7 à 1e-6 (arrondi float de
+	  chaque noeud, qui ne s'accumule pas : l'espérance actualisée est une moyenne). Sans effet pour les options
+	  à barrière, l'arbre tronqué et le mode parallèle, calculés en double. Les arbres déjà calculés sont abandonnés.*/
+	void setPrecision(computePrecision precision);
+	computePrecision getPrecision() const { return _precision; }
+
+	/*Calcule le prix par compute() en double puis en simple précision (sur deux copies du pricer) et compare les
+	  résultats. L'arbre du sous-jacent est construit avant les mesures : les durées ne portent que sur l'induction.*/
+	PrecisionReport comparePrecision() const;
+
+	/*Contrôle d'annulation et de progression (voir PricingControl), consulté à chaque niveau de l'induction
+	  rétrograde (à chaque bloc de niveaux en mode parallèle) ; progression en niveaux sur getDepth().
+	  Une induction annulée lève PricingCancelled et laisse le pricer non calculé. nullptr : aucun contrôle.*/
+	void setControl(PricingControl* control) { _control = control; }
 
-	// Retourne le prix de l'option  l'origine.Si closed_form = true, utilise la formule ferme CRR (uniquement disponible pour les options europennes).
+	// Retourne le prix de l'option à l'origine.Si closed_form = true, utilise la formule fermée CRR (uniquement disponible pour les options européennes).
 	double operator()(bool closed_form = false);
 };
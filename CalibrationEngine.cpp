@@ -0,0 +1,59 @@
+#include "CalibrationEngine.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+CalibrationEngine::CalibrationEngine(std::shared_ptr<const Calibrator> calibrator, int nb_threads)
+    : _calibrator(std::move(calibrator)), _nbThreads(nb_threads)
+{
+    if (!_calibrator) {
+        throw std::invalid_argument("Null calibrator.");
+    }
+    if (_nbThreads < 0) {
+        throw std::invalid_argument("Number of threads must be non-negative.");
+    }
+    if (_nbThreads == 0) {
+        _nbThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+std::map<int, CalibrationResult> CalibrationEngine::calibrate(const std::map<int, CalibrationProblem>& problems) {
+    // Tâches dans l'ordre des identifiants, chacune avec son point de départ (lu avant le lancement des threads)
+    std::vector<int> ids;
+    std::vector<const CalibrationProblem*> tasks;
+    std::vector<std::vector<double>> starts;
+    std::vector<char> warm;
+    for (const auto& entry : problems) {
+        ids.push_back(entry.first);
+        tasks.push_back(&entry.second);
+
+        std::vector<double> start = _calibrator->initialGuess(entry.second);
+        const auto previous = _previous.find(entry.first);
+        const bool usePrevious = previous != _previous.end() && previous->second.size() == start.size();
+        if (usePrevious) start = previous->second;
+        starts.push_back(std::move(start));
+        warm.push_back(usePrevious);
+    }
+
+    const int nbTasks = static_cast<int>(tasks.size());
+    std::vector<CalibrationResult> results(nbTasks);
+    parallelFor(nbTasks, _nbThreads, [&](int t) {
+        results[t] = _calibrator->calibrate(*tasks[t], starts[t]);
+        results[t].warmStarted = warm[t] != 0;
+    });
+
+    std::map<int, CalibrationResult> output;
+    for (int t = 0; t < nbTasks; ++t) {
+        // Une calibration non convergée ne remplace pas le dernier point de départ valide
+        if (results[t].converged) _previous[ids[t]] = results[t].parameters;
+        output.emplace(ids[t], std::move(results[t]));
+    }
+    return output;
+}
+
+std::vector<double> CalibrationEngine::previousParameters(int underlying) const {
+    const auto it = _previous.find(underlying);
+    return it == _previous.end() ? std::vector<double>() : it->second;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "Calibrator.h"
+#include <map>
+#include <memory>
+
+/*Calibration de plusieurs sous-jacents en parallèle, avec démarrage à chaud.
+	Les sous-jacents sont identifiés par un entier (ex : underlyingId du format OptionBook). Chaque calibration
+	part des derniers paramètres convergés pour ce sous-jacent (s'ils ont la bonne taille), sinon de
+	Calibrator::initialGuess(). Une calibration qui n'a pas convergé ne modifie pas les paramètres mémorisés. Le calcul de chaque sous-jacent est indépendant des autres et du découpage entre
+	threads : les résultats sont identiques quel que soit nb_threads.*/
+class CalibrationEngine {
+private:
+	std::shared_ptr<const Calibrator> _calibrator;
+	int _nbThreads;
+	std::map<int, std::vector<double>> _previous;	// dernière calibration de chaque sous-jacent
+
+public:
+	// nb_threads = 0 : nombre de coeurs disponibles
+	explicit CalibrationEngine(std::shared_ptr<const Calibrator> calibrator, int nb_threads = 0);
+
+	// Calibre chaque sous-jacent et mémorise les paramètres convergés pour le prochain appel
+	std::map<int, CalibrationResult> calibrate(const std::map<int, CalibrationProblem>& problems);
+
+	// Paramètres mémorisés d'un sous-jacent (vide si jamais calibré)
+	std::vector<double> previousParameters(int underlying) const;
+
+	// Oublie les calibrations précédentes (prochain départ depuis initialGuess())
+	void reset() { _previous.clear(); }
+};
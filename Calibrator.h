@@ -0,0 +1,45 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Cotation de marché d'une option européenne
+struct OptionQuote {
+	double strike;
+	double expiry;
+	double price;		// prix de marché
+	bool isCall = true;
+	double weight = 1.0;	// poids du résidu (ex : inverse du spread bid-ask)
+};
+
+// Données de calibration d'un sous-jacent
+struct CalibrationProblem {
+	double spot;
+	double rate;
+	std::vector<OptionQuote> quotes;
+};
+
+// Résultat d'une calibration
+struct CalibrationResult {
+	std::vector<double> parameters;	// paramètres du modèle (ordre propre à chaque calibrateur)
+	double rmse = 0.0;		// erreur quadratique moyenne pondérée sur les prix
+	int iterations = 0;
+	bool converged = false;
+	bool warmStarted = false;	// départ depuis la calibration précédente
+};
+
+/*Interface des calibrateurs : ajustement des paramètres d'un modèle aux prix de marché d'un sous-jacent.
+	calibrate() doit être une fonction pure de ses arguments (aucun état modifié) : CalibrationEngine l'appelle
+	en parallèle pour plusieurs sous-jacents.*/
+class Calibrator {
+public:
+	// Nom des paramètres, dans l'ordre de CalibrationResult::parameters
+	virtual std::vector<std::string> parameterNames(const CalibrationProblem& problem) const = 0;
+
+	// Point de départ par défaut (sans calibration précédente)
+	virtual std::vector<double> initialGuess(const CalibrationProblem& problem) const = 0;
+
+	// Calibre à partir de initial (de la taille de initialGuess(problem))
+	virtual CalibrationResult calibrate(const CalibrationProblem& problem, const std::vector<double>& initial) const = 0;
+
+	virtual ~Calibrator() = default;
+};
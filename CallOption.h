@@ -2,15 +2,15 @@
 #include "EuropeanVanillaOption.h"
 #include <algorithm>
 
-// Option europenne vanille de type Call.
+// Option européenne vanille de type Call.
 class CallOption : public EuropeanVanillaOption {
 public:
 
-	// Constructeur : maturit et strike transmis  la classe mre.
+	// Constructeur : maturité et strike transmis à la classe mère.
 	CallOption(double expiry, double strike)
 		: EuropeanVanillaOption(expiry, strike) {}
 
-	// Payoff du Call europen : h(S) = max(S - K, 0).
+	// Payoff du Call européen : h(S) = max(S - K, 0).
 	double payoff(double spot) const override {
 		return std::max(spot - getStrike(), 0.0);
 	}
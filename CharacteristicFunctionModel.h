@@ -0,0 +1,13 @@
+#pragma once
+#include <complex>
+
+/*Interface des modèles définis par leur fonction caractéristique, utilisée par le pricer de Fourier (FourierPricer).
+	La fonction caractéristique est celle de X_T = ln(S_T / S_0) - r T, E[exp(i u X_T)] : elle ne dépend ni du
+	spot ni du taux, ce qui permet de réutiliser les tables pré-calculées pour une même maturité.
+	Elle doit être définie pour u complexe dans la bande de régularité utilisée (Im(u) = -(alpha + 1)).*/
+class CharacteristicFunctionModel {
+public:
+	virtual std::complex<double> characteristicFunction(std::complex<double> u, double expiry) const = 0;
+
+	virtual ~CharacteristicFunctionModel() = default;
+};
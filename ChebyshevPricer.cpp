@@ -0,0 +1,290 @@
+#include "ChebyshevPricer.h"
+#include "CRRPricer.h"
+#include "ParallelFor.h"
+#include "ScriptedOption.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    const int MAX_NODES = 64;	// noeuds par dimension (tableaux de l'évaluation sur la pile)
+    const double PI = 3.14159265358979323846;
+
+    // Noeud k de Chebyshev (première espèce) parmi n, ramené sur [a, b]
+    double chebyshevNode(int k, int n, double a, double b) {
+        return a + 0.5 * (b - a) * (1.0 + std::cos(PI * (k + 0.5) / n));
+    }
+
+    /*Polynômes T_j(t) et leurs dérivées T'_j(t), j < n, par récurrence :
+      T_{j+1} = 2 t T_j - T_{j-1} et T'_{j+1} = 2 T_j + 2 t T'_j - T'_{j-1}.*/
+    void chebyshevBasis(double t, int n, double* T, double* dT) {
+        T[0] = 1.0;
+        if (dT) dT[0] = 0.0;
+        if (n == 1) return;
+        T[1] = t;
+        if (dT) dT[1] = 1.0;
+        for (int j = 1; j + 1 < n; ++j) {
+            T[j + 1] = 2.0 * t * T[j] - T[j - 1];
+            if (dT) dT[j + 1] = 2.0 * T[j] + 2.0 * t * dT[j] - dT[j - 1];
+        }
+    }
+
+    // Abscisse ramenée sur [-1, 1] (bornée : un point du domaine ne sort pas de l'intervalle par arrondi)
+    double toUnit(double y, double a, double b) {
+        return std::min(1.0, std::max(-1.0, (2.0 * y - a - b) / (b - a)));
+    }
+
+    void validateDomain(const ChebyshevPricer::Domain& d) {
+        if (!(d.spotMin > 0.0 && d.spotMin < d.spotMax && d.volMin > 0.0 && d.volMin < d.volMax
+            && d.timeMin > 0.0 && d.timeMin < d.timeMax)) {
+            throw std::invalid_argument("Chebyshev domain bounds must be positive and increasing.");
+        }
+    }
+}
+
+ChebyshevPricer::ChebyshevPricer(Option* option,
+    double interest_rate,
+    const Domain& domain,
+    int spot_nodes,
+    int vol_nodes,
+    int time_nodes,
+    int depth,
+    int nb_threads,
+    int nb_checks)
+    : _option(option),
+    _rate(interest_rate),
+    _nbSpot(spot_nodes),
+    _nbVol(vol_nodes),
+    _nbTime(time_nodes),
+    _depth(depth),
+    _nbThreads(nb_threads),
+    _nbChecks(nb_checks)
+{
+    if (!_option) {
+        throw std::invalid_argument("Null option pointer.");
+    }
+    if (_option->isAsianOption() || _option->isBarrierOption() || _option->isLookbackOption() || _option->isMultiAssetOption()) {
+        throw std::invalid_argument("Chebyshev proxy supports European and American single-asset options only.");
+    }
+    if (_option->isScriptedOption() && !static_cast<const ScriptedOption*>(_option)->observesExpiryOnly()) {
+        throw std::invalid_argument("Chebyshev proxy supports scripted options observing the expiry only.");
+    }
+    for (const int n : { _nbSpot, _nbVol, _nbTime }) {
+        if (n <= 0 || n > MAX_NODES) {
+            throw std::invalid_argument("Number of Chebyshev nodes must be between 1 and 64.");
+        }
+    }
+    if (_depth <= 0) {
+        throw std::invalid_argument("Depth must be positive.");
+    }
+    if (_nbThreads < 0 || _nbChecks < 0) {
+        throw std::invalid_argument("Number of threads and checks must be non-negative.");
+    }
+    if (_nbThreads == 0) {
+        _nbThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    validateDomain(domain);
+
+    _patches.push_back(buildPatch(domain));
+}
+
+// Arbre CRR de durée tau (paramètres explicites : l'expiry de l'option n'intervient pas)
+double ChebyshevPricer::latticePrice(double S, double sigma, double tau) const {
+    auto price = [&](int N) {
+        const double dt = tau / N;
+        CRRPricer pricer(_option, N, S, std::exp(sigma * std::sqrt(dt)) - 1.0, std::exp(-sigma * std::sqrt(dt)) - 1.0,
+            std::exp(_rate * dt) - 1.0);
+        pricer.setPruning(8.0);
+        return pricer();
+    };
+    return 0.5 * (price(_depth) + price(_depth + 1));
+}
+
+/*Prix aux noeuds (i, j, k) puis transformée en cosinus le long de chaque dimension :
+  c_m = (2 / n) sum_k f(x_k) cos(pi m (k + 1/2) / n), c_0 divisé par deux. Les points de contrôle sont tirés par un
+  générateur local de graine fixe : le résultat ne dépend ni du nombre de threads ni de l'état de MT.*/
+ChebyshevPricer::Patch ChebyshevPricer::buildPatch(const Domain& domain) const {
+    const int nbNodes = _nbSpot * _nbVol * _nbTime;
+
+    std::vector<double> spots(_nbSpot), vols(_nbVol), times(_nbTime);
+    for (int i = 0; i < _nbSpot; ++i) spots[i] = chebyshevNode(i, _nbSpot, domain.spotMin, domain.spotMax);
+    for (int j = 0; j < _nbVol; ++j) vols[j] = chebyshevNode(j, _nbVol, domain.volMin, domain.volMax);
+    for (int k = 0; k < _nbTime; ++k) times[k] = chebyshevNode(k, _nbTime, domain.timeMin, domain.timeMax);
+
+    std::mt19937 generator(20240501u);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<double> checks(3 * static_cast<std::size_t>(_nbChecks));
+    for (int c = 0; c < _nbChecks; ++c) {
+        checks[3 * c] = domain.spotMin + (domain.spotMax - domain.spotMin) * unit(generator);
+        checks[3 * c + 1] = domain.volMin + (domain.volMax - domain.volMin) * unit(generator);
+        checks[3 * c + 2] = domain.timeMin + (domain.timeMax - domain.timeMin) * unit(generator);
+    }
+
+    // Prix des noeuds puis des points de contrôle, répartis entre les threads
+    const int nbTasks = nbNodes + _nbChecks;
+    std::vector<double> values(nbTasks);
+    parallelFor(nbTasks, _nbThreads, [&](int t) {
+        if (t < nbNodes) {
+            const int i = t / (_nbVol * _nbTime), j = (t / _nbTime) % _nbVol, k = t % _nbTime;
+            values[t] = latticePrice(spots[i], vols[j], times[k]);
+        }
+        else {
+            const std::size_t c = 3 * static_cast<std::size_t>(t - nbNodes);
+            values[t] = latticePrice(checks[c], checks[c + 1], checks[c + 2]);
+        }
+    });
+
+    // Transformée dans chaque dimension (stride : écart entre deux noeuds consécutifs de la dimension)
+    Patch patch{ domain, std::vector<double>(values.begin(), values.begin() + nbNodes), 0.0 };
+    auto transform = [&](int n, int stride) {
+        std::vector<double> line(n);
+        for (int start = 0; start < nbNodes; ++start) {
+            if ((start / stride) % n != 0) continue;	// premier noeud de chaque ligne de la dimension
+            for (int m = 0; m < n; ++m) {
+                double sum = 0.0;
+                for (int k = 0; k < n; ++k) {
+                    sum += patch.coefficients[start + k * stride] * std::cos(PI * m * (k + 0.5) / n);
+                }
+                line[m] = (m == 0 ? 1.0 : 2.0) * sum / n;
+            }
+            for (int m = 0; m < n; ++m) {
+                patch.coefficients[start + m * stride] = line[m];
+            }
+        }
+    };
+    transform(_nbTime, 1);
+    transform(_nbVol, _nbTime);
+    transform(_nbSpot, _nbVol * _nbTime);
+
+    for (int c = 0; c < _nbChecks; ++c) {
+        const double proxy = evaluate(patch, checks[3 * c], checks[3 * c + 1], checks[3 * c + 2]);
+        patch.maxError = std::max(patch.maxError, std::abs(proxy - values[nbNodes + c]));
+    }
+    return patch;
+}
+
+/*Contraction du tenseur dimension par dimension, en commençant par le spot : a_jk = sum_i T_i(x) c_ijk est une
+  combinaison de lignes contiguës de nbVol * nbTime coefficients, sans dépendance entre les éléments (boucle
+  vectorisée), puis V = sum_j T_j(y) sum_k T_k(z) a_jk. Les dérivées utilisent T' à la place de T dans la
+  dimension concernée.*/
+double ChebyshevPricer::evaluate(const Patch& patch, double S, double sigma, double tau, double* dS, double* dSigma) const {
+    const Domain& d = patch.domain;
+    double Ts[MAX_NODES], dTs[MAX_NODES], Tv[MAX_NODES], dTv[MAX_NODES], Tt[MAX_NODES];
+    const bool derivatives = dS || dSigma;
+    chebyshevBasis(toUnit(S, d.spotMin, d.spotMax), _nbSpot, Ts, derivatives ? dTs : nullptr);
+    chebyshevBasis(toUnit(sigma, d.volMin, d.volMax), _nbVol, Tv, derivatives ? dTv : nullptr);
+    chebyshevBasis(toUnit(tau, d.timeMin, d.timeMax), _nbTime, Tt, nullptr);
+
+    const int plane = _nbVol * _nbTime;
+    double a[MAX_NODES * MAX_NODES], aS[MAX_NODES * MAX_NODES];
+    const double* c = patch.coefficients.data();
+    for (int m = 0; m < plane; ++m) {
+        a[m] = Ts[0] * c[m];
+        if (derivatives) aS[m] = dTs[0] * c[m];
+    }
+    for (int i = 1; i < _nbSpot; ++i) {
+        const double* row = c + static_cast<std::size_t>(i) * plane;
+        const double t = Ts[i];
+        for (int m = 0; m < plane; ++m) {
+            a[m] += t * row[m];
+        }
+        if (derivatives) {
+            const double dt = dTs[i];
+            for (int m = 0; m < plane; ++m) {
+                aS[m] += dt * row[m];
+            }
+        }
+    }
+
+    double value = 0.0, valueS = 0.0, valueSigma = 0.0;
+    for (int j = 0; j < _nbVol; ++j) {
+        double inner = 0.0, innerS = 0.0;
+        for (int k = 0; k < _nbTime; ++k) {
+            inner += Tt[k] * a[j * _nbTime + k];
+            if (derivatives) innerS += Tt[k] * aS[j * _nbTime + k];
+        }
+        value += Tv[j] * inner;
+        if (derivatives) {
+            valueS += Tv[j] * innerS;
+            valueSigma += dTv[j] * inner;
+        }
+    }
+
+    // Dérivées ramenées aux variables d'origine
+    if (dS) *dS = valueS * 2.0 / (d.spotMax - d.spotMin);
+    if (dSigma) *dSigma = valueSigma * 2.0 / (d.volMax - d.volMin);
+    return value;
+}
+
+/*Le patch utilisé passe en tête de liste. Un point hors de tous les domaines donne un nouveau domaine de la taille
+  du plus récent, décalé dans chaque dimension dont le point sort pour y être centré (borne inférieure ramenée à la
+  moitié du point si elle devient négative).*/
+const ChebyshevPricer::Patch& ChebyshevPricer::patchFor(double S, double sigma, double tau) {
+    if (_patches.front().domain.contains(S, sigma, tau)) {
+        return _patches.front();
+    }
+    for (std::size_t p = 1; p < _patches.size(); ++p) {
+        if (_patches[p].domain.contains(S, sigma, tau)) {
+            std::rotate(_patches.begin(), _patches.begin() + p, _patches.begin() + p + 1);
+            return _patches.front();
+        }
+    }
+
+    if (!(S > 0.0 && sigma > 0.0 && tau > 0.0)) {
+        throw std::invalid_argument("Spot, volatility and time to expiry must be positive.");
+    }
+    Domain domain = _patches.front().domain;
+    auto recentre = [](double x, double& low, double& high) {
+        if (x >= low && x <= high) return;
+        const double width = high - low;
+        low = x - 0.5 * width;
+        if (low <= 0.0) low = 0.5 * x;
+        high = low + width;
+    };
+    recentre(S, domain.spotMin, domain.spotMax);
+    recentre(sigma, domain.volMin, domain.volMax);
+    recentre(tau, domain.timeMin, domain.timeMax);
+
+    _patches.insert(_patches.begin(), buildPatch(domain));
+    if (_patches.size() > MAX_PATCHES) {
+        _patches.pop_back();
+    }
+    return _patches.front();
+}
+
+double ChebyshevPricer::operator()(double asset_price, double volatility, double time_to_expiry) {
+    return evaluate(patchFor(asset_price, volatility, time_to_expiry), asset_price, volatility, time_to_expiry);
+}
+
+Greeks ChebyshevPricer::greeks(double asset_price, double volatility, double time_to_expiry) {
+    Greeks result;
+    result.price = evaluate(patchFor(asset_price, volatility, time_to_expiry), asset_price, volatility, time_to_expiry,
+        &result.delta, &result.vega);
+    result.rho = std::numeric_limits<double>::quiet_NaN();
+    return result;
+}
+
+bool ChebyshevPricer::covers(double asset_price, double volatility, double time_to_expiry) const {
+    for (const Patch& patch : _patches) {
+        if (patch.domain.contains(asset_price, volatility, time_to_expiry)) return true;
+    }
+    return false;
+}
+
+double ChebyshevPricer::getMaxError() const {
+    double error = 0.0;
+    for (const Patch& patch : _patches) {
+        error = std::max(error, patch.maxError);
+    }
+    return error;
+}
+
+const ChebyshevPricer::Domain& ChebyshevPricer::getDomain(std::size_t patch) const {
+    if (patch >= _patches.size()) {
+        throw std::out_of_range("Invalid patch index");
+    }
+    return _patches[patch].domain;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include "Greeks.h"
+#include "Option.h"
+#include <cstddef>
+#include <vector>
+
+/*Pricer proxy par interpolation de Chebyshev en (spot, volatilité, durée résiduelle), pour revaloriser très
+	souvent une même option (européenne ou américaine) quand le marché bouge.
+	Hors ligne, le prix est calculé par CRRPricer (arbre tronqué à 8 écarts-types, moyenne des profondeurs N et
+	N+1 pour amortir l'oscillation pair/impair) aux noeuds d'une grille de Chebyshev tensorielle, en parallèle ;
+	les coefficients du polynôme interpolant en sont déduits par transformée en cosinus dans chaque dimension.
+	Une requête ne coûte ensuite que l'évaluation du polynôme (un millier de multiplications-additions vectorisées,
+	quelques centaines de nanosecondes avec -O3 -march=native), delta et vega étant les dérivées exactes du polynôme.
+	L'erreur d'interpolation est mesurée à la construction sur des points de contrôle tirés dans le domaine
+	(écart maximal au prix de l'arbre, voir getMaxError()). Pour une option européenne, le prix est analytique et
+	l'erreur décroît exponentiellement avec le nombre de noeuds (jusqu'au bruit de l'arbre) ; pour une option
+	américaine, la frontière d'exercice rend le prix seulement C1 et la convergence devient algébrique (de l'ordre
+	de 1e-2 en absolu près de la frontière pour un put à +/- 20 % du strike avec 16 x 8 x 8 noeuds).
+	Un point hors de tous les domaines construits provoque la construction d'un nouveau domaine (patch) de même
+	taille que le domaine initial, recentré sur le point dans les dimensions qui en sortent ; les patchs déjà
+	construits restent utilisés (au plus MAX_PATCHES, le moins récemment utilisé étant abandonné).*/
+class ChebyshevPricer {
+public:
+	// Domaine d'interpolation (bornes strictement positives)
+	struct Domain {
+		double spotMin, spotMax;
+		double volMin, volMax;
+		double timeMin, timeMax;	// durée résiduelle jusqu'à maturité
+
+		bool contains(double S, double sigma, double tau) const {
+			return S >= spotMin && S <= spotMax && sigma >= volMin && sigma <= volMax && tau >= timeMin && tau <= timeMax;
+		}
+	};
+
+	static const std::size_t MAX_PATCHES = 16;
+
+private:
+	// Polynôme d'un domaine : coefficient (i, j, k) en i * (nbVol * nbTime) + j * nbTime + k
+	struct Patch {
+		Domain domain;
+		std::vector<double> coefficients;
+		double maxError;	// écart maximal aux points de contrôle
+	};
+
+	Option* _option;		// option valorisée (son expiry n'est pas utilisé : la durée résiduelle est une variable)
+	double _rate;			// taux sans risque
+	int _nbSpot, _nbVol, _nbTime;	// noeuds de Chebyshev par dimension
+	int _depth;				// profondeur des arbres
+	int _nbThreads;			// threads de construction
+	int _nbChecks;			// points de contrôle par patch
+	std::vector<Patch> _patches;	// du plus récemment utilisé au plus ancien
+
+	// Prix de l'arbre au point (S, sigma, tau)
+	double latticePrice(double S, double sigma, double tau) const;
+
+	// Construit le polynôme d'un domaine et mesure son erreur
+	Patch buildPatch(const Domain& domain) const;
+
+	// Patch contenant le point, construit si nécessaire
+	const Patch& patchFor(double S, double sigma, double tau);
+
+	// Valeur du polynôme et, si demandé, ses dérivées par rapport à S et sigma
+	double evaluate(const Patch& patch, double S, double sigma, double tau, double* dS = nullptr, double* dSigma = nullptr) const;
+
+public:
+	/*L'option doit être européenne (vanille ou digitale) ou américaine. Le domaine initial est construit
+	  immédiatement (spot_nodes x vol_nodes x time_nodes prix d'arbre de profondeur depth, plus nb_checks
+	  points de contrôle). nb_threads = 0 : nombre de coeurs disponibles.*/
+	ChebyshevPricer(Option* option,
+		double interest_rate,
+		const Domain& domain,
+		int spot_nodes = 16,
+		int vol_nodes = 8,
+		int time_nodes = 8,
+		int depth = 400,
+		int nb_threads = 0,
+		int nb_checks = 64);
+
+	// Prix au point (spot, volatilité, durée résiduelle) ; construit un patch si le point sort des domaines
+	double operator()(double asset_price, double volatility, double time_to_expiry);
+
+	// Prix, delta et vega du polynôme (rho : NaN, le taux n'est pas une variable du proxy)
+	Greeks greeks(double asset_price, double volatility, double time_to_expiry);
+
+	// Indique si le point est dans un domaine déjà construit
+	bool covers(double asset_price, double volatility, double time_to_expiry) const;
+
+	// Écart maximal entre le polynôme et l'arbre aux points de contrôle, sur tous les patchs
+	double getMaxError() const;
+
+	// Nombre de patchs construits et domaine de chacun (0 : le plus récemment utilisé)
+	std::size_t getNbPatches() const { return _patches.size(); }
+	const Domain& getDomain(std::size_t patch) const;
+};
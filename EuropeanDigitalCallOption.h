@@ -1,7 +1,7 @@
 #pragma once
 #include "EuropeanDigitalOption.h"
 
-// Option digitale europenne de type Call. Payoff : 1 si S >= K, 0 sinon
+// Option digitale européenne de type Call. Payoff : 1 si S >= K, 0 sinon
 class EuropeanDigitalCallOption : public EuropeanDigitalOption {
 public:
 	EuropeanDigitalCallOption(double expiry, double strike)
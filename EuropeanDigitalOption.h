@@ -2,7 +2,7 @@
 #include "Option.h"
 #include <stdexcept>
 
-// Option digitale europenne abstraite. Le payoff vaut 1 si la condition est satisfaite, 0 sinon. Cette classe sert de base aux options digitales Call et Put.
+// Option digitale européenne abstraite. Le payoff vaut 1 si la condition est satisfaite, 0 sinon. Cette classe sert de base aux options digitales Call et Put.
 class EuropeanDigitalOption : public Option {
 private:
 	double _strike;
@@ -10,7 +10,7 @@ public:
 	// Type de l'option digitale
 	enum optionType { Call, Put };
 
-	// Constructeur : initialise la maturit (via Option) et le strike de l'option digitale.
+	// Constructeur : initialise la maturité (via Option) et le strike de l'option digitale.
 	EuropeanDigitalOption(double expiry, double strike)
 		: Option(expiry), _strike(strike)
 	{
@@ -21,13 +21,13 @@ public:
 	// Destructeur virtuel pour permettre la destruction polymorphe
 		virtual ~EuropeanDigitalOption() = default;
 
-		// Accs en lecture au strike
+		// Accès en lecture au strike
 		double getStrike() const {
 			return _strike;
 		}
 		// Retourne le type de l'option (Call ou Put)
 		virtual optionType GetOptionType() const = 0;
 
-		// Payoff digital  maturit (implment dans les classes drives)
+		// Payoff digital à maturité (implémenté dans les classes dérivées)
 		virtual double payoff(double S) const override = 0;
 };
\ No newline at end of file
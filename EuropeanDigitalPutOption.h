@@ -1,7 +1,7 @@
 #pragma once
 #include "EuropeanDigitalOption.h"
 
-// Option digitale europenne de type Put. Payoff : 1 si S <= K, 0 sinon.
+// Option digitale européenne de type Put. Payoff : 1 si S <= K, 0 sinon.
 class EuropeanDigitalPutOption : public EuropeanDigitalOption {
 public:
 
@@ -1,7 +1,7 @@
 #include "EuropeanVanillaOption.h"
 #include <stdexcept>
 
-// Constructeur de l'option europenne vanille.Initialise la maturit via la classe Option et stocke le strike de l'option.
+// Constructeur de l'option européenne vanille.Initialise la maturité via la classe Option et stocke le strike de l'option.
 EuropeanVanillaOption::EuropeanVanillaOption(double expiry, double strike)
 	: Option(expiry), _strike(strike) 
 {
@@ -0,0 +1,134 @@
+#include "FourierPricer.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+    // FFT radix-2 itérative en place : a_u <- sum_j a_j exp(-2 i pi j u / n), n puissance de 2
+    void fft(std::vector<std::complex<double>>& a) {
+        const std::size_t n = a.size();
+
+        // Permutation par inversion des bits
+        for (std::size_t i = 1, j = 0; i < n; ++i) {
+            std::size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) std::swap(a[i], a[j]);
+        }
+
+        // Papillons
+        for (std::size_t len = 2; len <= n; len <<= 1) {
+            const double angle = -2.0 * M_PI / static_cast<double>(len);
+            const std::complex<double> wlen(std::cos(angle), std::sin(angle));
+            for (std::size_t i = 0; i < n; i += len) {
+                std::complex<double> w(1.0, 0.0);
+                for (std::size_t j = 0; j < len / 2; ++j) {
+                    const std::complex<double> u = a[i + j];
+                    const std::complex<double> v = a[i + j + len / 2] * w;
+                    a[i + j] = u + v;
+                    a[i + j + len / 2] = u - v;
+                    w *= wlen;
+                }
+            }
+        }
+    }
+}
+
+FourierPricer::FourierPricer(std::shared_ptr<const CharacteristicFunctionModel> model, int nb_points, double eta, double alpha)
+    : _model(std::move(model)), _N(nb_points), _eta(eta), _alpha(alpha), _lambda(0.0)
+{
+    if (!_model) {
+        throw std::invalid_argument("Null characteristic function model.");
+    }
+    if (_N < 4 || (_N & (_N - 1)) != 0) {
+        throw std::invalid_argument("Number of FFT points must be a power of two (at least 4).");
+    }
+    if (_eta <= 0.0) {
+        throw std::invalid_argument("Frequency step must be positive.");
+    }
+    if (_alpha <= 0.0) {
+        throw std::invalid_argument("Damping factor must be positive.");
+    }
+    _lambda = 2.0 * M_PI / (_N * _eta);
+}
+
+/*psi(v) = phi(v - (alpha + 1) i) / (alpha^2 + alpha - v^2 + i (2 alpha + 1) v) est la transformée du call
+  amorti exp(alpha k) c(k). Avec v_j = eta j et des poids de Simpson w_j :
+    c(k_u) = exp(-alpha k_u) / pi * Re[ sum_j exp(-2 i pi j u / N) exp(i b v_j) psi(v_j) eta w_j ].*/
+const std::vector<double>& FourierPricer::normalizedCalls(double expiry) {
+    auto it = _tables.find(expiry);
+    if (it != _tables.end()) return it->second;
+
+    const std::complex<double> i(0.0, 1.0);
+    const double b = 0.5 * _N * _lambda;
+    std::vector<std::complex<double>> x(_N);
+    for (int j = 0; j < _N; ++j) {
+        const double v = _eta * j;
+        const std::complex<double> phi = _model->characteristicFunction(v - (_alpha + 1.0) * i, expiry);
+        const std::complex<double> psi = phi / (_alpha * _alpha + _alpha - v * v + i * (2.0 * _alpha + 1.0) * v);
+        const double simpson = (j == 0 ? 1.0 : (j % 2 == 1 ? 4.0 : 2.0)) / 3.0;
+        x[j] = std::exp(i * (b * v)) * psi * (simpson * _eta);
+    }
+    fft(x);
+
+    std::vector<double> calls(_N);
+    for (int u = 0; u < _N; ++u) {
+        const double k = -b + _lambda * u;
+        calls[u] = std::exp(-_alpha * k) / M_PI * x[u].real();
+    }
+    return _tables.emplace(expiry, std::move(calls)).first->second;
+}
+
+/*Avec F = S0 exp(r T) et k = ln(K / F), le call vaut C = exp(-r T) F E[(exp(X_T) - exp(k))^+] = S0 * c(k),
+  où c est interpolé (Lagrange cubique sur les 4 noeuds voisins) dans la grille de la FFT.*/
+std::vector<double> FourierPricer::callPrices(double asset_price, double interest_rate, double expiry, const std::vector<double>& strikes) {
+    if (asset_price <= 0.0) {
+        throw std::invalid_argument("Asset price must be positive.");
+    }
+    if (expiry <= 0.0) {
+        throw std::invalid_argument("Expiry must be positive.");
+    }
+
+    const std::vector<double>& calls = normalizedCalls(expiry);
+    const double b = 0.5 * _N * _lambda;
+    const double forward = asset_price * std::exp(interest_rate * expiry);
+
+    std::vector<double> prices;
+    prices.reserve(strikes.size());
+    for (const double K : strikes) {
+        if (K <= 0.0) {
+            throw std::invalid_argument("Strike must be positive.");
+        }
+        const double pos = (std::log(K / forward) + b) / _lambda;
+        const int u = static_cast<int>(std::floor(pos));
+        if (u < 1 || u + 2 >= _N) {
+            throw std::out_of_range("Strike outside the FFT log-strike grid; increase nb_points or eta.");
+        }
+
+        const double t = pos - u;
+        const double c0 = calls[u - 1], c1 = calls[u], c2 = calls[u + 1], c3 = calls[u + 2];
+        const double c = -t * (t - 1.0) * (t - 2.0) / 6.0 * c0 + (t + 1.0) * (t - 1.0) * (t - 2.0) / 2.0 * c1
+            - (t + 1.0) * t * (t - 2.0) / 2.0 * c2 + (t + 1.0) * t * (t - 1.0) / 6.0 * c3;
+
+        prices.push_back(asset_price * c);
+    }
+    return prices;
+}
+
+// Parité call-put
+std::vector<double> FourierPricer::putPrices(double asset_price, double interest_rate, double expiry, const std::vector<double>& strikes) {
+    std::vector<double> prices = callPrices(asset_price, interest_rate, expiry, strikes);
+    const double disc = std::exp(-interest_rate * expiry);
+    for (std::size_t j = 0; j < prices.size(); ++j) {
+        prices[j] += strikes[j] * disc - asset_price;
+    }
+    return prices;
+}
+
+double FourierPricer::callPrice(double asset_price, double interest_rate, double expiry, double strike) {
+    return callPrices(asset_price, interest_rate, expiry, { strike }).front();
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "CharacteristicFunctionModel.h"
+#include <map>
+#include <memory>
+#include <vector>
+
+/*Pricer de Fourier (Carr-Madan) : prix de calls/puts européens pour toute une grille de strikes d'une même maturité.
+	Une seule FFT de nb_points points (puissance de 2) donne le call sur nb_points log-strikes régulièrement
+	espacés autour du forward ; les strikes demandés sont obtenus par interpolation cubique. Le coût est en
+	O(N log N) par maturité, plus O(1) par strike.
+	La fonction caractéristique de X_T ne dépendant que de la maturité, la grille de calls normalisés (en
+	log-strike relatif au forward) issue de la FFT l'est aussi : elle est calculée une fois par maturité et
+	conservée. Les appels suivants (autre spot, taux ou grille de strikes) ne font plus que l'interpolation.*/
+class FourierPricer {
+private:
+	std::shared_ptr<const CharacteristicFunctionModel> _model;	// modèle (fonction caractéristique)
+	int _N;			// nombre de points de la FFT
+	double _eta;	// pas d'intégration en fréquence
+	double _alpha;	// amortissement du call (alpha > 0)
+	double _lambda;	// pas de la grille en log-strike : 2 pi / (N eta)
+
+	// Calls normalisés E[(exp(X_T) - exp(k))^+] sur la grille k_u = -N lambda / 2 + lambda u, par maturité
+	std::map<double, std::vector<double>> _tables;
+
+	// Grille de la maturité donnée (calculée par FFT au premier appel)
+	const std::vector<double>& normalizedCalls(double expiry);
+
+public:
+	FourierPricer(std::shared_ptr<const CharacteristicFunctionModel> model,
+		int nb_points = 4096, double eta = 0.25, double alpha = 1.5);
+
+	// Prix des calls européens de maturité expiry pour chaque strike
+	std::vector<double> callPrices(double asset_price, double interest_rate, double expiry, const std::vector<double>& strikes);
+
+	// Prix des puts européens (parité call-put)
+	std::vector<double> putPrices(double asset_price, double interest_rate, double expiry, const std::vector<double>& strikes);
+
+	// Prix d'un seul call
+	double callPrice(double asset_price, double interest_rate, double expiry, double strike);
+
+	// Nombre de maturités dont la table est conservée
+	std::size_t cachedExpiries() const { return _tables.size(); }
+
+	// Libère les tables conservées
+	void clearCache() { _tables.clear(); }
+};
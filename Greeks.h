@@ -0,0 +1,14 @@
+#pragma once
+#include <vector>
+
+/*Prix et sensibilités de premier ordre obtenus par différentiation adjointe (une propagation pour toutes les entrées).
+	Pour des courbes constantes par morceaux, rho et vega sont les sensibilités à un déplacement parallèle et
+	les composantes par pilier sont dans rateBuckets / volatilityBuckets (vides pour des paramètres constants).*/
+struct Greeks {
+	double price = 0.0;
+	double delta = 0.0;	// dV/dS0
+	double rho = 0.0;	// dV/dr
+	double vega = 0.0;	// dV/dsigma
+	std::vector<double> rateBuckets;		// dV/dr_j pour chaque pilier de la courbe de taux
+	std::vector<double> volatilityBuckets;	// dV/dsigma_j pour chaque pilier de la courbe de volatilité
+};
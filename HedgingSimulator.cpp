@@ -0,0 +1,226 @@
+#include "HedgingSimulator.h"
+#include "BlackScholesPricer.h"
+#include "ParallelFor.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+HedgingSimulator::HedgingSimulator(EuropeanVanillaOption* option,
+    double initial_price,
+    double interest_rate,
+    double volatility,
+    int nb_rebalances,
+    int nb_threads,
+    std::uint64_t seed)
+    : _option(option),
+    _S0(initial_price),
+    _r(interest_rate),
+    _sigma(volatility),
+    _drift(interest_rate),
+    _realVol(volatility),
+    _premium(0.0),
+    _nbRebalances(nb_rebalances),
+    _nbThreads(nb_threads),
+    _seed(seed),
+    _nbChunks(0)
+{
+    if (!_option) {
+        throw std::invalid_argument("Option pointer is null.");
+    }
+    if (_S0 <= 0.0) {
+        throw std::invalid_argument("Initial price must be positive.");
+    }
+    if (_sigma <= 0.0) {
+        throw std::invalid_argument("Volatility must be positive.");
+    }
+    if (_option->getExpiry() <= 0.0) {
+        throw std::invalid_argument("Option expiry must be positive.");
+    }
+    if (_nbRebalances <= 0) {
+        throw std::invalid_argument("Number of rebalances must be positive.");
+    }
+    if (_nbThreads < 0) {
+        throw std::invalid_argument("Number of threads must be non-negative.");
+    }
+    if (_nbThreads == 0) {
+        _nbThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    _premium = BlackScholesPricer(_option, _S0, _r, _sigma)();
+    reset();
+}
+
+void HedgingSimulator::reset() {
+    _state = MCEstimatorState();
+    _minPnL = std::numeric_limits<double>::infinity();
+    _maxPnL = -std::numeric_limits<double>::infinity();
+    _nbChunks = 0;
+}
+
+// La dérive et la volatilité réelles ne changent que la simulation du spot, pas la prime ni les deltas.
+void HedgingSimulator::setRealWorld(double drift, double volatility) {
+    if (volatility < 0.0) {
+        throw std::invalid_argument("Volatility must be non-negative.");
+    }
+    _drift = drift;
+    _realVol = volatility;
+    reset();
+}
+
+void HedgingSimulator::setRebalances(int nb_rebalances) {
+    if (nb_rebalances <= 0) {
+        throw std::invalid_argument("Number of rebalances must be positive.");
+    }
+    _nbRebalances = nb_rebalances;
+    reset();
+}
+
+// delta = N(d1) pour un call, N(d1) - 1 pour un put, avec d1 = (ln(S / K) + (r + sigma^2 / 2) tau) / (sigma sqrt(tau)).
+void HedgingSimulator::deltas(const double* spots, double* result, int n, double strike, double interest_rate,
+    double volatility, double time_to_expiry, EuropeanVanillaOption::optionType type) {
+    TELEMETRY_SCOPE(BlackScholes);
+
+    const double scale = 1.0 / (volatility * std::sqrt(time_to_expiry));
+    const double shift = (interest_rate + 0.5 * volatility * volatility) * time_to_expiry - std::log(strike);
+    const double offset = type == EuropeanVanillaOption::Call ? 0.0 : -1.0;
+    const double minusInvSqrt2 = -1.0 / std::sqrt(2.0);
+
+    for (int i = 0; i < n; ++i) {
+        result[i] = std::log(spots[i]);
+    }
+    for (int i = 0; i < n; ++i) {
+        result[i] = (result[i] + shift) * scale * minusInvSqrt2;
+    }
+    for (int i = 0; i < n; ++i) {
+        result[i] = 0.5 * std::erfc(result[i]) + offset;
+    }
+}
+
+/*Un lot est simulé par blocs de LANES chemins. Entre deux dates, le spot évolue exactement
+  S *= exp((mu - v^2 / 2) dt + v sqrt(dt) Z) et le compte espèces est capitalisé au taux sans risque ; à chaque
+  date avant la maturité, la position en actions est portée au nouveau delta, l'achat étant payé par le compte.*/
+HedgingSimulator::ChunkResult HedgingSimulator::simulateChunk(std::uint64_t chunk, int nb_paths) const {
+    std::mt19937_64 rng = chunkGenerator(_seed, chunk);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    const double T = _option->getExpiry();
+    const double dt = T / static_cast<double>(_nbRebalances);
+    const double logDrift = (_drift - 0.5 * _realVol * _realVol) * dt;
+    const double diffusion = _realVol * std::sqrt(dt);
+    const double growth = std::exp(_r * dt);
+    const double disc = std::exp(-_r * T);
+    const double strike = _option->getStrike();
+    const EuropeanVanillaOption::optionType type = _option->GetOptionType();
+
+    // Position initiale, identique pour tous les chemins
+    double delta0;
+    deltas(&_S0, &delta0, 1, strike, _r, _sigma, T, type);
+
+    double S[LANES], cash[LANES], shares[LANES], Z[LANES], delta[LANES];
+
+    ChunkResult result{ MCEstimatorState(), std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity() };
+    for (int first = 0; first < nb_paths; first += LANES) {
+        const int lanes = std::min(LANES, nb_paths - first);
+
+        for (int l = 0; l < lanes; ++l) {
+            S[l] = _S0;
+            shares[l] = delta0;
+            cash[l] = _premium - delta0 * _S0;
+        }
+
+        for (int j = 1; j <= _nbRebalances; ++j) {
+            {
+                TELEMETRY_SCOPE(MCRng);
+                for (int l = 0; l < lanes; ++l) {
+                    Z[l] = normal(rng);
+                }
+            }
+            {
+                TELEMETRY_SCOPE(MCPathBuild);
+                for (int l = 0; l < lanes; ++l) {
+                    S[l] *= std::exp(logDrift + diffusion * Z[l]);
+                    cash[l] *= growth;
+                }
+            }
+            if (j == _nbRebalances) break;
+
+            deltas(S, delta, lanes, strike, _r, _sigma, T - static_cast<double>(j) * dt, type);
+            for (int l = 0; l < lanes; ++l) {
+                cash[l] -= (delta[l] - shares[l]) * S[l];
+                shares[l] = delta[l];
+            }
+        }
+
+        TELEMETRY_SCOPE(MCPayoff);
+        for (int l = 0; l < lanes; ++l) {
+            const double pnl = disc * (cash[l] + shares[l] * S[l] - _option->payoff(S[l]));
+            result.state.add(pnl);
+            result.minPnL = std::min(result.minPnL, pnl);
+            result.maxPnL = std::max(result.maxPnL, pnl);
+        }
+    }
+
+    TELEMETRY_COUNT(PathsGenerated, nb_paths);
+    TELEMETRY_COUNT(RngDraws, static_cast<long long>(nb_paths) * _nbRebalances);
+    return result;
+}
+
+// Répartit les lots entre les threads, puis agrège leurs statistiques dans l'ordre des lots (résultat déterministe).
+void HedgingSimulator::generate(int nb_paths) {
+    if (nb_paths <= 0) {
+        throw std::invalid_argument("Number of paths must be positive.");
+    }
+
+    TELEMETRY_SCOPE(MCGenerate);
+
+    const int nbChunks = (nb_paths + CHUNK - 1) / CHUNK;
+    std::vector<ChunkResult> results(nbChunks);
+    parallelFor(nbChunks, _nbThreads, [&](int c) {
+        const int paths = std::min(CHUNK, nb_paths - c * CHUNK);
+        results[c] = simulateChunk(_nbChunks + static_cast<std::uint64_t>(c), paths);
+    });
+
+    for (const ChunkResult& result : results) {
+        _state.merge(result.state);
+        _minPnL = std::min(_minPnL, result.minPnL);
+        _maxPnL = std::max(_maxPnL, result.maxPnL);
+    }
+    _nbChunks += static_cast<std::uint64_t>(nbChunks);
+}
+
+// Moyenne du P&L actualisé. Une exception est levée si aucun chemin n'a été simulé.
+double HedgingSimulator::mean() const {
+    if (_state.nbPaths == 0) {
+        throw std::runtime_error("No paths generated. Call generate() before reading statistics.");
+    }
+    return _state.estimate;
+}
+
+double HedgingSimulator::stdDev() const {
+    return std::sqrt(_state.variance());
+}
+
+double HedgingSimulator::min() const {
+    if (_state.nbPaths == 0) {
+        throw std::runtime_error("No paths generated. Call generate() before reading statistics.");
+    }
+    return _minPnL;
+}
+
+double HedgingSimulator::max() const {
+    if (_state.nbPaths == 0) {
+        throw std::runtime_error("No paths generated. Call generate() before reading statistics.");
+    }
+    return _maxPnL;
+}
+
+// Calcule l'intervalle de confiance à 95 % autour de la moyenne.
+std::vector<double> HedgingSimulator::confidenceInterval() const {
+    const double margin = 1.96 * stdDev() / std::sqrt(static_cast<double>(_state.nbPaths));
+    return { mean() - margin, mean() + margin };
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include "EuropeanVanillaOption.h"
+#include "MCEstimatorState.h"
+#include <cstdint>
+#include <vector>
+
+/*Backtest de couverture en delta d'une option européenne vanille vendue au prix de Black-Scholes.
+	Le vendeur encaisse la prime, achète delta actions financées au taux sans risque, puis réajuste sa position
+	nb_rebalances fois jusqu'à maturité (pas réguliers) avec le delta de Black-Scholes à la volatilité implicite.
+	Le sous-jacent suit un mouvement brownien géométrique de dérive et de volatilité "réelles" (par défaut le taux
+	sans risque et la volatilité implicite), simulé exactement d'une date de réajustement à la suivante.
+	Le P&L d'un chemin est la valeur à maturité du portefeuille (compte espèces + actions - payoff), actualisée
+	à la date initiale ; avec une volatilité réelle égale à l'implicite, sa moyenne tend vers 0 et son écart-type
+	décroît en 1 / sqrt(nb_rebalances).
+	Comme dans HestonMCPricer, les chemins sont simulés par blocs de LANES (tableaux contigus : spot, espèces,
+	actions) répartis entre threads par lots de CHUNK, chaque lot ayant son propre générateur dérivé de la graine ;
+	à chaque date, les deltas de tout le bloc sont calculés en un seul appel à deltas(). Les statistiques sont
+	agrégées au fil de l'eau (Welford, minimum, maximum) : aucun chemin n'est conservé.*/
+class HedgingSimulator {
+private:
+	EuropeanVanillaOption* _option;	// option vendue
+	double _S0;			// prix spot initial
+	double _r;			// taux sans risque (financement et actualisation)
+	double _sigma;		// volatilité implicite (prime et deltas)
+	double _drift;		// dérive réelle du sous-jacent
+	double _realVol;	// volatilité réelle du sous-jacent
+	double _premium;	// prime de Black-Scholes encaissée
+
+	int _nbRebalances;	// nombre de pas entre la vente et la maturité
+	int _nbThreads;		// nombre de threads de simulation
+	std::uint64_t _seed;	// graine des générateurs de lots
+	std::uint64_t _nbChunks;	// nombre de lots déjà simulés (numérote les générateurs)
+
+	MCEstimatorState _state;	// moyenne et M2 des P&L actualisés
+	double _minPnL;		// plus petit P&L observé
+	double _maxPnL;		// plus grand P&L observé
+
+	// Statistiques d'un lot
+	struct ChunkResult {
+		MCEstimatorState state;
+		double minPnL;
+		double maxPnL;
+	};
+
+	// Simule nb_paths chemins avec le générateur du lot chunk
+	ChunkResult simulateChunk(std::uint64_t chunk, int nb_paths) const;
+
+	// Remet les statistiques à zéro (paramètres modifiés)
+	void reset();
+
+public:
+	static const int LANES = 64;	// chemins avancés ensemble
+	static const int CHUNK = 4096;	// chemins par lot (unité de répartition entre threads)
+
+	// nb_rebalances : nombre de réajustements (le premier à la vente) ; nb_threads = 0 : nombre de coeurs disponibles
+	HedgingSimulator(EuropeanVanillaOption* option, double initial_price, double interest_rate, double volatility,
+		int nb_rebalances = 52, int nb_threads = 0, std::uint64_t seed = 5489u);
+
+	// Dynamique réelle du sous-jacent (dérive, volatilité) ; remet les statistiques à zéro
+	void setRealWorld(double drift, double volatility);
+
+	// Nombre de réajustements ; remet les statistiques à zéro
+	void setRebalances(int nb_rebalances);
+
+	/*Deltas de Black-Scholes de n spots à la même date (durée résiduelle tau > 0) : les constantes de la date
+	  sont calculées une fois, puis chaque étape (log, d1, fonction de répartition) est une boucle sur des
+	  tableaux contigus.*/
+	static void deltas(const double* spots, double* result, int n, double strike, double interest_rate,
+		double volatility, double time_to_expiry, EuropeanVanillaOption::optionType type);
+
+	// Simule nb_paths chemins supplémentaires et met à jour les statistiques
+	void generate(int nb_paths);
+
+	// Prime encaissée à la vente
+	double getPremium() const { return _premium; }
+
+	// Nombre de chemins simulés
+	long long getNbPaths() const { return _state.nbPaths; }
+
+	// Moyenne et écart-type du P&L actualisé
+	double mean() const;
+	double stdDev() const;
+
+	// Extrêmes du P&L actualisé observés
+	double min() const;
+	double max() const;
+
+	// Intervalle de confiance à 95% de la moyenne sous la forme [borne_inf, borne_sup]
+	std::vector<double> confidenceInterval() const;
+
+	// État de l'estimateur du P&L (sans position de générateur : les lots sont indexés par leur numéro)
+	MCEstimatorState getState() const { return _state; }
+};
@@ -0,0 +1,101 @@
+#include "HestonCalibrator.h"
+#include "FourierPricer.h"
+#include "HestonModel.h"
+#include <cmath>
+#include <map>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+    const std::vector<double> LOWER = { 1e-4, 1e-3, 1e-4, 1e-3, -0.999 };
+    const std::vector<double> UPPER = { 4.0, 20.0, 4.0, 5.0, 0.999 };
+}
+
+HestonCalibrator::HestonCalibrator(const LevenbergMarquardt::Options& options, int nb_points)
+    : _options(options), _nbPoints(nb_points) {}
+
+std::vector<std::string> HestonCalibrator::parameterNames(const CalibrationProblem&) const {
+    return { "v0", "kappa", "theta", "xi", "rho" };
+}
+
+std::vector<double> HestonCalibrator::initialGuess(const CalibrationProblem&) const {
+    return { 0.04, 1.5, 0.04, 0.5, -0.5 };
+}
+
+CalibrationResult HestonCalibrator::calibrate(const CalibrationProblem& problem, const std::vector<double>& initial) const {
+    if (problem.spot <= 0.0) {
+        throw std::invalid_argument("Spot must be positive.");
+    }
+    if (problem.quotes.empty()) {
+        throw std::invalid_argument("No quotes to calibrate.");
+    }
+    if (initial.size() != LOWER.size()) {
+        throw std::invalid_argument("Heston calibration requires 5 initial parameters.");
+    }
+
+    // Regroupement des cotations par maturité : indices des cotations et strikes de chaque groupe
+    std::map<double, std::vector<std::size_t>> groups;
+    for (std::size_t i = 0; i < problem.quotes.size(); ++i) {
+        groups[problem.quotes[i].expiry].push_back(i);
+    }
+    std::vector<double> Ts;
+    std::vector<std::vector<std::size_t>> indices;
+    std::vector<std::vector<double>> strikes;
+    for (const auto& group : groups) {
+        Ts.push_back(group.first);
+        indices.push_back(group.second);
+        strikes.emplace_back();
+        for (const std::size_t i : group.second) strikes.back().push_back(problem.quotes[i].strike);
+    }
+
+    const std::size_t m = problem.quotes.size();
+    const std::size_t n = LOWER.size();
+
+    // Prix modèle de toutes les cotations : une FFT par maturité
+    auto prices = [&](const std::vector<double>& p, std::vector<double>& out) {
+        FourierPricer pricer(std::make_shared<HestonModel>(p[0], p[1], p[2], p[3], p[4]), _nbPoints);
+        out.resize(m);
+        for (std::size_t g = 0; g < Ts.size(); ++g) {
+            const std::vector<double> calls = pricer.callPrices(problem.spot, problem.rate, Ts[g], strikes[g]);
+            const double disc = std::exp(-problem.rate * Ts[g]);
+            for (std::size_t j = 0; j < calls.size(); ++j) {
+                const OptionQuote& q = problem.quotes[indices[g][j]];
+                out[indices[g][j]] = q.isCall ? calls[j] : calls[j] - problem.spot + q.strike * disc;
+            }
+        }
+    };
+
+    std::vector<double> model, bumped;
+    auto residuals = [&](const std::vector<double>& p, std::vector<double>& r, std::vector<double>* J) {
+        prices(p, model);
+        r.resize(m);
+        for (std::size_t i = 0; i < m; ++i) {
+            r[i] = problem.quotes[i].weight * (model[i] - problem.quotes[i].price);
+        }
+        if (!J) return;
+
+        // Différences finies avant, pas vers l'intérieur du domaine près de la borne supérieure
+        J->assign(m * n, 0.0);
+        for (std::size_t a = 0; a < n; ++a) {
+            std::vector<double> q = p;
+            double h = 1e-5 * std::max(1.0, std::abs(p[a]));
+            if (q[a] + h > UPPER[a]) h = -h;
+            q[a] += h;
+            prices(q, bumped);
+            for (std::size_t i = 0; i < m; ++i) {
+                (*J)[i * n + a] = problem.quotes[i].weight * (bumped[i] - model[i]) / h;
+            }
+        }
+    };
+
+    LevenbergMarquardt solver(_options);
+    solver.setBounds(LOWER, UPPER);
+    const LevenbergMarquardt::Result fit = solver.solve(residuals, initial);
+
+    CalibrationResult result;
+    result.parameters = fit.parameters;
+    result.rmse = std::sqrt(2.0 * fit.cost / static_cast<double>(m));
+    result.iterations = fit.iterations;
+    result.converged = fit.converged;
+    return result;
+}
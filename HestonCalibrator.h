@@ -0,0 +1,20 @@
+#pragma once
+#include "Calibrator.h"
+#include "LevenbergMarquardt.h"
+
+/*Calibration du modèle de Heston, paramètres (v0, kappa, theta, xi, rho).
+	Les cotations sont regroupées par maturité et chaque groupe est pricé en une FFT (FourierPricer) ; la
+	jacobienne est obtenue par différences finies avant, soit une FFT par maturité et par paramètre.
+	Les paramètres sont bornés (variances et vitesses positives, |rho| < 1).*/
+class HestonCalibrator : public Calibrator {
+private:
+	LevenbergMarquardt::Options _options;
+	int _nbPoints;	// points de la FFT
+
+public:
+	explicit HestonCalibrator(const LevenbergMarquardt::Options& options = LevenbergMarquardt::Options(), int nb_points = 4096);
+
+	std::vector<std::string> parameterNames(const CalibrationProblem& problem) const override;
+	std::vector<double> initialGuess(const CalibrationProblem& problem) const override;
+	CalibrationResult calibrate(const CalibrationProblem& problem, const std::vector<double>& initial) const override;
+};
@@ -0,0 +1,233 @@
+#include "HestonMCPricer.h"
+#include "AsianOption.h"
+#include "ParallelFor.h"
+#include "ScriptedOption.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    // Seuil de bascule entre les deux branches du schéma QE (Andersen recommande 1.5)
+    const double PSI_C = 1.5;
+
+    // Fonction de répartition de la loi normale standard N(0,1)
+    inline double N(double x) {
+        return 0.5 * std::erfc(-x / std::sqrt(2.0));
+    }
+}
+
+HestonMCPricer::HestonMCPricer(Option* option,
+    double initial_price,
+    double interest_rate,
+    const HestonModel& model,
+    int steps_per_year,
+    int nb_threads,
+    std::uint64_t seed)
+    : _option(option),
+    _S0(initial_price),
+    _r(interest_rate),
+    _model(model),
+    _stepsPerYear(steps_per_year),
+    _nbThreads(nb_threads),
+    _seed(seed),
+    _nbChunks(0)
+{
+    if (!_option) {
+        throw std::invalid_argument("Option pointer is null.");
+    }
+    if (_option->isAmericanOption()) {
+        throw std::invalid_argument("Heston Monte Carlo pricer does not support American options.");
+    }
+    // Seules l'échéance, les fixings asiatiques ou les dates d'un script sont simulés
+    if (_option->isBarrierOption() || _option->isLookbackOption() || _option->isMultiAssetOption()) {
+        throw std::invalid_argument("Heston Monte Carlo pricer does not support barrier, lookback or multi-asset options.");
+    }
+    if (_S0 <= 0.0) {
+        throw std::invalid_argument("Initial price must be positive.");
+    }
+    if (_stepsPerYear <= 0) {
+        throw std::invalid_argument("Number of steps per year must be positive.");
+    }
+    if (_nbThreads < 0) {
+        throw std::invalid_argument("Number of threads must be non-negative.");
+    }
+    if (_nbThreads == 0) {
+        _nbThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Dates d'observation : la maturité, les dates de fixing d'une option asiatique ou les dates utilisées par un script
+    std::vector<double> dates{ _option->getExpiry() };
+    if (_option->isAsianOption()) {
+        const AsianOption* asian = dynamic_cast<const AsianOption*>(_option);
+        if (!asian) {
+            throw std::runtime_error("Option says it is Asian, but cannot cast to AsianOption.");
+        }
+        dates = asian->getTimeSteps();
+    }
+    else if (_option->isScriptedOption()) {
+        dates = static_cast<const ScriptedOption*>(_option)->getSimulationDates();
+    }
+
+    // Découpage de chaque intervalle en pas réguliers et pré-calcul des constantes du schéma
+    const double kappa = _model.getKappa(), theta = _model.getTheta(), xi = _model.getXi(), rho = _model.getRho();
+    double t_prev = 0.0;
+    for (const double t : dates) {
+        const double interval = t - t_prev;
+        if (interval < 0.0) {
+            throw std::invalid_argument("Observation dates must be non-decreasing.");
+        }
+        const int nbSub = static_cast<int>(std::ceil(interval * _stepsPerYear));
+        for (int j = 0; j < nbSub; ++j) {
+            const double dt = interval / nbSub;
+            Step step;
+            step.e = std::exp(-kappa * dt);
+            step.c1 = xi * xi * step.e * (1.0 - step.e) / kappa;
+            step.c2 = theta * xi * xi * (1.0 - step.e) * (1.0 - step.e) / (2.0 * kappa);
+            step.K0 = -rho * kappa * theta / xi * dt;
+            step.K1 = 0.5 * dt * (kappa * rho / xi - 0.5) - rho / xi;
+            step.K2 = 0.5 * dt * (kappa * rho / xi - 0.5) + rho / xi;
+            step.K3 = 0.5 * dt * (1.0 - rho * rho);
+            step.K4 = step.K3;
+            step.A = step.K2 + 0.5 * step.K4;
+            step.rdt = _r * dt;
+            _steps.push_back(step);
+        }
+        _observeAfter.push_back(_steps.size());
+        t_prev = t;
+    }
+}
+
+/*Un lot est simulé par blocs de LANES chemins : pour chaque pas, les 2 x LANES normales sont tirées d'un coup,
+  puis la variance et le log-spot de tous les chemins du bloc sont mis à jour dans des tableaux contigus.
+  Schéma QE (Andersen 2008), avec m et s^2 les deux premiers moments de v(t+dt) sachant v(t) et psi = s^2 / m^2 :
+    - psi <= PSI_C : v(t+dt) = a (b + Zv)^2 ;
+    - psi >  PSI_C : v(t+dt) = 0 avec probabilité p, loi exponentielle sinon (inversion de U = N(Zv)).
+  Le log-spot suit X += r dt + K0* + K1 v(t) + K2 v(t+dt) + sqrt(K3 v(t) + K4 v(t+dt)) Z, où K0* est choisi
+  pour que exp(X - r t) soit exactement une martingale discrète.*/
+MCEstimatorState HestonMCPricer::simulateChunk(std::uint64_t chunk, int nb_paths) const {
+    std::mt19937_64 rng = chunkGenerator(_seed, chunk);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    const double theta = _model.getTheta();
+    const double disc = std::exp(-_r * _option->getExpiry());
+    const double logS0 = std::log(_S0);
+
+    double X[LANES], V[LANES], Zv[LANES], Z[LANES];
+    std::vector<std::vector<double>> paths(LANES);
+    for (std::vector<double>& path : paths) path.reserve(_observeAfter.size());
+
+    MCEstimatorState state;
+    for (int first = 0; first < nb_paths; first += LANES) {
+        const int lanes = std::min(LANES, nb_paths - first);
+
+        for (int l = 0; l < lanes; ++l) {
+            X[l] = 0.0;
+            V[l] = _model.getV0();
+            paths[l].clear();
+        }
+
+        std::size_t date = 0;
+        for (std::size_t j = 0; j <= _steps.size(); ++j) {
+            // Enregistrement des dates d'observation atteintes après j pas
+            for (; date < _observeAfter.size() && _observeAfter[date] == j; ++date) {
+                for (int l = 0; l < lanes; ++l) {
+                    paths[l].push_back(std::exp(logS0 + X[l]));
+                }
+            }
+            if (j == _steps.size()) break;
+
+            const Step& st = _steps[j];
+            {
+                TELEMETRY_SCOPE(MCRng);
+                for (int l = 0; l < lanes; ++l) {
+                    Zv[l] = normal(rng);
+                    Z[l] = normal(rng);
+                }
+            }
+
+            TELEMETRY_SCOPE(MCPathBuild);
+            for (int l = 0; l < lanes; ++l) {
+                const double v = V[l];
+                const double m = theta + (v - theta) * st.e;
+                const double s2 = st.c1 * v + st.c2;
+
+                double vNext = 0.0;
+                double K0 = st.K0;
+                if (m > 0.0) {
+                    const double psi = s2 / (m * m);
+                    if (psi <= PSI_C) {
+                        const double inv = 2.0 / psi;
+                        const double b2 = inv - 1.0 + std::sqrt(inv) * std::sqrt(inv - 1.0);
+                        const double a = m / (1.0 + b2);
+                        const double b = std::sqrt(b2);
+                        vNext = a * (b + Zv[l]) * (b + Zv[l]);
+                        if (st.A * a < 0.5) {
+                            K0 = -st.A * b2 * a / (1.0 - 2.0 * st.A * a) + 0.5 * std::log(1.0 - 2.0 * st.A * a)
+                                - (st.K1 + 0.5 * st.K3) * v;
+                        }
+                    }
+                    else {
+                        const double p = (psi - 1.0) / (psi + 1.0);
+                        const double beta = (1.0 - p) / m;
+                        const double U = N(Zv[l]);
+                        vNext = U <= p ? 0.0 : std::log((1.0 - p) / (1.0 - U)) / beta;
+                        if (st.A < beta) {
+                            K0 = -std::log(p + beta * (1.0 - p) / (beta - st.A)) - (st.K1 + 0.5 * st.K3) * v;
+                        }
+                    }
+                }
+
+                X[l] += st.rdt + K0 + st.K1 * v + st.K2 * vNext + std::sqrt(st.K3 * v + st.K4 * vNext) * Z[l];
+                V[l] = vNext;
+            }
+        }
+
+        TELEMETRY_SCOPE(MCPayoff);
+        for (int l = 0; l < lanes; ++l) {
+            state.add(disc * _option->payoffPath(paths[l]));
+        }
+    }
+
+    TELEMETRY_COUNT(PathsGenerated, nb_paths);
+    TELEMETRY_COUNT(RngDraws, 2LL * nb_paths * static_cast<long long>(_steps.size()));
+    return state;
+}
+
+// Répartit les lots entre les threads, puis agrège leurs estimateurs dans l'ordre des lots (résultat déterministe).
+void HestonMCPricer::generate(int nb_paths) {
+    if (nb_paths <= 0) {
+        throw std::invalid_argument("Number of paths must be positive.");
+    }
+
+    TELEMETRY_SCOPE(MCGenerate);
+
+    const int nbChunks = (nb_paths + CHUNK - 1) / CHUNK;
+    std::vector<MCEstimatorState> results(nbChunks);
+    parallelFor(nbChunks, _nbThreads, [&](int c) {
+        const int paths = std::min(CHUNK, nb_paths - c * CHUNK);
+        results[c] = simulateChunk(_nbChunks + static_cast<std::uint64_t>(c), paths);
+    });
+
+    for (const MCEstimatorState& result : results) {
+        _state.merge(result);
+    }
+    _nbChunks += static_cast<std::uint64_t>(nbChunks);
+}
+
+// Retourne l'estimation courante du prix. Une exception est levée si aucun chemin n'a été généré.
+double HestonMCPricer::operator()() const {
+    if (_state.nbPaths == 0) {
+        throw std::runtime_error("No paths generated. Call generate() before pricing.");
+    }
+    return _state.estimate;
+}
+
+// Calcule l'intervalle de confiance à 95 % autour de l'estimation.
+std::vector<double> HestonMCPricer::confidenceInterval() const {
+    const double stddev = std::sqrt(_state.variance());
+    const double margin = 1.96 * stddev / std::sqrt(static_cast<double>(_state.nbPaths));
+    return { _state.estimate - margin, _state.estimate + margin };
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include "Option.h"
+#include "HestonModel.h"
+#include "MCEstimatorState.h"
+#include <cstdint>
+#include <vector>
+
+/*Pricer Monte Carlo sous le modèle de Heston, schéma quadratique-exponentiel (QE) d'Andersen avec correction
+	de martingale sur le log-spot. Le payoff est évalué par Option::payoffPath() sur le chemin des dates
+	d'observation (la maturité pour une option européenne ou digitale, les dates de fixing pour une option
+	asiatique, les dates utilisées par le script d'une ScriptedOption), chaque intervalle étant découpé en pas
+	d'au plus 1 / steps_per_year. Les options américaines, à barrière, lookback et multi-actifs, dont le payoff
+	dépend d'une surveillance que ce chemin ne reproduit pas, lèvent std::invalid_argument.
+	Les trajectoires sont simulées par blocs de LANES chemins avancés ensemble (tableaux contigus, boucles
+	vectorisables) et réparties entre nb_threads threads par lots de CHUNK chemins. Chaque lot a son propre
+	générateur, dérivé de la graine et de son numéro : le résultat ne dépend pas du nombre de threads.*/
+class HestonMCPricer {
+private:
+	Option* _option;	// option à pricer
+	double _S0;		// prix spot initial
+	double _r;		// taux sans risque
+	HestonModel _model;	// paramètres de la variance
+
+	int _stepsPerYear;	// finesse de la discrétisation
+	int _nbThreads;		// nombre de threads de simulation
+	std::uint64_t _seed;	// graine des générateurs de lots
+	std::uint64_t _nbChunks;	// nombre de lots déjà simulés (numérote les générateurs)
+
+	MCEstimatorState _state;	// estimateur courant (moyenne et M2 des payoffs actualisés)
+
+	// Constantes d'un pas de longueur dt du schéma QE (pré-calculées une fois pour toutes)
+	struct Step {
+		double e;		// exp(-kappa dt)
+		double c1, c2;	// variance conditionnelle de v : s^2 = c1 v + c2
+		double K0, K1, K2, K3, K4;	// coefficients du log-spot (gamma1 = gamma2 = 1/2)
+		double A;		// K2 + K4 / 2, pour la correction de martingale
+		double rdt;		// r dt
+	};
+	std::vector<Step> _steps;
+	std::vector<std::size_t> _observeAfter;	// nombre de pas effectués à chaque date d'observation
+
+	// Simule nb_paths chemins avec le générateur du lot chunk et retourne leur estimateur
+	MCEstimatorState simulateChunk(std::uint64_t chunk, int nb_paths) const;
+
+public:
+	static const int LANES = 64;	// chemins avancés ensemble
+	static const int CHUNK = 4096;	// chemins par lot (unité de répartition entre threads)
+
+	// nb_threads = 0 : nombre de coeurs disponibles
+	HestonMCPricer(Option* option, double initial_price, double interest_rate, const HestonModel& model,
+		int steps_per_year = 52, int nb_threads = 0, std::uint64_t seed = 5489u);
+
+	// Accès en lecture au nombre de chemins générés
+	long long getNbPaths() const { return _state.nbPaths; }
+
+	// Génère nb_paths trajectoires supplémentaires et met à jour l'estimation.
+	void generate(int nb_paths);
+
+	// Retourne l'estimation courante
+	double operator()() const;
+
+	// Retourne l'intervalle de confiance à 95% sous la forme [borne_inf, borne_sup]
+	std::vector<double> confidenceInterval() const;
+
+	// État de l'estimateur (sans position de générateur : les lots sont indexés par leur numéro)
+	MCEstimatorState getState() const { return _state; }
+
+	// Agrège les tirages d'une exécution indépendante (autre graine) sur le même problème.
+	void merge(const MCEstimatorState& other) { _state.merge(other); }
+};
@@ -0,0 +1,110 @@
+#include "HestonModel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+    // Noeuds et poids de Gauss-Legendre à n points sur [-1, 1] (racines de P_n par la méthode de Newton)
+    struct GaussLegendre {
+        std::vector<double> nodes, weights;
+
+        explicit GaussLegendre(int n) : nodes(n), weights(n) {
+            for (int i = 0; i < (n + 1) / 2; ++i) {
+                double x = std::cos(M_PI * (i + 0.75) / (n + 0.5));
+                double dp = 0.0;
+                for (int iter = 0; iter < 100; ++iter) {
+                    double p0 = 1.0, p1 = x;
+                    for (int k = 2; k <= n; ++k) {
+                        const double p2 = ((2.0 * k - 1.0) * x * p1 - (k - 1.0) * p0) / k;
+                        p0 = p1;
+                        p1 = p2;
+                    }
+                    dp = n * (x * p1 - p0) / (x * x - 1.0);
+                    const double dx = p1 / dp;
+                    x -= dx;
+                    if (std::abs(dx) < 1e-15) break;
+                }
+                nodes[i] = -x;
+                nodes[n - 1 - i] = x;
+                weights[i] = weights[n - 1 - i] = 2.0 / ((1.0 - x * x) * dp * dp);
+            }
+        }
+    };
+}
+
+HestonModel::HestonModel(double initial_variance,
+    double mean_reversion,
+    double long_term_variance,
+    double vol_of_vol,
+    double correlation)
+    : _v0(initial_variance),
+    _kappa(mean_reversion),
+    _theta(long_term_variance),
+    _xi(vol_of_vol),
+    _rho(correlation)
+{
+    if (_v0 < 0.0) throw std::invalid_argument("Initial variance must be non-negative.");
+    if (_kappa <= 0.0) throw std::invalid_argument("Mean reversion speed must be positive.");
+    if (_theta < 0.0) throw std::invalid_argument("Long-term variance must be non-negative.");
+    if (_xi <= 0.0) throw std::invalid_argument("Volatility of variance must be positive.");
+    if (_rho < -1.0 || _rho > 1.0) throw std::invalid_argument("Correlation must lie in [-1, 1].");
+}
+
+std::complex<double> HestonModel::characteristicFunction(std::complex<double> u, double expiry) const {
+    const std::complex<double> i(0.0, 1.0);
+    const double xi2 = _xi * _xi;
+
+    const std::complex<double> beta = _kappa - _rho * _xi * i * u;
+    const std::complex<double> d = std::sqrt(beta * beta + xi2 * (i * u + u * u));
+    const std::complex<double> g = (beta - d) / (beta + d);
+    const std::complex<double> e = std::exp(-d * expiry);
+
+    const std::complex<double> C = _kappa * _theta / xi2
+        * ((beta - d) * expiry - 2.0 * std::log((1.0 - g * e) / (1.0 - g)));
+    const std::complex<double> D = (beta - d) / xi2 * (1.0 - e) / (1.0 - g * e);
+
+    return std::exp(C + D * _v0);
+}
+
+/*Formule de Lewis : avec x = ln(S0 / K) + r T,
+    C = S0 - sqrt(S0 K) exp(-r T / 2) / pi * int_0^inf Re[exp(i u x) phi(u - i/2)] / (u^2 + 1/4) du.
+  L'intégrande décroît au moins en 1/u^2 : on somme des panneaux de largeur fixe jusqu'à ce que leur
+  contribution devienne négligeable.*/
+double HestonModel::callPrice(double asset_price, double interest_rate, double strike, double expiry) const {
+    if (asset_price <= 0.0) throw std::invalid_argument("Asset price must be positive.");
+    if (strike <= 0.0) throw std::invalid_argument("Strike must be positive.");
+    if (expiry < 0.0) throw std::invalid_argument("Expiry must be non-negative.");
+    if (expiry == 0.0) return std::max(asset_price - strike, 0.0);
+
+    static const GaussLegendre rule(20);
+    const double panel = 5.0;
+    const int maxPanels = 2000;
+    const double x = std::log(asset_price / strike) + interest_rate * expiry;
+    const std::complex<double> shift(0.0, -0.5);
+
+    double integral = 0.0;
+    for (int k = 0; k < maxPanels; ++k) {
+        const double a = k * panel;
+        double contribution = 0.0;
+        for (std::size_t j = 0; j < rule.nodes.size(); ++j) {
+            const double u = a + 0.5 * panel * (rule.nodes[j] + 1.0);
+            const std::complex<double> phi = characteristicFunction(u + shift, expiry);
+            const double f = (std::exp(std::complex<double>(0.0, u * x)) * phi).real() / (u * u + 0.25);
+            contribution += rule.weights[j] * f;
+        }
+        contribution *= 0.5 * panel;
+        integral += contribution;
+        if (std::abs(contribution) < 1e-14 * std::abs(integral)) break;
+    }
+
+    return asset_price - std::sqrt(asset_price * strike) * std::exp(-0.5 * interest_rate * expiry) / M_PI * integral;
+}
+
+// Parité call-put
+double HestonModel::putPrice(double asset_price, double interest_rate, double strike, double expiry) const {
+    return callPrice(asset_price, interest_rate, strike, expiry) - asset_price + strike * std::exp(-interest_rate * expiry);
+}
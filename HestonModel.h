@@ -0,0 +1,36 @@
+#pragma once
+#include "CharacteristicFunctionModel.h"
+#include <complex>
+
+/*Modèle à volatilité stochastique de Heston :
+	dS = r S dt + sqrt(v) S dW1
+	dv = kappa (theta - v) dt + xi sqrt(v) dW2,	d<W1, W2> = rho dt
+	La classe ne contient que les paramètres de la variance ; le spot et le taux sont fournis au moment du pricing.
+	Le prix européen semi-analytique (formule de Lewis, une seule intégrale de Fourier) sert de référence au
+	pricer Monte Carlo HestonMCPricer.*/
+class HestonModel : public CharacteristicFunctionModel {
+private:
+	double _v0;		// variance initiale
+	double _kappa;	// vitesse de retour à la moyenne
+	double _theta;	// variance de long terme
+	double _xi;		// volatilité de la variance
+	double _rho;	// corrélation spot / variance
+
+public:
+	HestonModel(double initial_variance, double mean_reversion, double long_term_variance,
+		double vol_of_vol, double correlation);
+
+	double getV0() const { return _v0; }
+	double getKappa() const { return _kappa; }
+	double getTheta() const { return _theta; }
+	double getXi() const { return _xi; }
+	double getRho() const { return _rho; }
+
+	// Fonction caractéristique de X_T = ln(S_T / S_0) - r T, E[exp(i u X_T)], pour u complexe
+	// (forme « little Heston trap » d'Albrecher et al., sans discontinuité de branche du logarithme).
+	std::complex<double> characteristicFunction(std::complex<double> u, double expiry) const override;
+
+	// Prix d'un call / put européen par la formule de Lewis (intégration de Gauss-Legendre par panneaux)
+	double callPrice(double asset_price, double interest_rate, double strike, double expiry) const;
+	double putPrice(double asset_price, double interest_rate, double strike, double expiry) const;
+};
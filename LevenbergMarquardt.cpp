@@ -0,0 +1,188 @@
+#include "LevenbergMarquardt.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+    // Résout A x = b (A symétrique définie positive, n x n) par Cholesky ; faux si A n'est pas définie positive.
+    bool choleskySolve(std::vector<double> A, std::vector<double>& b, std::size_t n) {
+        for (std::size_t j = 0; j < n; ++j) {
+            double d = A[j * n + j];
+            for (std::size_t k = 0; k < j; ++k) d -= A[j * n + k] * A[j * n + k];
+            if (!(d > 0.0)) return false;
+            d = std::sqrt(d);
+            A[j * n + j] = d;
+            for (std::size_t i = j + 1; i < n; ++i) {
+                double s = A[i * n + j];
+                for (std::size_t k = 0; k < j; ++k) s -= A[i * n + k] * A[j * n + k];
+                A[i * n + j] = s / d;
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t k = 0; k < i; ++k) b[i] -= A[i * n + k] * b[k];
+            b[i] /= A[i * n + i];
+        }
+        for (std::size_t i = n; i-- > 0;) {
+            for (std::size_t k = i + 1; k < n; ++k) b[i] -= A[k * n + i] * b[k];
+            b[i] /= A[i * n + i];
+        }
+        return true;
+    }
+
+    double halfSquaredNorm(const std::vector<double>& r) {
+        double s = 0.0;
+        for (const double x : r) s += x * x;
+        return 0.5 * s;
+    }
+}
+
+LevenbergMarquardt::LevenbergMarquardt(const Options& options) : _options(options) {
+    if (_options.maxIterations <= 0) {
+        throw std::invalid_argument("Maximum number of iterations must be positive.");
+    }
+}
+
+void LevenbergMarquardt::setBounds(const std::vector<double>& lower, const std::vector<double>& upper) {
+    if (!lower.empty() && !upper.empty() && lower.size() != upper.size()) {
+        throw std::invalid_argument("Lower and upper bounds must have the same size.");
+    }
+    for (std::size_t j = 0; j < std::min(lower.size(), upper.size()); ++j) {
+        if (lower[j] > upper[j]) {
+            throw std::invalid_argument("Lower bound exceeds upper bound.");
+        }
+    }
+    _lower = lower;
+    _upper = upper;
+}
+
+void LevenbergMarquardt::project(std::vector<double>& p) const {
+    for (std::size_t j = 0; j < p.size(); ++j) {
+        if (j < _lower.size()) p[j] = std::max(p[j], _lower[j]);
+        if (j < _upper.size()) p[j] = std::min(p[j], _upper[j]);
+    }
+}
+
+LevenbergMarquardt::Result LevenbergMarquardt::solve(const Problem& problem, std::vector<double> initial) const {
+    const std::size_t n = initial.size();
+    if (n == 0) {
+        throw std::invalid_argument("No parameters to calibrate.");
+    }
+    if ((!_lower.empty() && _lower.size() != n) || (!_upper.empty() && _upper.size() != n)) {
+        throw std::invalid_argument("Bounds do not match the number of parameters.");
+    }
+
+    Result result;
+    std::vector<double> p = std::move(initial);
+    project(p);
+
+    std::vector<double> r, J, rTrial;
+    problem(p, r, &J);
+    ++result.evaluations;
+    const std::size_t m = r.size();
+    if (m == 0 || J.size() != m * n) {
+        throw std::invalid_argument("Problem returned inconsistent residuals and Jacobian sizes.");
+    }
+    double cost = halfSquaredNorm(r);
+
+    // Équations normales : A = J^T J, g = J^T r
+    std::vector<double> A(n * n), g(n);
+    auto normalEquations = [&]() {
+        std::fill(A.begin(), A.end(), 0.0);
+        std::fill(g.begin(), g.end(), 0.0);
+        for (std::size_t i = 0; i < m; ++i) {
+            const double* row = &J[i * n];
+            for (std::size_t a = 0; a < n; ++a) {
+                g[a] += row[a] * r[i];
+                for (std::size_t b = 0; b <= a; ++b) A[a * n + b] += row[a] * row[b];
+            }
+        }
+        for (std::size_t a = 0; a < n; ++a)
+            for (std::size_t b = 0; b < a; ++b) A[b * n + a] = A[a * n + b];
+    };
+    normalEquations();
+
+    double maxDiag = 0.0;
+    for (std::size_t a = 0; a < n; ++a) maxDiag = std::max(maxDiag, A[a * n + a]);
+    double mu = _options.initialDamping * std::max(maxDiag, std::numeric_limits<double>::min());
+    double nu = 2.0;
+
+    for (result.iterations = 0; result.iterations < _options.maxIterations; ++result.iterations) {
+        double gInf = 0.0;
+        for (const double x : g) gInf = std::max(gInf, std::abs(x));
+        if (gInf < _options.gradientTolerance) {
+            result.converged = true;
+            break;
+        }
+
+        // Pas amorti (mise à l'échelle de Marquardt par la diagonale de J^T J)
+        std::vector<double> damped = A;
+        for (std::size_t a = 0; a < n; ++a) {
+            damped[a * n + a] += mu * std::max(A[a * n + a], 1e-12 * std::max(maxDiag, 1.0));
+        }
+        std::vector<double> step(n);
+        for (std::size_t a = 0; a < n; ++a) step[a] = -g[a];
+        if (!choleskySolve(damped, step, n)) {
+            mu *= nu;
+            nu *= 2.0;
+            continue;
+        }
+
+        std::vector<double> trial(n);
+        for (std::size_t a = 0; a < n; ++a) trial[a] = p[a] + step[a];
+        project(trial);
+
+        // Pas effectif après projection
+        double stepNorm = 0.0, pNorm = 0.0;
+        for (std::size_t a = 0; a < n; ++a) {
+            step[a] = trial[a] - p[a];
+            stepNorm += step[a] * step[a];
+            pNorm += p[a] * p[a];
+        }
+        if (std::sqrt(stepNorm) <= _options.stepTolerance * (std::sqrt(pNorm) + _options.stepTolerance)) {
+            result.converged = true;
+            break;
+        }
+
+        problem(trial, rTrial, nullptr);
+        ++result.evaluations;
+        if (rTrial.size() != m) {
+            throw std::runtime_error("Problem changed the number of residuals.");
+        }
+        const double trialCost = halfSquaredNorm(rTrial);
+
+        // Baisse prédite par le modèle quadratique : -g.d - 1/2 d.A.d
+        double predicted = 0.0;
+        for (std::size_t a = 0; a < n; ++a) {
+            double Ad = 0.0;
+            for (std::size_t b = 0; b < n; ++b) Ad += A[a * n + b] * step[b];
+            predicted -= g[a] * step[a] + 0.5 * step[a] * Ad;
+        }
+        const double rho = predicted > 0.0 ? (cost - trialCost) / predicted : -1.0;
+
+        if (rho > 0.0 && trialCost < cost) {
+            const double decrease = (cost - trialCost) / std::max(cost, std::numeric_limits<double>::min());
+            p = trial;
+            problem(p, r, &J);
+            ++result.evaluations;
+            cost = halfSquaredNorm(r);
+            normalEquations();
+
+            mu *= std::max(1.0 / 3.0, 1.0 - std::pow(2.0 * rho - 1.0, 3));
+            nu = 2.0;
+            if (decrease < _options.costTolerance) {
+                ++result.iterations;
+                result.converged = true;
+                break;
+            }
+        }
+        else {
+            mu *= nu;
+            nu *= 2.0;
+        }
+    }
+
+    result.parameters = p;
+    result.cost = cost;
+    return result;
+}
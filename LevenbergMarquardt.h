@@ -0,0 +1,47 @@
+#pragma once
+#include <functional>
+#include <vector>
+
+/*Solveur de Levenberg-Marquardt pour les moindres carrés non linéaires min 1/2 |r(p)|^2, avec bornes
+	simples sur les paramètres (projection du pas). Le problème fournit en un seul appel le vecteur des résidus
+	et, si demandé, la jacobienne : un pricer peut ainsi évaluer toutes les cotations en un lot et en déduire
+	les dérivées analytiques au passage.
+	Le facteur d'amortissement suit la règle de Nielsen ; les équations normales (J^T J + mu diag(J^T J)) d = -J^T r
+	sont résolues par Cholesky (quelques paramètres, beaucoup de résidus).*/
+class LevenbergMarquardt {
+public:
+	/*Évalue les résidus en p ; si jacobian est non nul, y écrit aussi la jacobienne (m x n, par lignes :
+	  (*jacobian)[i * n + j] = d r_i / d p_j).*/
+	using Problem = std::function<void(const std::vector<double>& p, std::vector<double>& residuals, std::vector<double>* jacobian)>;
+
+	struct Options {
+		int maxIterations = 200;
+		double gradientTolerance = 1e-12;	// arrêt si |J^T r|_inf est inférieur
+		double stepTolerance = 1e-10;		// arrêt si le pas relatif est inférieur
+		double costTolerance = 1e-12;		// arrêt si la baisse relative du coût est inférieure
+		double initialDamping = 1e-3;		// mu initial, relatif à max diag(J^T J)
+	};
+
+	struct Result {
+		std::vector<double> parameters;	// paramètres optimaux
+		double cost = 0.0;		// 1/2 |r|^2 à l'optimum
+		int iterations = 0;		// nombre d'itérations effectuées
+		int evaluations = 0;	// nombre d'appels au problème
+		bool converged = false;	// un critère d'arrêt a été atteint avant maxIterations
+	};
+
+	LevenbergMarquardt() : LevenbergMarquardt(Options()) {}
+	explicit LevenbergMarquardt(const Options& options);
+
+	// Bornes (vecteurs vides : pas de borne)
+	void setBounds(const std::vector<double>& lower, const std::vector<double>& upper);
+
+	// Minimise à partir de initial
+	Result solve(const Problem& problem, std::vector<double> initial) const;
+
+private:
+	Options _options;
+	std::vector<double> _lower, _upper;
+
+	void project(std::vector<double>& p) const;
+};
@@ -0,0 +1,54 @@
+#include "LocalVolSurface.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+LocalVolSurface::LocalVolSurface(const std::function<double(double, double)>& sigma,
+    double spot_min,
+    double spot_max,
+    double t_max,
+    int nb_spot_points,
+    int nb_time_points)
+    : _xMin(0.0), _dx(0.0), _tMin(0.0), _dt(0.0), _nx(nb_spot_points), _nt(nb_time_points)
+{
+    if (!sigma) throw std::invalid_argument("Null local volatility function.");
+    if (!(spot_min > 0.0 && spot_min < spot_max)) throw std::invalid_argument("Require 0 < spot_min < spot_max.");
+    if (t_max <= 0.0) throw std::invalid_argument("Time horizon must be positive.");
+    if (_nx < 2 || _nt < 2) throw std::invalid_argument("Local volatility grid needs at least 2 points per axis.");
+
+    _xMin = std::log(spot_min);
+    _dx = (std::log(spot_max) - _xMin) / (_nx - 1);
+    _dt = t_max / (_nt - 1);
+
+    _grid.resize(static_cast<std::size_t>(_nx) * _nt);
+    for (int it = 0; it < _nt; ++it) {
+        const double t = _tMin + it * _dt;
+        for (int ix = 0; ix < _nx; ++ix) {
+            const double v = sigma(std::exp(_xMin + ix * _dx), t);
+            if (!(v >= 0.0)) {
+                throw std::invalid_argument("Local volatility must be non-negative.");
+            }
+            _grid[static_cast<std::size_t>(it) * _nx + ix] = v;
+        }
+    }
+}
+
+void LocalVolSurface::timeSlice(double t, std::vector<double>& slice) const {
+    double u = (t - _tMin) / _dt;
+    u = std::min(std::max(u, 0.0), static_cast<double>(_nt - 1));
+    const int it = std::min(static_cast<int>(u), _nt - 2);
+    const double w = u - it;
+
+    const double* row0 = &_grid[static_cast<std::size_t>(it) * _nx];
+    const double* row1 = row0 + _nx;
+    slice.resize(_nx);
+    for (int ix = 0; ix < _nx; ++ix) {
+        slice[ix] = row0[ix] + w * (row1[ix] - row0[ix]);
+    }
+}
+
+double LocalVolSurface::operator()(double spot, double t) const {
+    std::vector<double> slice;
+    timeSlice(t, slice);
+    return sliceValue(slice, std::log(spot));
+}
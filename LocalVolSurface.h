@@ -0,0 +1,38 @@
+#pragma once
+#include <functional>
+#include <vector>
+
+/*Surface de volatilité locale sigma(S, t), précalculée sur une grille régulière dense en (ln S, t).
+	L'interpolation est bilinéaire ; en dehors du domaine de la grille, la surface est prolongée par
+	ses valeurs au bord. Pour un schéma en temps dont les dates sont connues à l'avance, timeSlice()
+	extrait une fois pour toutes la ligne interpolée en temps : chaque pas ne fait plus qu'une
+	interpolation linéaire en ln S sur un tableau contigu.*/
+class LocalVolSurface {
+private:
+	double _xMin, _dx;	// grille en x = ln S
+	double _tMin, _dt;	// grille en temps
+	int _nx, _nt;		// nombres de points
+	std::vector<double> _grid;	// valeurs, ligne par date : _grid[it * _nx + ix]
+
+public:
+	// Échantillonne la fonction sigma(S, t) sur [spot_min, spot_max] x [0, t_max].
+	LocalVolSurface(const std::function<double(double, double)>& sigma,
+		double spot_min, double spot_max, double t_max,
+		int nb_spot_points = 256, int nb_time_points = 128);
+
+	// Valeur interpolée en (S, t)
+	double operator()(double spot, double t) const;
+
+	// Ligne de la grille interpolée à la date t (nb_spot_points valeurs)
+	void timeSlice(double t, std::vector<double>& slice) const;
+
+	// Interpolation en x = ln S dans une ligne obtenue par timeSlice()
+	double sliceValue(const std::vector<double>& slice, double logSpot) const {
+		double u = (logSpot - _xMin) / _dx;
+		if (u <= 0.0) return slice.front();
+		if (u >= _nx - 1) return slice.back();
+		const int i = static_cast<int>(u);
+		u -= i;
+		return slice[i] + u * (slice[i + 1] - slice[i]);
+	}
+};
@@ -0,0 +1,23 @@
+#pragma once
+#include "LookbackOption.h"
+#include <algorithm>
+#include <vector>
+
+// Option lookback de type Call : S_T - min (strike flottant) ou max(max - K, 0) (strike fixe).
+class LookbackCallOption : public LookbackOption {
+public:
+    // Constructeur : maturité, type de strike, strike (ignoré si flottant) et dates de surveillance (vide : continue).
+    explicit LookbackCallOption(double expiry, strikeType type = Floating, double strike = 0.0,
+        const std::vector<double>& monitoring_dates = {})
+        : LookbackOption(expiry, type, strike, monitoring_dates) {
+    }
+
+    double payoffExtremes(double ST, double minimum, double maximum) const override {
+        return getStrikeType() == Floating ? ST - minimum : std::max(maximum - getStrike(), 0.0);
+    }
+
+    // Indique que l'option est un Call.
+    optionType GetOptionType() const override {
+        return Call;
+    }
+};
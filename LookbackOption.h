@@ -0,0 +1,78 @@
+#pragma once
+#include "Option.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+/*Option lookback européenne : le payoff dépend du minimum ou du maximum du sous-jacent sur la vie de l'option.
+	- strike flottant : S_T - min (Call), max - S_T (Put)
+	- strike fixe : max(max - K, 0) (Call), max(K - min, 0) (Put)
+  Les extrêmes sont pris en continu si aucune date de surveillance n'est fournie (spot initial compris), aux
+  seules dates fournies sinon (la dernière doit être la maturité).*/
+class LookbackOption : public Option {
+public:
+    // Type de l'option lookback
+    enum optionType { Call, Put };
+
+    // Strike flottant (extrême du chemin) ou fixe
+    enum strikeType { Floating, Fixed };
+
+    LookbackOption(double expiry, strikeType type, double strike, const std::vector<double>& monitoring_dates)
+        : Option(expiry), _type(type), _strike(strike), _monitoringDates(monitoring_dates)
+    {
+        if (strike < 0.0) {
+            throw std::invalid_argument("Strike must be non-negative.");
+        }
+        // Dates de surveillance strictement croissantes, la dernière étant la maturité
+        double t_prev = 0.0;
+        for (const double t : _monitoringDates) {
+            if (t <= t_prev) {
+                throw std::invalid_argument("Monitoring dates must be positive and strictly increasing.");
+            }
+            t_prev = t;
+        }
+        if (!_monitoringDates.empty() && _monitoringDates.back() != expiry) {
+            throw std::invalid_argument("The last monitoring date must be the expiry.");
+        }
+    }
+
+    bool isLookbackOption() const override {
+        return true;
+    }
+
+    // Accès en lecture
+    strikeType getStrikeType() const { return _type; }
+    double getStrike() const { return _strike; }
+    const std::vector<double>& getMonitoringDates() const { return _monitoringDates; }
+    bool isContinuouslyMonitored() const { return _monitoringDates.empty(); }
+
+    // Retourne le type de l'option (Call ou Put)
+    virtual optionType GetOptionType() const = 0;
+
+    // Indique l'extrême utilisé par le payoff : le minimum (Call flottant, Put fixe) ou le maximum
+    bool usesMinimum() const {
+        return (GetOptionType() == Call) == (_type == Floating);
+    }
+
+    // Payoff à maturité connaissant S_T et les extrêmes du chemin (défini dans LookbackCallOption/LookbackPutOption)
+    virtual double payoffExtremes(double ST, double minimum, double maximum) const = 0;
+
+    // Payoff d'un chemin réduit au seul point S
+    double payoff(double S) const override {
+        return payoffExtremes(S, S, S);
+    }
+
+    // Payoff path-dependent : extrêmes du chemin (dates de surveillance).
+    double payoffPath(const std::vector<double>& path) const override {
+        if (path.empty()) {
+            throw std::invalid_argument("Path is empty.");
+        }
+        const auto extremes = std::minmax_element(path.begin(), path.end());
+        return payoffExtremes(path.back(), *extremes.first, *extremes.second);
+    }
+
+private:
+    strikeType _type;
+    double _strike;     // utilisé seulement pour un strike fixe
+    std::vector<double> _monitoringDates;  // vide : surveillance continue
+};
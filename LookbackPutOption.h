@@ -0,0 +1,23 @@
+#pragma once
+#include "LookbackOption.h"
+#include <algorithm>
+#include <vector>
+
+// Option lookback de type Put : max - S_T (strike flottant) ou max(K - min, 0) (strike fixe).
+class LookbackPutOption : public LookbackOption {
+public:
+    // Constructeur : maturité, type de strike, strike (ignoré si flottant) et dates de surveillance (vide : continue).
+    explicit LookbackPutOption(double expiry, strikeType type = Floating, double strike = 0.0,
+        const std::vector<double>& monitoring_dates = {})
+        : LookbackOption(expiry, type, strike, monitoring_dates) {
+    }
+
+    double payoffExtremes(double ST, double minimum, double maximum) const override {
+        return getStrikeType() == Floating ? maximum - ST : std::max(getStrike() - minimum, 0.0);
+    }
+
+    // Indique que l'option est un Put.
+    optionType GetOptionType() const override {
+        return Put;
+    }
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <stdexcept>
+#include <string>
+
+/*État d'un estimateur Monte Carlo incrémental (algorithme de Welford) :
+	nombre de tirages, moyenne courante et somme des carrés des écarts (M2).
+	Deux états issus de tirages indépendants se combinent exactement par merge() (formule de Chan et al.),
+	ce qui permet de répartir un calcul entre plusieurs processus puis d'agréger les résultats. Un tirage peut être la
+	moyenne d'un lot stratifié de strata trajectoires : seuls des états de même stratification se combinent.*/
+struct MCEstimatorState {
+	long long nbPaths = 0;	// nombre de tirages
+	double estimate = 0.0;	// moyenne courante
+	double M2 = 0.0;		// somme des carrés des écarts à la moyenne
+	int strata = 1;			// trajectoires par tirage (1 hors échantillonnage stratifié)
+	std::string rngState;	// position du générateur (MT::getState()), vide si non capturée
+
+	// Ajoute un tirage (mise à jour de Welford)
+	void add(double x) {
+		++nbPaths;
+		const double delta = x - estimate;
+		estimate += delta / static_cast<double>(nbPaths);
+		M2 += delta * (x - estimate);
+	}
+
+	// Combine avec l'état d'une autre série de tirages indépendants ; un état vide prend la stratification de l'autre
+	void merge(const MCEstimatorState& other) {
+		if (other.nbPaths == 0) return;
+		if (nbPaths == 0) {
+			nbPaths = other.nbPaths;
+			estimate = other.estimate;
+			M2 = other.M2;
+			strata = other.strata;
+			return;
+		}
+		if (strata != other.strata) {
+			throw std::invalid_argument("Cannot merge estimator states with different strata.");
+		}
+		const double na = static_cast<double>(nbPaths);
+		const double nb = static_cast<double>(other.nbPaths);
+		const double n = na + nb;
+		const double delta = other.estimate - estimate;
+
+		estimate += delta * nb / n;
+		M2 += other.M2 + delta * delta * na * nb / n;
+		nbPaths += other.nbPaths;
+	}
+
+	// Variance empirique (non biaisée) des tirages
+	double variance() const {
+		if (nbPaths < 2) {
+			throw std::runtime_error("At least two paths are required to compute the variance.");
+		}
+		return M2 / static_cast<double>(nbPaths - 1);
+	}
+};
@@ -1,3 +1,3 @@
 #include "MT.h"
 
-std::mt19937 MT::mt(std::random_device{}());
\ No newline at end of file
+thread_local std::mt19937 MT::mt(std::random_device{}());
\ No newline at end of file
@@ -1,28 +1,57 @@
 #pragma once
+#include <cstdint>
 #include <random>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 
-// Gnrateur de nombres alatoires bas sur le moteur Mersenne Twister.Cette classe est utilise pour les simulations Monte Carlo.
+// Générateur de nombres aléatoires basé sur le moteur Mersenne Twister.Cette classe est utilisée pour les simulations Monte Carlo.
 class MT {
 private:
-	// Moteur pseudo-alatoire Mersenne Twister partag
-	static std::mt19937 mt;
-	// Constructeur priv pour empcher l'instanciation
+	/*Moteur pseudo-aléatoire Mersenne Twister, un par thread (graine aléatoire propre à chaque thread) : des
+	  simulations exécutées en parallèle (PricingScheduler) ne se partagent pas le moteur. seed(), getState()
+	  et setState() portent sur le moteur du thread appelant.*/
+	static thread_local std::mt19937 mt;
+	// Constructeur privé pour empêcher l'instanciation
 	MT() = default; 
 
 public:
 	MT(const MT&) = delete; // Suppression du constructeur de copie
-	MT& operator=(const MT&) = delete;  // Suppression de l'oprateur d'affectation
+	MT& operator=(const MT&) = delete;  // Suppression de l'opérateur d'affectation
 
-	// Gnre une variable alatoire uniforme sur [0,1]
+	// Génère une variable aléatoire uniforme sur [0,1]
 	static double rand_unif() {
 		 std::uniform_real_distribution<double> dist(0.0, 1.0);
 		return dist(mt);
 	}
 
-	// Gnre une variable alatoire suivant une loi normale standard N(0,1)
+	// Génère une variable aléatoire suivant une loi normale standard N(0,1)
 	static double rand_norm() {
 		 std::normal_distribution<double> dist(0.0, 1.0);
 		return dist(mt);
 	}
+
+	// Réinitialise le générateur avec une graine donnée (ex : une graine différente par processus pour répartir un calcul)
+	static void seed(std::uint32_t s) {
+		mt.seed(s);
+	}
+
+	// Position courante dans la suite pseudo-aléatoire, sous forme textuelle (état complet du moteur).
+	// Les distributions étant recréées à chaque tirage, l'état du moteur suffit à reproduire la suite.
+	static std::string getState() {
+		std::ostringstream os;
+		os << mt;
+		return os.str();
+	}
+
+	// Restaure une position obtenue par getState()
+	static void setState(const std::string& state) {
+		std::istringstream is(state);
+		std::mt19937 restored;
+		is >> restored;
+		if (!is) {
+			throw std::invalid_argument("Invalid Mersenne Twister state.");
+		}
+		mt = restored;
+	}
 };
@@ -0,0 +1,144 @@
+#include "MappedFile.h"
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+// Ouverture et projection du fichier (API Win32).
+MappedFile::MappedFile(const std::string& path)
+    : _data(nullptr), _size(0), _fileHandle(nullptr), _mappingHandle(nullptr)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    _fileHandle = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        release();
+        throw std::runtime_error("Cannot read file size: " + path);
+    }
+    _size = static_cast<std::size_t>(size.QuadPart);
+
+    // Un fichier vide ne peut pas être projeté : on le représente par une zone vide.
+    if (_size == 0) return;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        release();
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+    _mappingHandle = mapping;
+
+    _data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!_data) {
+        release();
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+}
+
+void MappedFile::release() {
+    if (_data) UnmapViewOfFile(_data);
+    if (_mappingHandle) CloseHandle(static_cast<HANDLE>(_mappingHandle));
+    if (_fileHandle) CloseHandle(static_cast<HANDLE>(_fileHandle));
+    _data = nullptr;
+    _mappingHandle = nullptr;
+    _fileHandle = nullptr;
+    _size = 0;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : _data(std::exchange(other._data, nullptr)),
+    _size(std::exchange(other._size, 0)),
+    _fileHandle(std::exchange(other._fileHandle, nullptr)),
+    _mappingHandle(std::exchange(other._mappingHandle, nullptr))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+        _fileHandle = std::exchange(other._fileHandle, nullptr);
+        _mappingHandle = std::exchange(other._mappingHandle, nullptr);
+    }
+    return *this;
+}
+
+#else
+
+// Ouverture et projection du fichier (API POSIX).
+MappedFile::MappedFile(const std::string& path)
+    : _data(nullptr), _size(0), _fd(-1)
+{
+    _fd = ::open(path.c_str(), O_RDONLY);
+    if (_fd < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    struct stat st;
+    if (::fstat(_fd, &st) != 0) {
+        release();
+        throw std::runtime_error("Cannot read file size: " + path);
+    }
+    _size = static_cast<std::size_t>(st.st_size);
+
+    // Un fichier vide ne peut pas être projeté : on le représente par une zone vide.
+    if (_size == 0) return;
+
+    void* p = ::mmap(nullptr, _size, PROT_READ, MAP_SHARED, _fd, 0);
+    if (p == MAP_FAILED) {
+        release();
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+    _data = static_cast<const unsigned char*>(p);
+
+    // Lecture essentiellement séquentielle des enregistrements
+    ::madvise(p, _size, MADV_SEQUENTIAL);
+}
+
+void MappedFile::release() {
+    if (_data) ::munmap(const_cast<unsigned char*>(_data), _size);
+    if (_fd >= 0) ::close(_fd);
+    _data = nullptr;
+    _fd = -1;
+    _size = 0;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : _data(std::exchange(other._data, nullptr)),
+    _size(std::exchange(other._size, 0)),
+    _fd(std::exchange(other._fd, -1))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+        _fd = std::exchange(other._fd, -1);
+    }
+    return *this;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    release();
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Projection en mémoire (mmap) d'un fichier en lecture seule.
+// Le contenu est accessible directement via data() sans copie ; la projection est libérée à la destruction.
+class MappedFile {
+private:
+	const unsigned char* _data;	// Début de la zone projetée
+	std::size_t _size;			// Taille du fichier en octets
+#ifdef _WIN32
+	void* _fileHandle;			// HANDLE du fichier
+	void* _mappingHandle;		// HANDLE de la projection
+#else
+	int _fd;					// Descripteur du fichier
+#endif
+
+	// Libère la projection et ferme les descripteurs.
+	void release();
+
+public:
+	// Ouvre et projette le fichier. Lève std::runtime_error si l'ouverture ou la projection échoue.
+	explicit MappedFile(const std::string& path);
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	~MappedFile();
+
+	// Accès en lecture au contenu projeté
+	const unsigned char* data() const { return _data; }
+
+	// Taille du fichier en octets
+	std::size_t size() const { return _size; }
+};
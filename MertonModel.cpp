@@ -0,0 +1,20 @@
+#include "MertonModel.h"
+#include <cmath>
+#include <stdexcept>
+
+MertonModel::MertonModel(double volatility, double jump_intensity, double jump_mean, double jump_volatility)
+    : _sigma(volatility), _lambda(jump_intensity), _muJ(jump_mean), _deltaJ(jump_volatility)
+{
+    if (_sigma <= 0.0) throw std::invalid_argument("Volatility must be positive.");
+    if (_lambda < 0.0) throw std::invalid_argument("Jump intensity must be non-negative.");
+    if (_deltaJ < 0.0) throw std::invalid_argument("Jump volatility must be non-negative.");
+}
+
+/*phi(u) = exp(T [ i u (-sigma^2 / 2 - lambda k) - sigma^2 u^2 / 2 + lambda (exp(i u mu_J - delta_J^2 u^2 / 2) - 1) ])
+  avec k = exp(mu_J + delta_J^2 / 2) - 1 la taille moyenne des sauts (compensation).*/
+std::complex<double> MertonModel::characteristicFunction(std::complex<double> u, double expiry) const {
+    const std::complex<double> i(0.0, 1.0);
+    const double k = std::exp(_muJ + 0.5 * _deltaJ * _deltaJ) - 1.0;
+    const std::complex<double> jump = std::exp(i * u * _muJ - 0.5 * _deltaJ * _deltaJ * u * u) - 1.0;
+    return std::exp(expiry * (i * u * (-0.5 * _sigma * _sigma - _lambda * k) - 0.5 * _sigma * _sigma * u * u + _lambda * jump));
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include "CharacteristicFunctionModel.h"
+
+/*Modèle à sauts de Merton : diffusion log-normale de volatilité sigma et sauts de Poisson d'intensité lambda,
+	de taille log-normale ln(1 + J) ~ N(mu_J, delta_J^2). La dérive est compensée pour que exp(X_T) soit une martingale.*/
+class MertonModel : public CharacteristicFunctionModel {
+private:
+	double _sigma;	// volatilité de la diffusion
+	double _lambda;	// intensité des sauts
+	double _muJ;	// moyenne du log-saut
+	double _deltaJ;	// écart-type du log-saut
+
+public:
+	MertonModel(double volatility, double jump_intensity, double jump_mean, double jump_volatility);
+
+	double getVolatility() const { return _sigma; }
+	double getJumpIntensity() const { return _lambda; }
+	double getJumpMean() const { return _muJ; }
+	double getJumpVolatility() const { return _deltaJ; }
+
+	std::complex<double> characteristicFunction(std::complex<double> u, double expiry) const override;
+};
@@ -0,0 +1,271 @@
+#include "MultiAssetMCPricer.h"
+#include "MultiAssetOption.h"
+#include "MT.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+    /*Décomposition spectrale d'une matrice symétrique n x n (méthode de Jacobi cyclique) : a = V diag(w) V^T,
+      les vecteurs propres étant les colonnes de v (rangée par ligne). Suffisant pour les tailles d'un panier.*/
+    void symmetricEigen(std::vector<double> a, std::size_t n, std::vector<double>& w, std::vector<double>& v) {
+        v.assign(n * n, 0.0);
+        for (std::size_t i = 0; i < n; ++i) v[i * n + i] = 1.0;
+
+        for (int sweep = 0; sweep < 100; ++sweep) {
+            double off = 0.0;
+            for (std::size_t p = 0; p < n; ++p)
+                for (std::size_t q = p + 1; q < n; ++q) off += a[p * n + q] * a[p * n + q];
+            if (off < 1e-30) break;
+
+            for (std::size_t p = 0; p < n; ++p) {
+                for (std::size_t q = p + 1; q < n; ++q) {
+                    const double apq = a[p * n + q];
+                    if (std::abs(apq) < 1e-300) continue;
+
+                    // Rotation annulant a(p,q)
+                    const double theta = 0.5 * (a[q * n + q] - a[p * n + p]) / apq;
+                    const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                    const double c = 1.0 / std::sqrt(t * t + 1.0);
+                    const double s = t * c;
+
+                    for (std::size_t k = 0; k < n; ++k) {
+                        const double akp = a[k * n + p], akq = a[k * n + q];
+                        a[k * n + p] = c * akp - s * akq;
+                        a[k * n + q] = s * akp + c * akq;
+                    }
+                    for (std::size_t k = 0; k < n; ++k) {
+                        const double apk = a[p * n + k], aqk = a[q * n + k];
+                        a[p * n + k] = c * apk - s * aqk;
+                        a[q * n + k] = s * apk + c * aqk;
+                    }
+                    for (std::size_t k = 0; k < n; ++k) {
+                        const double vkp = v[k * n + p], vkq = v[k * n + q];
+                        v[k * n + p] = c * vkp - s * vkq;
+                        v[k * n + q] = s * vkp + c * vkq;
+                    }
+                }
+            }
+        }
+
+        w.resize(n);
+        for (std::size_t i = 0; i < n; ++i) w[i] = a[i * n + i];
+    }
+}
+
+MultiAssetMCPricer::MultiAssetMCPricer(Option* option,
+    const std::vector<double>& initial_prices,
+    double interest_rate,
+    const std::vector<double>& volatilities,
+    const std::vector<std::vector<double>>& correlation)
+    : _option(option),
+    _S0(initial_prices),
+    _sigma(volatilities),
+    _r(interest_rate),
+    _nbAssets(initial_prices.size()),
+    _nbFactors(0),
+    _usesPCA(false)
+{
+    // Vérification de la validité des paramètres
+    if (!_option) {
+        throw std::invalid_argument("Option pointer is null.");
+    }
+    if (_nbAssets == 0) {
+        throw std::invalid_argument("At least one initial price is required.");
+    }
+    if (_sigma.size() != _nbAssets) {
+        throw std::invalid_argument("One volatility per underlying is required.");
+    }
+    const std::size_t expected = _option->isMultiAssetOption() ? static_cast<const MultiAssetOption*>(_option)->getNbAssets() : 1;
+    if (expected != _nbAssets) {
+        throw std::invalid_argument("Number of underlyings does not match the option.");
+    }
+    if (_option->isAmericanOption() || _option->isAsianOption() || _option->isBarrierOption() || _option->isLookbackOption()) {
+        throw std::invalid_argument("Multi-asset Monte Carlo only prices European payoffs.");
+    }
+    for (std::size_t a = 0; a < _nbAssets; ++a) {
+        if (_S0[a] <= 0.0) {
+            throw std::invalid_argument("Initial prices must be positive.");
+        }
+        if (_sigma[a] < 0.0) {
+            throw std::invalid_argument("Volatilities must be non-negative.");
+        }
+    }
+
+    factorize(correlation);
+}
+
+/*Cholesky si tous les pivots sont strictement positifs ; sinon (matrice seulement semi-définie, ou incohérente
+  après estimation), ACP : C = V diag(w) V^T, facteurs V_f sqrt(max(w_f, 0)) par valeur propre décroissante,
+  les facteurs négligeables étant abandonnés, puis renormalisation des lignes pour retrouver une diagonale unité.*/
+void MultiAssetMCPricer::factorize(const std::vector<std::vector<double>>& correlation) {
+    const std::size_t n = _nbAssets;
+    if (correlation.size() != n) {
+        throw std::invalid_argument("Correlation matrix size does not match the number of underlyings.");
+    }
+    std::vector<double> C(n * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (correlation[i].size() != n) {
+            throw std::invalid_argument("Correlation matrix must be square.");
+        }
+        for (std::size_t j = 0; j < n; ++j) C[i * n + j] = correlation[i][j];
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::abs(C[i * n + i] - 1.0) > 1e-12) {
+            throw std::invalid_argument("Correlation matrix must have a unit diagonal.");
+        }
+        for (std::size_t j = 0; j < i; ++j) {
+            if (std::abs(C[i * n + j] - C[j * n + i]) > 1e-12) {
+                throw std::invalid_argument("Correlation matrix must be symmetric.");
+            }
+            if (std::abs(C[i * n + j]) > 1.0) {
+                throw std::invalid_argument("Correlations must lie in [-1, 1].");
+            }
+        }
+    }
+
+    // Cholesky
+    std::vector<double> L(n * n, 0.0);
+    bool positive = true;
+    for (std::size_t j = 0; j < n && positive; ++j) {
+        double d = C[j * n + j];
+        for (std::size_t k = 0; k < j; ++k) d -= L[j * n + k] * L[j * n + k];
+        if (d <= 1e-12) {
+            positive = false;
+            break;
+        }
+        L[j * n + j] = std::sqrt(d);
+        for (std::size_t i = j + 1; i < n; ++i) {
+            double x = C[i * n + j];
+            for (std::size_t k = 0; k < j; ++k) x -= L[i * n + k] * L[j * n + k];
+            L[i * n + j] = x / L[j * n + j];
+        }
+    }
+    if (positive) {
+        _factor = std::move(L);
+        _nbFactors = n;
+        _usesPCA = false;
+        return;
+    }
+
+    // ACP
+    std::vector<double> w, V;
+    symmetricEigen(C, n, w, V);
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&w](std::size_t a, std::size_t b) { return w[a] > w[b]; });
+
+    const double largest = std::max(w[order[0]], 0.0);
+    std::size_t nbFactors = 0;
+    while (nbFactors < n && w[order[nbFactors]] > 1e-12 * largest) ++nbFactors;
+    if (nbFactors == 0) {
+        throw std::invalid_argument("Correlation matrix has no positive eigenvalue.");
+    }
+
+    _factor.assign(n * nbFactors, 0.0);
+    for (std::size_t i = 0; i < n; ++i) {
+        double norm = 0.0;
+        for (std::size_t f = 0; f < nbFactors; ++f) {
+            const double x = V[i * n + order[f]] * std::sqrt(w[order[f]]);
+            _factor[i * nbFactors + f] = x;
+            norm += x * x;
+        }
+        if (norm > 0.0) {
+            const double scale = 1.0 / std::sqrt(norm);
+            for (std::size_t f = 0; f < nbFactors; ++f) _factor[i * nbFactors + f] *= scale;
+        }
+    }
+    _nbFactors = nbFactors;
+    _usesPCA = true;
+}
+
+// Génère nb_paths trajectoires supplémentaires par blocs et met à jour l'estimation (Welford).
+void MultiAssetMCPricer::generate(int nb_paths) {
+    if (nb_paths <= 0) {
+        throw std::invalid_argument("Number of paths must be positive.");
+    }
+
+    TELEMETRY_SCOPE(MCGenerate);
+
+    const std::size_t A = _nbAssets, F = _nbFactors, B = BLOCK;
+    const double T = _option->getExpiry();
+    const double discount = std::exp(-_r * T);
+
+    // Dérive et diffusion de ln S_a sur [0, T]
+    std::vector<double> drift(A), diffusion(A);
+    for (std::size_t a = 0; a < A; ++a) {
+        drift[a] = std::log(_S0[a]) + (_r - 0.5 * _sigma[a] * _sigma[a]) * T;
+        diffusion[a] = _sigma[a] * std::sqrt(T);
+    }
+
+    // Tampons : Z (facteurs x chemins), tenseur (actifs x chemins), chemin d'une trajectoire
+    if (_normals.size() < F * B) {
+        TELEMETRY_COUNT(Allocations, 1);
+        _normals.resize(F * B);
+        _tensor.resize(A * B);
+        _path.resize(A);
+    }
+    double* Z = _normals.data();
+    double* X = _tensor.data();
+
+    for (int start = 0; start < nb_paths; start += BLOCK) {
+        const std::size_t nb = static_cast<std::size_t>(std::min(BLOCK, nb_paths - start));
+
+        {
+            TELEMETRY_SCOPE(MCRng);
+            for (std::size_t f = 0; f < F; ++f)
+                for (std::size_t p = 0; p < nb; ++p) Z[f * B + p] = MT::rand_norm();
+        }
+
+        {
+            TELEMETRY_SCOPE(MCPathBuild);
+            // ln S_a(T) = drift_a + diffusion_a (L Z)_a : produit matriciel ligne par ligne, chemins contigus
+            for (std::size_t a = 0; a < A; ++a) {
+                double* x = X + a * B;
+                std::fill(x, x + nb, drift[a]);
+                const std::size_t fEnd = _usesPCA ? F : a + 1;	// L triangulaire inférieure (Cholesky)
+                for (std::size_t f = 0; f < fEnd; ++f) {
+                    const double c = diffusion[a] * _factor[a * F + f];
+                    const double* z = Z + f * B;
+                    for (std::size_t p = 0; p < nb; ++p) x[p] += c * z[p];
+                }
+                for (std::size_t p = 0; p < nb; ++p) x[p] = std::exp(x[p]);
+            }
+        }
+
+        TELEMETRY_SCOPE(MCPayoff);
+        for (std::size_t p = 0; p < nb; ++p) {
+            for (std::size_t a = 0; a < A; ++a) _path[a] = X[a * B + p];
+            _state.add(discount * _option->payoffPaths(_path, A));
+        }
+    }
+
+    TELEMETRY_COUNT(PathsGenerated, nb_paths);
+    TELEMETRY_COUNT(RngDraws, static_cast<long long>(nb_paths) * static_cast<long long>(F));
+}
+
+// Retourne l'estimation courante du prix.Une exception est levée si aucun chemin n'a été généré.
+double MultiAssetMCPricer::operator()() const {
+    if (_state.nbPaths == 0) {
+        throw std::runtime_error("No paths generated. Call generate() before pricing.");
+    }
+    return _state.estimate;
+}
+
+// Calcule l'intervalle de confiance à 95 % autour de l'estimation.
+std::vector<double> MultiAssetMCPricer::confidenceInterval() const {
+    if (_state.nbPaths < 2) {
+        throw std::runtime_error("At least two paths are required to compute confidence interval.");
+    }
+    const double stddev = std::sqrt(_state.variance());
+    const double margin = 1.96 * stddev / std::sqrt(static_cast<double>(_state.nbPaths));
+    return { _state.estimate - margin, _state.estimate + margin };
+}
+
+MCEstimatorState MultiAssetMCPricer::getState() const {
+    MCEstimatorState state = _state;
+    state.rngState = MT::getState();
+    return state;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "Option.h"
+#include "MCEstimatorState.h"
+#include <cstddef>
+#include <vector>
+
+/*Pricer Monte Carlo multi-actifs sous Black-Scholes : n sous-jacents log-normaux (spots et volatilités
+	propres, taux commun) dont les browniens sont corrélés par la matrice de corrélation fournie.
+	La matrice est factorisée une fois à la construction, C = L L^T : Cholesky si elle est définie positive,
+	sinon décomposition spectrale (ACP) dont les valeurs propres négatives sont annulées et les lignes
+	renormalisées (corrélation valide la plus proche, au sens de la diagonale). Seuls les facteurs non nuls
+	sont conservés : des actifs parfaitement corrélés ne coûtent qu'un tirage.
+	Les payoffs ne dépendant que des valeurs à maturité, chaque trajectoire est simulée exactement en un pas.
+	Les trajectoires sont traitées par blocs de BLOCK chemins : les gaussiennes indépendantes Z (facteurs x
+	chemins) sont corrélées par le produit matriciel L Z, et le tenseur des chemins est rangé par actif, les
+	chemins d'un même actif étant contigus (boucles internes vectorisables). Le payoff est évalué par
+	Option::payoffPaths() ; une option sur un seul sous-jacent est aussi acceptée.*/
+class MultiAssetMCPricer {
+private:
+	Option* _option;	// option à pricer
+	std::vector<double> _S0;	// spots initiaux
+	std::vector<double> _sigma;	// volatilités
+	double _r;		// taux sans risque
+
+	std::size_t _nbAssets;
+	std::size_t _nbFactors;		// nombre de facteurs retenus (colonnes de L)
+	std::vector<double> _factor;	// L, nbAssets x nbFactors, rangée par ligne
+	bool _usesPCA;		// factorisation spectrale (matrice non définie positive)
+
+	MCEstimatorState _state;	// estimateur courant (moyenne et M2 des payoffs actualisés)
+
+	// Tampons réutilisés d'un appel à l'autre
+	std::vector<double> _normals, _logSpots, _tensor, _path;
+
+	// Factorise la matrice de corrélation (Cholesky, puis ACP en cas d'échec)
+	void factorize(const std::vector<std::vector<double>>& correlation);
+
+public:
+	static const int BLOCK = 256;	// chemins simulés ensemble
+
+	MultiAssetMCPricer(Option* option, const std::vector<double>& initial_prices, double interest_rate,
+		const std::vector<double>& volatilities, const std::vector<std::vector<double>>& correlation);
+
+	// Nombre de facteurs et méthode de factorisation retenus
+	std::size_t getNbFactors() const { return _nbFactors; }
+	bool usesPCA() const { return _usesPCA; }
+
+	// Facteur L (nbAssets x nbFactors, rangé par ligne) : L L^T est la corrélation effectivement simulée
+	const std::vector<double>& getFactor() const { return _factor; }
+
+	// Accès en lecture au nombre de chemins générés
+	long long getNbPaths() const { return _state.nbPaths; }
+
+	// Génère nb_paths trajectoires supplémentaires et met à jour l'estimation.
+	void generate(int nb_paths);
+
+	// Retourne l'estimation courante
+	double operator()() const;
+
+	// Retourne l'intervalle de confiance à 95% sous la forme [borne_inf, borne_sup]
+	std::vector<double> confidenceInterval() const;
+
+	// État de l'estimateur, avec la position courante du générateur MT
+	MCEstimatorState getState() const;
+
+	// Agrège les tirages d'une exécution indépendante (autre processus, autre graine) sur le même problème.
+	void merge(const MCEstimatorState& other) { _state.merge(other); }
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include "Option.h"
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+/*Option européenne sur plusieurs sous-jacents : le payoff (défini dans les classes Call/Put) s'applique à une
+  valeur agrégée des sous-jacents à maturité (panier, écart, meilleur ou pire des actifs).
+  Les chemins sont transmis par Option::payoffPaths(), rangés par actif : paths[a * m + k] = S_a(t_k).*/
+class MultiAssetOption : public Option {
+private:
+    std::size_t _nbAssets;
+    double _strike;
+
+public:
+    // Type de l'option multi-actifs
+    enum optionType { Call, Put };
+
+    MultiAssetOption(double expiry, std::size_t nb_assets, double strike)
+        : Option(expiry), _nbAssets(nb_assets), _strike(strike)
+    {
+        if (nb_assets == 0) {
+            throw std::invalid_argument("A multi-asset option needs at least one underlying.");
+        }
+        if (strike < 0.0) {
+            throw std::invalid_argument("Strike must be non-negative.");
+        }
+    }
+
+    bool isMultiAssetOption() const override {
+        return true;
+    }
+
+    // Accès en lecture
+    std::size_t getNbAssets() const { return _nbAssets; }
+    double getStrike() const { return _strike; }
+
+    // Retourne le type de l'option (Call ou Put)
+    virtual optionType GetOptionType() const = 0;
+
+    // Valeur agrégée des sous-jacents, spots[a] = S_a(T) (définie dans BasketOption, RainbowOption)
+    virtual double aggregate(const double* spots) const = 0;
+
+    // Payoff à maturité : h(agrégat des S_a(T))
+    double payoffTerminal(const double* spots) const {
+        return payoff(aggregate(spots));
+    }
+
+    // Payoff multi-actifs : seules les valeurs à maturité (dernier point de chaque chemin) interviennent.
+    double payoffPaths(const std::vector<double>& paths, std::size_t nb_assets) const override {
+        if (nb_assets != _nbAssets || paths.empty() || paths.size() % nb_assets != 0) {
+            throw std::invalid_argument("Paths do not match the number of underlyings.");
+        }
+        const std::size_t m = paths.size() / nb_assets;
+        if (m == 1) {
+            return payoffTerminal(paths.data());
+        }
+        std::vector<double> terminal(nb_assets);
+        for (std::size_t a = 0; a < nb_assets; ++a) {
+            terminal[a] = paths[a * m + m - 1];
+        }
+        return payoffTerminal(terminal.data());
+    }
+
+    // Un chemin unique n'a de sens que pour une option sur un seul actif
+    double payoffPath(const std::vector<double>& path) const override {
+        return payoffPaths(path, 1);
+    }
+};
@@ -1,37 +1,59 @@
 #pragma once
+#include <cstddef>
 #include <vector>
 #include <stdexcept>
 
-// Classe abstraite reprsentant une option financire.Elle dfinit l'interface commune  toutes les options du projet (europennes, amricaines, asiatiques, etc.).
+// Classe abstraite représentant une option financière.Elle définit l'interface commune à toutes les options du projet (européennes, américaines, asiatiques, etc.).
 class Option {
 private :
-	double _expiry; // Maturit de l'option
+	double _expiry; // Maturité de l'option
 
 public:
 
-    // Constructeur : initialise la maturit de l'option.La validit de expiry (>= 0) est vrifie dans l'implmentation.
+    // Constructeur : initialise la maturité de l'option.La validité de expiry (>= 0) est vérifiée dans l'implémentation.
 	explicit Option(double expiry);// constructor
 
-    // Accesseur en lecture de la maturit
+    // Accesseur en lecture de la maturité
 	double getExpiry() const;
 
-    // Payoff dpendant uniquement du prix final du sous-jacent.Mthode pure virtuelle : chaque option concrte doit l'implmenter.
+    // Payoff dépendant uniquement du prix final du sous-jacent.Méthode pure virtuelle : chaque option concrète doit l'implémenter.
 	virtual double payoff(double spot) const = 0;
 
-    // Payoff dpendant d'un chemin de prix.Par dfaut, on considre un payoff europen classique : h(S_T), o S_T est la dernire valeur du chemin.
-   // Les options path-dependent (ex : asiatiques) redfinissent cette mthode.
+    // Payoff dépendant d'un chemin de prix.Par défaut, on considère un payoff européen classique : h(S_T), où S_T est la dernière valeur du chemin.
+   // Les options path-dependent (ex : asiatiques) redéfinissent cette méthode.
     virtual double payoffPath(const std::vector<double>& path) const {
         if (path.empty())
             throw std::invalid_argument("Empty path provided to payoffPath().");
         return payoff(path.back()); // h(S_tm)
     }
 
+    // Payoff sur plusieurs sous-jacents : nb_assets chemins de même longueur m, rangés par actif
+    // (paths[a * m + k] = S_a(t_k)). Par défaut, l'option ne porte que sur un seul sous-jacent.
+    virtual double payoffPaths(const std::vector<double>& paths, std::size_t nb_assets) const {
+        if (nb_assets != 1) {
+            throw std::invalid_argument("Option has a single underlying.");
+        }
+        return payoffPath(paths);
+    }
+
     // Indique si l'option est de type asiatique 
     virtual bool isAsianOption() const { return false; }
 
-    //Indique si l'option est de type amricaine
+    //Indique si l'option est de type américaine
 	virtual bool isAmericanOption() const { return false; } 
 
+    // Indique si l'option est à barrière
+    virtual bool isBarrierOption() const { return false; }
+
+    // Indique si l'option est de type lookback
+    virtual bool isLookbackOption() const { return false; }
+
+    // Indique si l'option porte sur plusieurs sous-jacents
+    virtual bool isMultiAssetOption() const { return false; }
+
+    // Indique si le payoff est décrit par un script (ScriptedOption)
+    virtual bool isScriptedOption() const { return false; }
+
     // Destructeur virtuel
 	virtual ~Option() = default;// virtual destructor
 
@@ -0,0 +1,326 @@
+#include "OptionBook.h"
+#include "CallOption.h"
+#include "PutOption.h"
+#include "EuropeanDigitalCallOption.h"
+#include "EuropeanDigitalPutOption.h"
+#include "AmericanCallOption.h"
+#include "AmericanPutOption.h"
+#include "AsianCallOption.h"
+#include "AsianPutOption.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    const char BOOK_MAGIC[8] = { 'O', 'P', 'T', 'B', 'O', 'O', 'K', '\0' };
+    const std::uint32_t BYTE_ORDER_TAG = 0x01020304u;
+
+    // Arrondit une position au multiple de 8 supérieur (alignement des sections)
+    inline std::uint64_t align8(std::uint64_t x) {
+        return (x + 7u) & ~std::uint64_t(7u);
+    }
+
+    inline bool isAsianCode(OptionCode code) {
+        return code == OptionCode::AsianCall || code == OptionCode::AsianPut;
+    }
+
+    // Lecture d'un nombre réel dans un champ CSV ; le champ doit être entièrement consommé.
+    double parseDouble(const std::string& field, std::size_t line) {
+        const char* begin = field.c_str();
+        char* end = nullptr;
+        const double value = std::strtod(begin, &end);
+        if (end == begin || *end != '\0') {
+            throw std::invalid_argument("Invalid number '" + field + "' at line " + std::to_string(line) + ".");
+        }
+        return value;
+    }
+
+    // Lecture d'un identifiant entier dans un champ CSV.
+    std::uint64_t parseId(const std::string& field, std::size_t line) {
+        const char* begin = field.c_str();
+        char* end = nullptr;
+        const unsigned long long value = std::strtoull(begin, &end, 10);
+        if (end == begin || *end != '\0') {
+            throw std::invalid_argument("Invalid identifier '" + field + "' at line " + std::to_string(line) + ".");
+        }
+        return static_cast<std::uint64_t>(value);
+    }
+
+    // Découpe une chaîne selon un séparateur.
+    void split(const std::string& s, char sep, std::vector<std::string>& out) {
+        out.clear();
+        std::size_t start = 0;
+        for (;;) {
+            const std::size_t pos = s.find(sep, start);
+            out.push_back(s.substr(start, pos - start));
+            if (pos == std::string::npos) break;
+            start = pos + 1;
+        }
+    }
+}
+
+OptionCode parseOptionCode(const std::string& name) {
+    static const OptionCode codes[] = {
+        OptionCode::EuropeanCall, OptionCode::EuropeanPut, OptionCode::DigitalCall, OptionCode::DigitalPut,
+        OptionCode::AmericanCall, OptionCode::AmericanPut, OptionCode::AsianCall, OptionCode::AsianPut
+    };
+    for (OptionCode code : codes) {
+        if (name == optionCodeName(code)) return code;
+    }
+    throw std::invalid_argument("Unknown option type: " + name);
+}
+
+const char* optionCodeName(OptionCode code) {
+    switch (code) {
+    case OptionCode::EuropeanCall: return "EuropeanCall";
+    case OptionCode::EuropeanPut: return "EuropeanPut";
+    case OptionCode::DigitalCall: return "DigitalCall";
+    case OptionCode::DigitalPut: return "DigitalPut";
+    case OptionCode::AmericanCall: return "AmericanCall";
+    case OptionCode::AmericanPut: return "AmericanPut";
+    case OptionCode::AsianCall: return "AsianCall";
+    case OptionCode::AsianPut: return "AsianPut";
+    }
+    throw std::invalid_argument("Unknown option code.");
+}
+
+// Ajout d'une option : les paramètres sont validés comme le feraient les constructeurs des options.
+void OptionBookWriter::addOption(OptionCode type,
+    std::uint64_t underlyingId,
+    double expiry,
+    double strike,
+    const std::vector<double>& fixings)
+{
+    optionCodeName(type); // vérifie que le code est connu
+
+    if (strike < 0.0) {
+        throw std::invalid_argument("Strike must be non-negative.");
+    }
+
+    OptionRecord record{};
+    record.type = static_cast<std::uint32_t>(type);
+    record.underlyingId = underlyingId;
+    record.strike = strike;
+
+    if (isAsianCode(type)) {
+        if (fixings.empty()) {
+            throw std::invalid_argument("Asian options require at least one fixing date.");
+        }
+        // Pour une option asiatique, la maturité est la dernière date d'observation
+        if (expiry != fixings.back()) {
+            throw std::invalid_argument("Asian option expiry must equal its last fixing date.");
+        }
+        record.expiry = fixings.back();
+        record.fixingIndex = _fixings.size();
+        record.fixingCount = static_cast<std::uint32_t>(fixings.size());
+        _fixings.insert(_fixings.end(), fixings.begin(), fixings.end());
+    }
+    else {
+        if (!fixings.empty()) {
+            throw std::invalid_argument("Fixing dates are only allowed for Asian options.");
+        }
+        record.expiry = expiry;
+        record.fixingIndex = 0;
+        record.fixingCount = 0;
+    }
+
+    if (record.expiry < 0.0) {
+        throw std::invalid_argument("Expiry must be non-negative");
+    }
+
+    _options.push_back(record);
+}
+
+void OptionBookWriter::addMarket(std::uint64_t underlyingId, double spot, double rate, double volatility) {
+    if (spot <= 0.0) throw std::invalid_argument("Asset price must be positive.");
+    if (volatility < 0.0) throw std::invalid_argument("Volatility must be non-negative.");
+    _markets.push_back(MarketRecord{ underlyingId, spot, rate, volatility });
+}
+
+// Écriture du fichier : en-tête, puis les trois sections alignées.
+void OptionBookWriter::write(const std::string& path) const {
+    // Les données de marché sont triées pour permettre la recherche dichotomique à la lecture
+    std::vector<MarketRecord> markets(_markets);
+    std::stable_sort(markets.begin(), markets.end(),
+        [](const MarketRecord& a, const MarketRecord& b) { return a.underlyingId < b.underlyingId; });
+    for (std::size_t i = 1; i < markets.size(); ++i) {
+        if (markets[i].underlyingId == markets[i - 1].underlyingId) {
+            throw std::invalid_argument("Duplicate market data for underlying " + std::to_string(markets[i].underlyingId) + ".");
+        }
+    }
+
+    BookHeader header{};
+    std::memcpy(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC));
+    header.version = OPTION_BOOK_VERSION;
+    header.byteOrder = BYTE_ORDER_TAG;
+    header.optionCount = _options.size();
+    header.marketCount = markets.size();
+    header.fixingCount = _fixings.size();
+    header.optionOffset = align8(sizeof(BookHeader));
+    header.marketOffset = align8(header.optionOffset + header.optionCount * sizeof(OptionRecord));
+    header.fixingOffset = align8(header.marketOffset + header.marketCount * sizeof(MarketRecord));
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    }
+
+    // Écrit un bloc puis complète avec des zéros jusqu'à la position attendue
+    std::uint64_t position = 0;
+    auto writeAt = [&](std::uint64_t offset, const void* data, std::uint64_t bytes) {
+        static const char zeros[8] = {};
+        out.write(zeros, static_cast<std::streamsize>(offset - position));
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        position = offset + bytes;
+    };
+
+    writeAt(0, &header, sizeof(header));
+    writeAt(header.optionOffset, _options.data(), _options.size() * sizeof(OptionRecord));
+    writeAt(header.marketOffset, markets.data(), markets.size() * sizeof(MarketRecord));
+    writeAt(header.fixingOffset, _fixings.data(), _fixings.size() * sizeof(double));
+
+    if (!out) {
+        throw std::runtime_error("Error while writing file: " + path);
+    }
+}
+
+// Ouverture du carnet : seul l'en-tête est lu, les sections restent dans la projection mémoire.
+OptionBookView::OptionBookView(const std::string& path)
+    : _file(path), _header(nullptr), _options(nullptr), _markets(nullptr), _fixings(nullptr)
+{
+    if (_file.size() < sizeof(BookHeader)) {
+        throw std::runtime_error("File is too small to be an option book: " + path);
+    }
+    _header = reinterpret_cast<const BookHeader*>(_file.data());
+
+    if (std::memcmp(_header->magic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) != 0) {
+        throw std::runtime_error("Not an option book file: " + path);
+    }
+    if (_header->byteOrder != BYTE_ORDER_TAG) {
+        throw std::runtime_error("Option book was written with a different byte order: " + path);
+    }
+    if (_header->version != OPTION_BOOK_VERSION) {
+        throw std::runtime_error("Unsupported option book version " + std::to_string(_header->version) + ": " + path);
+    }
+
+    // Vérification que chaque section est alignée et contenue dans le fichier
+    auto checkSection = [&](std::uint64_t offset, std::uint64_t count, std::uint64_t recordSize) {
+        if (offset % 8 != 0 || offset > _file.size() || count > (_file.size() - offset) / recordSize) {
+            throw std::runtime_error("Corrupted option book (section out of bounds): " + path);
+        }
+    };
+    checkSection(_header->optionOffset, _header->optionCount, sizeof(OptionRecord));
+    checkSection(_header->marketOffset, _header->marketCount, sizeof(MarketRecord));
+    checkSection(_header->fixingOffset, _header->fixingCount, sizeof(double));
+
+    _options = reinterpret_cast<const OptionRecord*>(_file.data() + _header->optionOffset);
+    _markets = reinterpret_cast<const MarketRecord*>(_file.data() + _header->marketOffset);
+    _fixings = reinterpret_cast<const double*>(_file.data() + _header->fixingOffset);
+}
+
+const OptionRecord& OptionBookView::option(std::size_t i) const {
+    if (i >= optionCount()) {
+        throw std::out_of_range("Invalid option index");
+    }
+    return _options[i];
+}
+
+const MarketRecord* OptionBookView::findMarket(std::uint64_t underlyingId) const {
+    const MarketRecord* end = _markets + marketCount();
+    const MarketRecord* it = std::lower_bound(_markets, end, underlyingId,
+        [](const MarketRecord& m, std::uint64_t id) { return m.underlyingId < id; });
+    return (it != end && it->underlyingId == underlyingId) ? it : nullptr;
+}
+
+const double* OptionBookView::fixings(const OptionRecord& record) const {
+    if (record.fixingCount == 0) return nullptr;
+    if (record.fixingIndex > _header->fixingCount || record.fixingCount > _header->fixingCount - record.fixingIndex) {
+        throw std::runtime_error("Corrupted option book (fixing range out of bounds).");
+    }
+    return _fixings + record.fixingIndex;
+}
+
+// Construction de l'option à partir de l'enregistrement (les constructeurs revalident les paramètres).
+std::unique_ptr<Option> OptionBookView::createOption(const OptionRecord& record) const {
+    switch (static_cast<OptionCode>(record.type)) {
+    case OptionCode::EuropeanCall: return std::make_unique<CallOption>(record.expiry, record.strike);
+    case OptionCode::EuropeanPut: return std::make_unique<PutOption>(record.expiry, record.strike);
+    case OptionCode::DigitalCall: return std::make_unique<EuropeanDigitalCallOption>(record.expiry, record.strike);
+    case OptionCode::DigitalPut: return std::make_unique<EuropeanDigitalPutOption>(record.expiry, record.strike);
+    case OptionCode::AmericanCall: return std::make_unique<AmericanCallOption>(record.expiry, record.strike);
+    case OptionCode::AmericanPut: return std::make_unique<AmericanPutOption>(record.expiry, record.strike);
+    case OptionCode::AsianCall:
+    case OptionCode::AsianPut: {
+        const double* ts = fixings(record);
+        if (!ts) {
+            throw std::runtime_error("Corrupted option book (Asian option without fixing dates).");
+        }
+        const std::vector<double> timeSteps(ts, ts + record.fixingCount);
+        if (static_cast<OptionCode>(record.type) == OptionCode::AsianCall) {
+            return std::make_unique<AsianCallOption>(timeSteps, record.strike);
+        }
+        return std::make_unique<AsianPutOption>(timeSteps, record.strike);
+    }
+    }
+    throw std::runtime_error("Corrupted option book (unknown option type " + std::to_string(record.type) + ").");
+}
+
+// Conversion CSV -> binaire : une seule passe sur le fichier texte.
+std::size_t convertCsvToOptionBook(const std::string& csvPath, const std::string& bookPath) {
+    std::ifstream in(csvPath);
+    if (!in) {
+        throw std::runtime_error("Cannot open file: " + csvPath);
+    }
+
+    OptionBookWriter writer;
+    std::string line;
+    std::vector<std::string> fields;
+    std::vector<std::string> dateFields;
+    std::vector<double> fixings;
+    std::size_t lineNumber = 0;
+
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') line.pop_back(); // fichiers produits sous Windows
+        if (line.empty() || line[0] == '#') continue;
+
+        split(line, ',', fields);
+        const std::string& kind = fields[0];
+
+        if (kind == "option") {
+            if (fields.size() != 5 && fields.size() != 6) {
+                throw std::invalid_argument("Invalid option line " + std::to_string(lineNumber) + ".");
+            }
+            const OptionCode code = parseOptionCode(fields[2]);
+            fixings.clear();
+            if (fields.size() == 6 && !fields[5].empty()) {
+                split(fields[5], ';', dateFields);
+                for (const std::string& d : dateFields) {
+                    fixings.push_back(parseDouble(d, lineNumber));
+                }
+            }
+            const double expiry = parseDouble(fields[3], lineNumber);
+            if (isAsianCode(code) && !fixings.empty() && expiry != fixings.back()) {
+                throw std::invalid_argument("Asian option expiry differs from its last fixing date at line "
+                    + std::to_string(lineNumber) + ".");
+            }
+            writer.addOption(code, parseId(fields[1], lineNumber), expiry, parseDouble(fields[4], lineNumber), fixings);
+        }
+        else if (kind == "market") {
+            if (fields.size() != 5) {
+                throw std::invalid_argument("Invalid market line " + std::to_string(lineNumber) + ".");
+            }
+            writer.addMarket(parseId(fields[1], lineNumber), parseDouble(fields[2], lineNumber),
+                parseDouble(fields[3], lineNumber), parseDouble(fields[4], lineNumber));
+        }
+        else {
+            throw std::invalid_argument("Unknown record kind '" + kind + "' at line " + std::to_string(lineNumber) + ".");
+        }
+    }
+
+    writer.write(bookPath);
+    return writer.optionCount();
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include "MappedFile.h"
+#include "Option.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*Format binaire versionné pour les carnets d'options et les données de marché.
+	Disposition du fichier (little-endian, sections alignées sur 8 octets) :
+	 - BookHeader
+	 - OptionRecord[optionCount]
+	 - MarketRecord[marketCount] (triés par identifiant de sous-jacent)
+	 - double[fixingCount]		 (dates d'observation des options asiatiques, concaténées)
+ Les enregistrements sont de taille fixe : le fichier est lu par projection mémoire sans aucune analyse.*/
+
+// Type d'option stocké dans un enregistrement.
+enum class OptionCode : std::uint32_t {
+	EuropeanCall = 1,
+	EuropeanPut = 2,
+	DigitalCall = 3,
+	DigitalPut = 4,
+	AmericanCall = 5,
+	AmericanPut = 6,
+	AsianCall = 7,
+	AsianPut = 8
+};
+
+// En-tête du fichier
+struct BookHeader {
+	char magic[8];				// "OPTBOOK" suivi d'un zéro
+	std::uint32_t version;		// Version du format
+	std::uint32_t byteOrder;	// 0x01020304 dans l'ordre natif de l'écrivain
+	std::uint64_t optionCount;	// Nombre d'options
+	std::uint64_t marketCount;	// Nombre de données de marché
+	std::uint64_t fixingCount;	// Nombre total de dates d'observation
+	std::uint64_t optionOffset;	// Position (octets) de la section des options
+	std::uint64_t marketOffset;	// Position (octets) de la section des données de marché
+	std::uint64_t fixingOffset;	// Position (octets) de la section des dates d'observation
+};
+
+// Définition d'une option du carnet
+struct OptionRecord {
+	std::uint32_t type;			// OptionCode
+	std::uint32_t fixingCount;	// Nombre de dates d'observation (options asiatiques uniquement)
+	std::uint64_t fixingIndex;	// Indice de la première date dans la section des dates d'observation
+	std::uint64_t underlyingId;	// Identifiant du sous-jacent (clé vers MarketRecord)
+	double expiry;				// Maturité
+	double strike;				// Strike
+};
+
+// Photographie de marché d'un sous-jacent
+struct MarketRecord {
+	std::uint64_t underlyingId;	// Identifiant du sous-jacent
+	double spot;				// Prix spot
+	double rate;				// Taux sans risque (continu)
+	double volatility;			// Volatilité
+};
+
+static_assert(sizeof(BookHeader) == 64, "Unexpected BookHeader layout.");
+static_assert(sizeof(OptionRecord) == 40, "Unexpected OptionRecord layout.");
+static_assert(sizeof(MarketRecord) == 32, "Unexpected MarketRecord layout.");
+static_assert(std::is_trivially_copyable<OptionRecord>::value && std::is_trivially_copyable<MarketRecord>::value,
+	"Book records must be trivially copyable.");
+
+// Version courante du format
+constexpr std::uint32_t OPTION_BOOK_VERSION = 1;
+
+// Conversion entre le nom textuel d'un type d'option (ex : "AsianCall") et son code.
+OptionCode parseOptionCode(const std::string& name);
+const char* optionCodeName(OptionCode code);
+
+// Écrivain : accumule les enregistrements en mémoire puis écrit le fichier en une seule passe.
+class OptionBookWriter {
+private:
+	std::vector<OptionRecord> _options;
+	std::vector<MarketRecord> _markets;
+	std::vector<double> _fixings;
+
+public:
+	// Ajoute une option. Les dates d'observation ne sont acceptées (et requises) que pour les options asiatiques,
+	// dont la maturité doit être la dernière date d'observation.
+	void addOption(OptionCode type, std::uint64_t underlyingId, double expiry, double strike,
+		const std::vector<double>& fixings = {});
+
+	// Ajoute la photographie de marché d'un sous-jacent.
+	void addMarket(std::uint64_t underlyingId, double spot, double rate, double volatility);
+
+	// Nombre d'options déjà ajoutées
+	std::size_t optionCount() const { return _options.size(); }
+
+	// Écrit le fichier binaire. Lève std::runtime_error en cas d'erreur d'écriture.
+	void write(const std::string& path) const;
+};
+
+// Lecteur : projette le fichier en mémoire et expose des vues directes (sans copie) sur les enregistrements.
+class OptionBookView {
+private:
+	MappedFile _file;
+	const BookHeader* _header;
+	const OptionRecord* _options;
+	const MarketRecord* _markets;
+	const double* _fixings;
+
+public:
+	// Ouvre le fichier et vérifie l'en-tête (signature, version, ordre des octets, bornes des sections).
+	explicit OptionBookView(const std::string& path);
+
+	std::size_t optionCount() const { return static_cast<std::size_t>(_header->optionCount); }
+	std::size_t marketCount() const { return static_cast<std::size_t>(_header->marketCount); }
+
+	// Accès direct aux tableaux d'enregistrements projetés
+	const OptionRecord* options() const { return _options; }
+	const MarketRecord* markets() const { return _markets; }
+
+	// Accès vérifié à l'option i
+	const OptionRecord& option(std::size_t i) const;
+
+	// Recherche (dichotomique) des données de marché d'un sous-jacent. Retourne nullptr si absent.
+	const MarketRecord* findMarket(std::uint64_t underlyingId) const;
+
+	// Pointeur vers les dates d'observation de l'option (record.fixingCount valeurs), nullptr si aucune.
+	const double* fixings(const OptionRecord& record) const;
+
+	// Construit l'objet Option correspondant à l'enregistrement, utilisable directement par les pricers.
+	std::unique_ptr<Option> createOption(const OptionRecord& record) const;
+};
+
+/*Convertit un fichier CSV en carnet binaire. Une ligne par enregistrement :
+	option,<underlyingId>,<type>,<expiry>,<strike>[,<t1;t2;...;tm>]
+	market,<underlyingId>,<spot>,<rate>,<volatility>
+ Pour une option asiatique, <expiry> doit être égale à tm. Les lignes vides et celles commençant par '#' sont
+ ignorées. Retourne le nombre d'options converties.*/
+std::size_t convertCsvToOptionBook(const std::string& csvPath, const std::string& bookPath);
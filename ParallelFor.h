@@ -0,0 +1,53 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <random>
+#include <thread>
+#include <vector>
+
+/*Exécute task(t) pour t = 0, ..., nb_tasks - 1 sur au plus nb_threads threads (le thread appelant compris), les
+  tâches étant distribuées dynamiquement par un compteur atomique. Si une tâche lève une exception, les autres
+  threads s'arrêtent à leur tâche suivante et la première exception (dans l'ordre des threads) est relancée une
+  fois tous les threads terminés. L'ordre d'exécution n'est pas déterministe : chaque tâche écrit son résultat
+  dans sa propre case, que l'appelant agrège ensuite dans l'ordre des tâches.*/
+template <typename Task>
+void parallelFor(int nb_tasks, int nb_threads, Task&& task) {
+	if (nb_tasks <= 0) return;
+	const int nbThreads = std::max(1, std::min(nb_threads, nb_tasks));
+
+	std::atomic<int> next(0);
+	std::vector<std::exception_ptr> errors(nbThreads);
+	auto worker = [&](int id) {
+		try {
+			for (int t = next++; t < nb_tasks; t = next++) {
+				task(t);
+			}
+		}
+		catch (...) {
+			errors[id] = std::current_exception();
+			next = nb_tasks; // les autres threads s'arrêtent à la tâche suivante
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (int id = 1; id < nbThreads; ++id) {
+		threads.emplace_back(worker, id);
+	}
+	worker(0);
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	for (const std::exception_ptr& error : errors) {
+		if (error) std::rethrow_exception(error);
+	}
+}
+
+/*Générateur propre au lot chunk d'une simulation de graine seed : le flux d'un lot ne dépend que de (seed, chunk),
+  si bien que le résultat est le même quel que soit le nombre de threads.*/
+inline std::mt19937_64 chunkGenerator(std::uint64_t seed, std::uint64_t chunk) {
+	std::seed_seq seq{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+		static_cast<std::uint32_t>(chunk), static_cast<std::uint32_t>(chunk >> 32) };
+	return std::mt19937_64(seq);
+}
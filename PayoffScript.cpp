@@ -0,0 +1,699 @@
+#include "PayoffScript.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+    const char* const OP_NAMES[] = { "const", "neg", "not", "exp", "log", "sqrt", "abs", "add", "sub", "mul", "div",
+        "max", "min", "lt", "le", "gt", "ge", "eq", "ne", "and", "or", "select", "sum", "rmax", "rmin" };
+
+    struct Token {
+        enum kind { Number, Name, Symbol, End };
+        kind type;
+        std::string text;
+        double value;
+        int line, column;
+    };
+
+    [[noreturn]] void fail(int line, int column, const std::string& message) {
+        std::ostringstream os;
+        os << "Payoff script error at line " << line << ", column " << column << ": " << message;
+        throw std::invalid_argument(os.str());
+    }
+
+    std::vector<Token> tokenize(const std::string& source) {
+        static const char* const SYMBOLS[] = { "<=", ">=", "==", "!=", "<", ">", "+", "-", "*", "/", "(", ")",
+            "[", "]", ":", ",", ";", "=" };
+
+        std::vector<Token> tokens;
+        int line = 1, column = 1;
+        std::size_t i = 0;
+        auto advance = [&](std::size_t count) {
+            for (std::size_t k = 0; k < count; ++k, ++i) {
+                if (source[i] == '\n') { ++line; column = 1; }
+                else ++column;
+            }
+        };
+
+        while (i < source.size()) {
+            const char ch = source[i];
+            if (std::isspace(static_cast<unsigned char>(ch))) {
+                advance(1);
+            }
+            else if (ch == '#') {
+                while (i < source.size() && source[i] != '\n') advance(1);
+            }
+            else if (std::isdigit(static_cast<unsigned char>(ch))
+                || (ch == '.' && i + 1 < source.size() && std::isdigit(static_cast<unsigned char>(source[i + 1])))) {
+                char* end = nullptr;
+                const double value = std::strtod(source.c_str() + i, &end);
+                const std::size_t length = static_cast<std::size_t>(end - (source.c_str() + i));
+                tokens.push_back({ Token::Number, source.substr(i, length), value, line, column });
+                advance(length);
+            }
+            else if (std::isalpha(static_cast<unsigned char>(ch)) || ch == '_') {
+                std::size_t length = 1;
+                while (i + length < source.size()
+                    && (std::isalnum(static_cast<unsigned char>(source[i + length])) || source[i + length] == '_')) {
+                    ++length;
+                }
+                tokens.push_back({ Token::Name, source.substr(i, length), 0.0, line, column });
+                advance(length);
+            }
+            else {
+                const char* symbol = nullptr;
+                for (const char* candidate : SYMBOLS) {
+                    if (source.compare(i, std::strlen(candidate), candidate) == 0) {
+                        symbol = candidate;
+                        break;
+                    }
+                }
+                if (!symbol) {
+                    fail(line, column, std::string("unexpected character '") + ch + "'");
+                }
+                tokens.push_back({ Token::Symbol, symbol, 0.0, line, column });
+                advance(std::strlen(symbol));
+            }
+        }
+        tokens.push_back({ Token::End, "end of script", 0.0, line, column });
+        return tokens;
+    }
+
+    /*Noeud du graphe d'expressions. Constante : value ; observation : a = indice déclaré ; réduction :
+      a = première observation, b = nombre d'observations ; autre opération : a, b, c = noeuds opérandes.*/
+    struct Node {
+        PayoffScript::opCode op;
+        bool observation;
+        double value;
+        int a, b, c;
+    };
+
+    // Valeur d'une expression en cours d'analyse : un noeud, ou un intervalle d'observations à réduire
+    struct Value {
+        int node = -1;
+        bool range = false;
+        int first = 0, count = 0;
+    };
+
+    // Analyse syntaxique et construction du graphe, avec partage et repliement des constantes
+    class Compiler {
+    private:
+        std::vector<Token> _tokens;
+        std::size_t _pos = 0;
+        int _nbObservations;
+        std::map<std::string, int> _names;	// noms affectés -> noeud
+        int _depth = 0;						// imbrication courante de l'analyse
+
+        // Imbrication maximale (parenthèses, if, arguments, opérateurs unaires) : borne la pile de l'analyse
+        static const int MAX_NESTING = 100;
+
+        // Niveau d'imbrication, ouvert à l'entrée d'une règle récursive
+        struct Nesting {
+            Compiler& compiler;
+            Nesting(Compiler& owner, const Token& at) : compiler(owner) {
+                if (++compiler._depth > MAX_NESTING) {
+                    fail(at.line, at.column, "expression is nested too deeply");
+                }
+            }
+            ~Nesting() { --compiler._depth; }
+        };
+
+    public:
+        std::vector<Node> nodes;
+
+    private:
+        std::map<std::tuple<int, bool, std::uint64_t, int, int, int>, int> _index;	// partage des noeuds identiques
+
+        const Token& peek() const { return _tokens[_pos]; }
+        bool isSymbol(const char* symbol) const { return peek().type == Token::Symbol && peek().text == symbol; }
+        bool isName(const char* name) const { return peek().type == Token::Name && peek().text == name; }
+
+        void expect(const char* symbol) {
+            if (!isSymbol(symbol)) {
+                fail(peek().line, peek().column, std::string("expected '") + symbol + "' before '" + peek().text + "'");
+            }
+            ++_pos;
+        }
+
+        void expectName(const char* name) {
+            if (!isName(name)) {
+                fail(peek().line, peek().column, std::string("expected '") + name + "' before '" + peek().text + "'");
+            }
+            ++_pos;
+        }
+
+        int add(PayoffScript::opCode op, bool observation, double value, int a, int b, int c) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof bits);
+            const auto key = std::make_tuple(static_cast<int>(op), observation, bits, a, b, c);
+            const auto found = _index.find(key);
+            if (found != _index.end()) return found->second;
+            nodes.push_back({ op, observation, value, a, b, c });
+            _index.emplace(key, static_cast<int>(nodes.size()) - 1);
+            return static_cast<int>(nodes.size()) - 1;
+        }
+
+        bool isConstant(int node) const { return nodes[node].op == PayoffScript::Const && !nodes[node].observation; }
+        double constantValue(int node) const { return nodes[node].value; }
+
+        int scalar(const Value& value, const Token& at) const {
+            if (value.range) {
+                fail(at.line, at.column, "an observation range must be reduced by sum, average, max or min");
+            }
+            return value.node;
+        }
+
+    public:
+        Compiler(const std::string& source, int nb_observations)
+            : _tokens(tokenize(source)), _nbObservations(nb_observations) {}
+
+        int constant(double value) { return add(PayoffScript::Const, false, value, 0, 0, 0); }
+
+        int observation(int index) { return add(PayoffScript::Const, true, 0.0, index, 0, 0); }
+
+        int unary(PayoffScript::opCode op, int x) {
+            if (isConstant(x)) return constant(PayoffScript::apply(op, constantValue(x)));
+            return add(op, false, 0.0, x, -1, -1);
+        }
+
+        // Repliement des constantes et simplifications exactes (éléments neutres, opérandes identiques)
+        int binary(PayoffScript::opCode op, int x, int y) {
+            using P = PayoffScript;
+            if (isConstant(x) && isConstant(y)) return constant(P::apply(op, constantValue(x), constantValue(y)));
+            const bool cx = isConstant(x), cy = isConstant(y);
+            const double vx = cx ? constantValue(x) : 0.0, vy = cy ? constantValue(y) : 0.0;
+            switch (op) {
+            case P::Add:
+                if (cx && vx == 0.0) return y;
+                if (cy && vy == 0.0) return x;
+                break;
+            case P::Sub:
+                if (cy && vy == 0.0) return x;
+                break;
+            case P::Mul:
+                if (cx && vx == 1.0) return y;
+                if (cy && vy == 1.0) return x;
+                break;
+            case P::Div:
+                if (cy && vy == 1.0) return x;
+                break;
+            case P::Max:
+            case P::Min:
+                if (x == y) return x;
+                break;
+            case P::And:
+                if (cx) return vx != 0.0 ? binary(P::Ne, y, constant(0.0)) : constant(0.0);
+                if (cy) return vy != 0.0 ? binary(P::Ne, x, constant(0.0)) : constant(0.0);
+                break;
+            case P::Or:
+                if (cx) return vx != 0.0 ? constant(1.0) : binary(P::Ne, y, constant(0.0));
+                if (cy) return vy != 0.0 ? constant(1.0) : binary(P::Ne, x, constant(0.0));
+                break;
+            default:
+                break;
+            }
+            // Opérations commutatives : ordre canonique, pour que le partage reconnaisse a + b et b + a
+            if ((op == P::Add || op == P::Mul || op == P::Max || op == P::Min || op == P::Eq || op == P::Ne
+                || op == P::And || op == P::Or) && y < x) {
+                std::swap(x, y);
+            }
+            return add(op, false, 0.0, x, y, -1);
+        }
+
+        int select(int condition, int x, int y) {
+            if (isConstant(condition)) return constantValue(condition) != 0.0 ? x : y;
+            if (x == y) return x;
+            return add(PayoffScript::Select, false, 0.0, condition, x, y);
+        }
+
+        int reduce(PayoffScript::opCode op, int first, int count) {
+            if (count == 1) return observation(first);
+            return add(op, false, 0.0, first, count, -1);
+        }
+
+        // script := { nom '=' expression ';' } expression [';']
+        int parse() {
+            for (;;) {
+                if (peek().type == Token::Name && _tokens[_pos + 1].type == Token::Symbol && _tokens[_pos + 1].text == "=") {
+                    const Token name = peek();
+                    if (name.text == "S") fail(name.line, name.column, "'S' is the path and cannot be assigned");
+                    _pos += 2;
+                    const Token& at = peek();
+                    _names[name.text] = scalar(expression(), at);
+                    expect(";");
+                    continue;
+                }
+                const Token& at = peek();
+                const int result = scalar(expression(), at);
+                if (isSymbol(";")) ++_pos;
+                if (peek().type != Token::End) {
+                    fail(peek().line, peek().column, "unexpected '" + peek().text + "' after the payoff expression");
+                }
+                return result;
+            }
+        }
+
+    private:
+        // expression := 'if' expression 'then' expression 'else' expression | disjonction
+        Value expression() {
+            const Nesting nesting(*this, peek());
+            if (isName("if")) {
+                ++_pos;
+                const Token& at = peek();
+                const int condition = scalar(expression(), at);
+                expectName("then");
+                const Token& atThen = peek();
+                const int x = scalar(expression(), atThen);
+                expectName("else");
+                const Token& atElse = peek();
+                const int y = scalar(expression(), atElse);
+                return { select(condition, x, y) };
+            }
+            return logical(0);
+        }
+
+        // Niveau 0 : or ; niveau 1 : and
+        Value logical(int level) {
+            const char* keyword = level == 0 ? "or" : "and";
+            const Token& at = peek();
+            Value left = level == 0 ? logical(1) : negation();
+            while (isName(keyword)) {
+                ++_pos;
+                const Token& atRight = peek();
+                const int right = scalar(level == 0 ? logical(1) : negation(), atRight);
+                left = { binary(level == 0 ? PayoffScript::Or : PayoffScript::And, scalar(left, at), right) };
+            }
+            return left;
+        }
+
+        Value negation() {
+            if (isName("not")) {
+                const Nesting nesting(*this, peek());
+                ++_pos;
+                const Token& at = peek();
+                return { unary(PayoffScript::Not, scalar(negation(), at)) };
+            }
+            return comparison();
+        }
+
+        Value comparison() {
+            static const std::pair<const char*, PayoffScript::opCode> OPERATORS[] = { { "<", PayoffScript::Lt },
+                { "<=", PayoffScript::Le }, { ">", PayoffScript::Gt }, { ">=", PayoffScript::Ge },
+                { "==", PayoffScript::Eq }, { "!=", PayoffScript::Ne } };
+            const Token& at = peek();
+            Value left = additive();
+            for (const auto& op : OPERATORS) {
+                if (isSymbol(op.first)) {
+                    ++_pos;
+                    const Token& atRight = peek();
+                    const int right = scalar(additive(), atRight);
+                    return { binary(op.second, scalar(left, at), right) };
+                }
+            }
+            return left;
+        }
+
+        Value additive() {
+            const Token& at = peek();
+            Value left = term();
+            while (isSymbol("+") || isSymbol("-")) {
+                const PayoffScript::opCode op = isSymbol("+") ? PayoffScript::Add : PayoffScript::Sub;
+                ++_pos;
+                const Token& atRight = peek();
+                const int right = scalar(term(), atRight);
+                left = { binary(op, scalar(left, at), right) };
+            }
+            return left;
+        }
+
+        Value term() {
+            const Token& at = peek();
+            Value left = sign();
+            while (isSymbol("*") || isSymbol("/")) {
+                const PayoffScript::opCode op = isSymbol("*") ? PayoffScript::Mul : PayoffScript::Div;
+                ++_pos;
+                const Token& atRight = peek();
+                const int right = scalar(sign(), atRight);
+                left = { binary(op, scalar(left, at), right) };
+            }
+            return left;
+        }
+
+        Value sign() {
+            if (isSymbol("-")) {
+                const Nesting nesting(*this, peek());
+                ++_pos;
+                const Token& at = peek();
+                return { unary(PayoffScript::Neg, scalar(sign(), at)) };
+            }
+            return primary();
+        }
+
+        // Indice d'observation : expression constante entière, négative comptée depuis la fin
+        int index(bool upper) {
+            const Token& at = peek();
+            const int node = scalar(expression(), at);
+            if (!isConstant(node) || constantValue(node) != std::floor(constantValue(node))) {
+                fail(at.line, at.column, "observation index must be a constant integer");
+            }
+            double k = constantValue(node);
+            if (k < 0.0) k += _nbObservations;
+            if (k < 0.0 || k > _nbObservations - (upper ? 0 : 1)) {
+                fail(at.line, at.column, "observation index out of range");
+            }
+            return static_cast<int>(k);
+        }
+
+        Value primary() {
+            const Token token = peek();
+            if (token.type == Token::Number) {
+                ++_pos;
+                return { constant(token.value) };
+            }
+            if (isSymbol("(")) {
+                ++_pos;
+                const Value inner = expression();
+                expect(")");
+                return inner;
+            }
+            if (token.type != Token::Name) {
+                fail(token.line, token.column, "unexpected '" + token.text + "'");
+            }
+            ++_pos;
+
+            // Chemin : S, S[k], S[a:b]
+            if (token.text == "S") {
+                Value range;
+                range.range = true;
+                range.first = 0;
+                range.count = _nbObservations;
+                if (!isSymbol("[")) return range;
+                ++_pos;
+                const int first = isSymbol(":") ? 0 : index(false);
+                if (!isSymbol(":")) {
+                    expect("]");
+                    return { observation(first) };
+                }
+                ++_pos;
+                const int last = isSymbol("]") ? _nbObservations : index(true);
+                expect("]");
+                if (last <= first) fail(token.line, token.column, "empty observation range");
+                range.first = first;
+                range.count = last - first;
+                return range;
+            }
+
+            if (!isSymbol("(")) {
+                const auto found = _names.find(token.text);
+                if (found == _names.end()) fail(token.line, token.column, "unknown name '" + token.text + "'");
+                return { found->second };
+            }
+
+            // Appel de fonction
+            ++_pos;
+            std::vector<Value> args;
+            std::vector<Token> positions;
+            if (!isSymbol(")")) {
+                for (;;) {
+                    positions.push_back(peek());
+                    args.push_back(expression());
+                    if (!isSymbol(",")) break;
+                    ++_pos;
+                }
+            }
+            expect(")");
+
+            const std::string& name = token.text;
+            const bool reduction = args.size() == 1 && args[0].range;
+            if (reduction && (name == "sum" || name == "average" || name == "max" || name == "min")) {
+                const Value& r = args[0];
+                if (name == "max") return { reduce(PayoffScript::RangeMax, r.first, r.count) };
+                if (name == "min") return { reduce(PayoffScript::RangeMin, r.first, r.count) };
+                const int total = reduce(PayoffScript::Sum, r.first, r.count);
+                return { name == "sum" ? total : binary(PayoffScript::Mul, total, constant(1.0 / r.count)) };
+            }
+            if (name == "max" || name == "min") {
+                if (args.size() < 2) fail(token.line, token.column, name + " needs an observation range or at least two arguments");
+                int result = scalar(args[0], positions[0]);
+                for (std::size_t k = 1; k < args.size(); ++k) {
+                    result = binary(name == "max" ? PayoffScript::Max : PayoffScript::Min, result, scalar(args[k], positions[k]));
+                }
+                return { result };
+            }
+            static const std::pair<const char*, PayoffScript::opCode> FUNCTIONS[] = { { "exp", PayoffScript::Exp },
+                { "log", PayoffScript::Log }, { "sqrt", PayoffScript::Sqrt }, { "abs", PayoffScript::Abs } };
+            for (const auto& function : FUNCTIONS) {
+                if (name == function.first) {
+                    if (args.size() != 1) fail(token.line, token.column, name + " takes one argument");
+                    return { unary(function.second, scalar(args[0], positions[0])) };
+                }
+            }
+            if (name == "sum" || name == "average") {
+                fail(token.line, token.column, name + " takes an observation range");
+            }
+            fail(token.line, token.column, "unknown function '" + name + "'");
+        }
+    };
+}
+
+double PayoffScript::apply(opCode op, double a, double b, double c) {
+    switch (op) {
+    case Neg: return -a;
+    case Not: return a == 0.0 ? 1.0 : 0.0;
+    case Exp: return std::exp(a);
+    case Log: return std::log(a);
+    case Sqrt: return std::sqrt(a);
+    case Abs: return std::abs(a);
+    case Add: return a + b;
+    case Sub: return a - b;
+    case Mul: return a * b;
+    case Div: return a / b;
+    case Max: return a < b ? b : a;
+    case Min: return b < a ? b : a;
+    case Lt: return a < b ? 1.0 : 0.0;
+    case Le: return a <= b ? 1.0 : 0.0;
+    case Gt: return a > b ? 1.0 : 0.0;
+    case Ge: return a >= b ? 1.0 : 0.0;
+    case Eq: return a == b ? 1.0 : 0.0;
+    case Ne: return a != b ? 1.0 : 0.0;
+    case And: return a != 0.0 && b != 0.0 ? 1.0 : 0.0;
+    case Or: return a != 0.0 || b != 0.0 ? 1.0 : 0.0;
+    case Select: return a != 0.0 ? b : c;
+    default: throw std::invalid_argument("Operation cannot be applied to scalars.");
+    }
+}
+
+/*Après l'analyse, seuls les noeuds atteignables depuis le payoff sont compilés (les affectations inutilisées
+  et les branches éliminées par repliement disparaissent). Les observations atteintes occupent les premiers
+  registres ; chaque noeud est calculé une fois dans un registre de travail, libéré après sa dernière
+  utilisation et réutilisé (une instruction peut écrire dans le registre d'un de ses opérandes : chaque
+  colonne est lue avant d'être écrite, élément par élément).*/
+PayoffScript::PayoffScript(const std::string& source, std::size_t nb_observations)
+    : _source(source),
+    _nbObservations(nb_observations),
+    _nbTemporaries(0),
+    _result(0)
+{
+    if (nb_observations == 0) {
+        throw std::invalid_argument("Payoff script needs at least one observation date.");
+    }
+    if (nb_observations > std::numeric_limits<std::uint16_t>::max() / 2) {
+        throw std::invalid_argument("Too many observation dates for a payoff script.");
+    }
+
+    Compiler compiler(source, static_cast<int>(nb_observations));
+    const int root = compiler.parse();
+    const std::vector<Node>& nodes = compiler.nodes;
+
+    // Noeuds atteignables, nombre d'utilisations de chacun, observations utilisées
+    std::vector<int> uses(nodes.size(), 0);
+    std::vector<char> reached(nodes.size(), 0), observed(nb_observations, 0);
+    std::vector<int> stack{ root };
+    reached[root] = 1;
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (node.observation) {
+            observed[node.a] = 1;
+            continue;
+        }
+        if (node.op == Sum || node.op == RangeMax || node.op == RangeMin) {
+            std::fill(observed.begin() + node.a, observed.begin() + node.a + node.b, 1);
+            continue;
+        }
+        if (node.op == Const) continue;
+        for (const int child : { node.a, node.b, node.c }) {
+            if (child < 0) continue;
+            ++uses[child];
+            if (!reached[child]) {
+                reached[child] = 1;
+                stack.push_back(child);
+            }
+        }
+    }
+
+    std::vector<std::uint16_t> compact(nb_observations, 0);
+    for (std::size_t k = 0; k < nb_observations; ++k) {
+        if (observed[k]) {
+            compact[k] = static_cast<std::uint16_t>(_used.size());
+            _used.push_back(k);
+        }
+    }
+
+    // Allocation des registres de travail
+    const std::size_t m = _used.size();
+    std::vector<std::uint16_t> freeRegisters;
+    auto allocate = [&]() -> std::uint16_t {
+        if (!freeRegisters.empty()) {
+            const std::uint16_t reg = freeRegisters.back();
+            freeRegisters.pop_back();
+            return reg;
+        }
+        if (m + _nbTemporaries >= std::numeric_limits<std::uint16_t>::max()) {
+            throw std::invalid_argument("Payoff script is too large.");
+        }
+        return static_cast<std::uint16_t>(m + _nbTemporaries++);
+    };
+
+    /*Un noeud est toujours créé après ses opérandes : l'ordre de création est topologique et le programme est
+      émis dans cet ordre, sans récursion (une expression très profonde, comme une longue somme, ne peut pas
+      épuiser la pile). Une constante n'est chargée qu'à sa première utilisation, pour ne pas occuper de
+      registre avant.*/
+    std::vector<int> slot(nodes.size(), -1);
+    auto load = [&](int index) {
+        if (slot[index] < 0) {
+            const std::uint16_t target = allocate();
+            _code.push_back({ Const, target, 0, 0, 0, nodes[index].value });
+            slot[index] = target;
+        }
+        return static_cast<std::uint16_t>(slot[index]);
+    };
+    for (std::size_t index = 0; index < nodes.size(); ++index) {
+        const Node& node = nodes[index];
+        if (!reached[index] || (node.op == Const && !node.observation)) continue;
+        Instruction instruction{ node.op, 0, 0, 0, 0, 0.0 };
+
+        if (node.observation) {
+            slot[index] = compact[node.a];
+            continue;
+        }
+        if (node.op == Sum || node.op == RangeMax || node.op == RangeMin) {
+            instruction.a = compact[node.a];
+            instruction.b = static_cast<std::uint16_t>(node.b);
+        }
+        else {
+            // Opérandes, puis libération de ceux dont c'était la dernière utilisation
+            std::uint16_t* operands[] = { &instruction.a, &instruction.b, &instruction.c };
+            const int children[] = { node.a, node.b, node.c };
+            for (int k = 0; k < 3; ++k) {
+                if (children[k] >= 0) *operands[k] = load(children[k]);
+            }
+            for (int k = 0; k < 3; ++k) {
+                const int child = children[k];
+                if (child >= 0 && --uses[child] == 0 && slot[child] >= static_cast<int>(m)) {
+                    freeRegisters.push_back(static_cast<std::uint16_t>(slot[child]));
+                }
+            }
+        }
+        instruction.target = allocate();
+        _code.push_back(instruction);
+        slot[index] = instruction.target;
+    }
+    _result = load(root);
+}
+
+void PayoffScript::evaluate(const double* observations, std::size_t stride, std::size_t n, double* result,
+    std::vector<double>& workspace) const {
+    if (n > stride) {
+        throw std::invalid_argument("Batch size exceeds the observation stride.");
+    }
+    if (workspace.size() < _nbTemporaries * n) {
+        workspace.resize(_nbTemporaries * n);
+    }
+    const double* ws = workspace.data();
+
+    for (const Instruction& ins : _code) {
+        double* t = workspace.data() + (ins.target - _used.size()) * n;
+        const double* a = column(ins.a, observations, stride, ws, n);
+        const double* b = ins.op >= Add && ins.op <= Select ? column(ins.b, observations, stride, ws, n) : nullptr;
+        const double* c = ins.op == Select ? column(ins.c, observations, stride, ws, n) : nullptr;
+
+        switch (ins.op) {
+        case Const: for (std::size_t p = 0; p < n; ++p) t[p] = ins.value; break;
+        case Neg: for (std::size_t p = 0; p < n; ++p) t[p] = -a[p]; break;
+        case Not: for (std::size_t p = 0; p < n; ++p) t[p] = a[p] == 0.0 ? 1.0 : 0.0; break;
+        case Exp: for (std::size_t p = 0; p < n; ++p) t[p] = std::exp(a[p]); break;
+        case Log: for (std::size_t p = 0; p < n; ++p) t[p] = std::log(a[p]); break;
+        case Sqrt: for (std::size_t p = 0; p < n; ++p) t[p] = std::sqrt(a[p]); break;
+        case Abs: for (std::size_t p = 0; p < n; ++p) t[p] = std::abs(a[p]); break;
+        case Add: for (std::size_t p = 0; p < n; ++p) t[p] = a[p] + b[p]; break;
+        case Sub: for (std::size_t p = 0; p < n; ++p) t[p] = a[p] - b[p]; break;
+        case Mul: for (std::size_t p = 0; p < n; ++p) t[p] = a[p] * b[p]; break;
+        case Div: for (std::size_t p = 0; p < n; ++p) t[p] = a[p] / b[p]; break;
+        case Max: for (std::size_t p = 0; p < n; ++p) t[p] = a[p] < b[p] ? b[p] : a[p]; break;
+        case Min: for (std::size_t p = 0; p < n; ++p) t[p] = b[p] < a[p] ? b[p] : a[p]; break;
+        case Lt: for (std::size_t p = 0; p < n; ++p) t[p] = a[p] < b[p] ? 1.0 : 0.0; break;
+        case Le: for (std::size_t p = 0; p < n; ++p) t[p] = a[p] <= b[p] ? 1.0 : 0.0; break;
+        case Gt: for (std::size_t p = 0; p < n; ++p) t[p] = a[p] > b[p] ? 1.0 : 0.0; break;
+        case Ge: for (std::size_t p = 0; p < n; ++p) t[p] = a[p] >= b[p] ? 1.0 : 0.0; break;
+        case Eq: for (std::size_t p = 0; p < n; ++p) t[p] = a[p] == b[p] ? 1.0 : 0.0; break;
+        case Ne: for (std::size_t p = 0; p < n; ++p) t[p] = a[p] != b[p] ? 1.0 : 0.0; break;
+        case And: for (std::size_t p = 0; p < n; ++p) t[p] = (a[p] != 0.0) & (b[p] != 0.0) ? 1.0 : 0.0; break;
+        case Or: for (std::size_t p = 0; p < n; ++p) t[p] = (a[p] != 0.0) | (b[p] != 0.0) ? 1.0 : 0.0; break;
+        case Select: for (std::size_t p = 0; p < n; ++p) t[p] = a[p] != 0.0 ? b[p] : c[p]; break;
+        case Sum:
+        case RangeMax:
+        case RangeMin:
+            // Colonnes consécutives des observations a à a + b - 1
+            for (std::size_t p = 0; p < n; ++p) t[p] = a[p];
+            for (std::size_t k = 1; k < ins.b; ++k) {
+                const double* x = a + k * stride;
+                if (ins.op == Sum) for (std::size_t p = 0; p < n; ++p) t[p] += x[p];
+                else if (ins.op == RangeMax) for (std::size_t p = 0; p < n; ++p) t[p] = t[p] < x[p] ? x[p] : t[p];
+                else for (std::size_t p = 0; p < n; ++p) t[p] = x[p] < t[p] ? x[p] : t[p];
+            }
+            break;
+        }
+    }
+
+    const double* payoff = column(_result, observations, stride, ws, n);
+    std::copy(payoff, payoff + n, result);
+}
+
+double PayoffScript::evaluate(const double* values) const {
+    thread_local std::vector<double> workspace;
+    double result;
+    evaluate(values, 1, 1, &result, workspace);
+    return result;
+}
+
+std::string PayoffScript::disassemble() const {
+    std::ostringstream os;
+    auto name = [&](std::uint16_t reg) {
+        return reg < _used.size() ? "S" + std::to_string(_used[reg]) : "t" + std::to_string(reg - _used.size());
+    };
+    for (const Instruction& ins : _code) {
+        os << name(ins.target) << " = " << OP_NAMES[ins.op];
+        if (ins.op == Const) {
+            os << ' ' << ins.value;
+        }
+        else if (ins.op == Sum || ins.op == RangeMax || ins.op == RangeMin) {
+            os << ' ' << name(ins.a) << ".." << name(static_cast<std::uint16_t>(ins.a + ins.b - 1));
+        }
+        else {
+            os << ' ' << name(ins.a);
+            if (ins.op >= Add) os << ", " << name(ins.b);
+            if (ins.op == Select) os << ", " << name(ins.c);
+        }
+        os << '\n';
+    }
+    os << "return " << name(_result) << '\n';
+    return os.str();
+}
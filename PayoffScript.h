@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*Langage de description de payoffs, compilé une fois en bytecode à registres et évalué par lots de chemins.
+	Un script est une suite d'affectations "nom = expression;" suivie de l'expression du payoff (versé à la
+	dernière date d'observation). Le chemin est noté S : S[k] est l'observation k (k < 0 : compté depuis la
+	fin, S[-1] est la dernière), S[a:b] les observations a à b - 1 (bornes facultatives), S le chemin entier.
+	Expressions : nombres, noms affectés plus haut, + - * /, comparaisons < <= > >= == != (valeur 1 ou 0),
+	and, or, not, "if c then x else y", fonctions exp, log, sqrt, abs, max(x, y, ...), min(x, y, ...), et
+	sur un intervalle d'observations sum(S[a:b]), average(...), max(...), min(...). # commente la fin de ligne.
+	Exemple (call asiatique à barrière haute discrète) :
+		K = 100;
+		if max(S) >= 130 then 0 else max(average(S) - K, 0)
+	Compilation : les expressions sont partagées (une sous-expression répétée est calculée une fois), les
+	sous-expressions constantes sont évaluées (y compris les conditions, dont la branche morte disparaît),
+	puis les observations qui ne servent plus sont éliminées : getUsedObservations() donne les dates à simuler.
+	Chaque instruction traite tout un lot de chemins (boucle vectorisable sur des colonnes contiguës) : le coût
+	de décodage est amorti sur le lot. Les deux branches d'un if sont évaluées (sélection sans branchement) ;
+	les valeurs hors domaine (log d'un négatif, division par 0) donnent NaN ou l'infini, comme en C++.*/
+class PayoffScript {
+public:
+	enum opCode {
+		Const,		// target = value
+		Neg, Not, Exp, Log, Sqrt, Abs,	// target = f(a)
+		Add, Sub, Mul, Div, Max, Min,	// target = f(a, b)
+		Lt, Le, Gt, Ge, Eq, Ne, And, Or,
+		Select,		// target = a != 0 ? b : c
+		Sum, RangeMax, RangeMin			// réduction des observations a à a + b - 1
+	};
+
+	// Instruction : les opérandes sont des registres, les premiers étant les observations utilisées
+	struct Instruction {
+		opCode op;
+		std::uint16_t target;
+		std::uint16_t a, b, c;
+		double value;
+	};
+
+private:
+	std::string _source;			// texte du script
+	std::size_t _nbObservations;	// observations déclarées
+	std::vector<std::size_t> _used;	// observations utilisées (indices déclarés, croissants) : registres 0..m-1
+	std::vector<Instruction> _code;	// programme
+	std::size_t _nbTemporaries;		// registres de travail, après les observations
+	std::uint16_t _result;			// registre du payoff
+
+	// Adresse de la colonne d'un registre dans le lot courant
+	const double* column(std::uint16_t reg, const double* observations, std::size_t stride, const double* workspace,
+		std::size_t n) const {
+		return reg < _used.size() ? observations + reg * stride : workspace + (reg - _used.size()) * n;
+	}
+
+public:
+	/*Compile le script pour un chemin de nb_observations dates ; lève std::invalid_argument (ligne et colonne) sinon,
+	  notamment au-delà de 100 niveaux d'imbrication (parenthèses, if, arguments, opérateurs unaires).*/
+	PayoffScript(const std::string& source, std::size_t nb_observations);
+
+	/*Évalue le payoff de n chemins : l'observation utilisée j (j < getUsedObservations().size()) du chemin p
+	  est observations[j * stride + p] (stride >= n). workspace est redimensionné si nécessaire et peut être
+	  réutilisé d'un appel à l'autre.*/
+	void evaluate(const double* observations, std::size_t stride, std::size_t n, double* result,
+		std::vector<double>& workspace) const;
+
+	// Payoff d'un chemin : values[j] est la valeur de l'observation utilisée j
+	double evaluate(const double* values) const;
+
+	// Indices (dans le chemin déclaré) des observations dont dépend le payoff
+	const std::vector<std::size_t>& getUsedObservations() const { return _used; }
+
+	std::size_t getNbObservations() const { return _nbObservations; }
+	const std::vector<Instruction>& getCode() const { return _code; }
+	const std::string& getSource() const { return _source; }
+
+	// Listing lisible du bytecode (une instruction par ligne), pour vérifier la compilation
+	std::string disassemble() const;
+
+	// Valeur d'une opération élémentaire (repliement des constantes et lecture de référence du bytecode)
+	static double apply(opCode op, double a, double b = 0.0, double c = 0.0);
+};
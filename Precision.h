@@ -0,0 +1,29 @@
+#pragma once
+#include <cmath>
+#include <limits>
+
+/*Précision des calculs d'un moteur (BlackScholesMCPricer, CRRPricer). En simple précision, les trajectoires et
+	les arbres sont en float (deux fois plus de valeurs par registre SIMD, deux fois moins de mémoire) ; les
+	quantités sensibles à l'accumulation d'arrondis (moyenne de Welford, facteurs d'actualisation et
+	probabilités) restent en double. Adapté au screening et aux scénarios, où 1e-4 d'écart relatif suffit.*/
+enum computePrecision { DoublePrecision, SinglePrecision };
+
+/*Comparaison d'un même calcul en double et en simple précision, pour choisir le mode d'un traitement.
+	En Monte Carlo, les deux calculs utilisent les mêmes tirages : l'écart ne mesure que l'effet de la précision,
+	à comparer à statisticalError (demi-largeur de l'intervalle de confiance à 95 % en double).*/
+struct PrecisionReport {
+	double doubleValue = 0.0;		// résultat en double précision
+	double singleValue = 0.0;		// résultat en simple précision
+	double absoluteError = 0.0;		// |singleValue - doubleValue|
+	double relativeError = 0.0;		// absoluteError / |doubleValue| (absoluteError si doubleValue est nul)
+	double statisticalError = std::numeric_limits<double>::quiet_NaN();	// erreur Monte Carlo (NaN pour un arbre)
+	double doubleSeconds = 0.0;		// durée du calcul en double
+	double singleSeconds = 0.0;		// durée du calcul en simple précision
+
+	void setValues(double double_value, double single_value) {
+		doubleValue = double_value;
+		singleValue = single_value;
+		absoluteError = std::abs(single_value - double_value);
+		relativeError = double_value != 0.0 ? absoluteError / std::abs(double_value) : absoluteError;
+	}
+};
@@ -0,0 +1,49 @@
+#include "PricingArena.h"
+#include "Telemetry.h"
+
+void* PricingArena::CountingResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    _bytes += bytes;
+    TELEMETRY_COUNT(Allocations, 1);
+    return _upstream->allocate(bytes, alignment);
+}
+
+void PricingArena::CountingResource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    _upstream->deallocate(p, bytes, alignment);
+}
+
+bool PricingArena::CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+PricingArena::PricingArena(std::size_t initial_size, std::pmr::memory_resource* upstream)
+    : _buffer(new std::byte[initial_size > 0 ? initial_size : 1]),
+    _capacity(initial_size > 0 ? initial_size : 1),
+    _growths(0),
+    _upstream(upstream)
+{
+    _resource.emplace(_buffer.get(), _capacity, &_upstream);
+}
+
+// Le monotonic_buffer_resource ne peut pas changer de tampon : il est reconstruit sur le nouveau tampon.
+void PricingArena::reset() {
+    const std::size_t overflow = _upstream.bytes();
+
+    // Destruction de la ressource : rend les débordements au tas global
+    _resource.reset();
+    _upstream.resetCount();
+
+    if (overflow > 0) {
+        // Nouveau tampon couvrant le pic observé (avec une marge pour la fragmentation des blocs)
+        const std::size_t needed = _capacity + overflow + overflow / 2;
+        _buffer.reset(new std::byte[needed]);
+        _capacity = needed;
+        ++_growths;
+    }
+
+    _resource.emplace(_buffer.get(), _capacity, &_upstream);
+}
+
+PricingArena& PricingArena::threadLocal() {
+    thread_local PricingArena arena;
+    return arena;
+}
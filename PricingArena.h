@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+/*Arène mémoire pour les pricers et les arbres (std::pmr::monotonic_buffer_resource).
+	Les allocations sont de simples incréments de pointeur, sans verrou ; la mémoire n'est rendue
+	qu'au reset(). À chaque reset(), le tampon est agrandi jusqu'au pic d'utilisation observé :
+	en régime établi, un job de pricing ne fait plus aucune allocation sur le tas global.
+	Tous les objets construits sur l'arène doivent être détruits avant reset().
+	Une arène n'est pas thread-safe : utiliser une arène par thread (threadLocal()).*/
+class PricingArena {
+private:
+	// Ressource amont qui compte les octets demandés au-delà du tampon de l'arène.
+	class CountingResource : public std::pmr::memory_resource {
+	private:
+		std::pmr::memory_resource* _upstream;
+		std::size_t _bytes;
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+	public:
+		explicit CountingResource(std::pmr::memory_resource* upstream) : _upstream(upstream), _bytes(0) {}
+		std::size_t bytes() const { return _bytes; }
+		void resetCount() { _bytes = 0; }
+	};
+
+	std::unique_ptr<std::byte[]> _buffer;	// Tampon principal
+	std::size_t _capacity;					// Taille du tampon principal
+	std::size_t _growths;					// Nombre d'agrandissements du tampon
+	CountingResource _upstream;				// Débordements (tas global)
+	std::optional<std::pmr::monotonic_buffer_resource> _resource;
+
+public:
+	// Crée une arène avec un tampon initial de initial_size octets.
+	explicit PricingArena(std::size_t initial_size = 1 << 20,
+		std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+	PricingArena(const PricingArena&) = delete;
+	PricingArena& operator=(const PricingArena&) = delete;
+
+	// Ressource mémoire à transmettre aux arbres et aux pricers
+	std::pmr::memory_resource* resource() { return &*_resource; }
+
+	// Libère d'un coup toutes les allocations du job précédent (et agrandit le tampon si nécessaire).
+	void reset();
+
+	// Taille du tampon principal
+	std::size_t capacity() const { return _capacity; }
+
+	// Octets alloués en dehors du tampon depuis le dernier reset() (0 en régime établi)
+	std::size_t overflowBytes() const { return _upstream.bytes(); }
+
+	// Nombre d'agrandissements du tampon depuis la création
+	std::size_t growths() const { return _growths; }
+
+	// Arène propre au thread appelant
+	static PricingArena& threadLocal();
+};
@@ -0,0 +1,271 @@
+#include "PricingCache.h"
+#include "EuropeanVanillaOption.h"
+#include "EuropeanDigitalOption.h"
+#include "AmericanOption.h"
+#include "AsianOption.h"
+#include "BarrierOption.h"
+#include "CRRPricer.h"
+#include "LookbackOption.h"
+#include "ScriptedOption.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <typeinfo>
+
+namespace {
+    // Combinaison de hash (variante de boost::hash_combine sur 64 bits)
+    inline void combine(std::size_t& seed, std::size_t h) {
+        seed ^= h + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+    }
+
+    // Hash de la représentation binaire d'un réel (-0.0 et 0.0 confondus)
+    inline std::size_t hashDouble(double x) {
+        if (x == 0.0) x = 0.0;
+        std::uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return std::hash<std::uint64_t>()(bits);
+    }
+
+    // Centre de l'intervalle de quantification contenant x
+    inline double quantize(double x, double step) {
+        return step > 0.0 ? step * std::round(x / step) : x;
+    }
+
+    // Strike de l'option, quelle que soit sa famille (0 pour un script, identifié par sa source)
+    double strikeOf(const Option& option) {
+        if (const auto* o = dynamic_cast<const EuropeanVanillaOption*>(&option)) return o->getStrike();
+        if (const auto* o = dynamic_cast<const EuropeanDigitalOption*>(&option)) return o->getStrike();
+        if (const auto* o = dynamic_cast<const AmericanOption*>(&option)) return o->getStrike();
+        if (const auto* o = dynamic_cast<const AsianOption*>(&option)) return o->getStrike();
+        if (const auto* o = dynamic_cast<const BarrierOption*>(&option)) return o->getStrike();
+        if (const auto* o = dynamic_cast<const LookbackOption*>(&option)) return o->getStrike();
+        if (option.isScriptedOption()) return 0.0;
+        throw std::invalid_argument("Option type cannot be used as a pricing cache key.");
+    }
+
+    // Dates d'observation de l'option (fixings, surveillance, dates d'un script ; vide sinon)
+    const std::vector<double>* datesOf(const Option& option) {
+        if (const auto* o = dynamic_cast<const AsianOption*>(&option)) return &o->getTimeSteps();
+        if (const auto* o = dynamic_cast<const BarrierOption*>(&option)) return &o->getMonitoringDates();
+        if (const auto* o = dynamic_cast<const LookbackOption*>(&option)) return &o->getMonitoringDates();
+        if (const auto* o = dynamic_cast<const ScriptedOption*>(&option)) return &o->getObservationDates();
+        return nullptr;
+    }
+}
+
+CRRSettings CRRSettings::of(const CRRPricer& pricer) {
+    CRRSettings settings;
+    settings.pruneWidth = pricer.getPruning();
+    settings.precision = pricer.getPrecision();
+    if (pricer.isParallel()) {
+        settings.tileWidth = pricer.getTileWidth();
+        settings.blockLevels = pricer.getBlockLevels();
+    }
+    return settings;
+}
+
+/*Ordre des valeurs : expiry, strike, américaine (0/1), nombre de dates puis dates, paramètres propres à la
+  famille (barrière, rebate et type de barrière ; type de strike d'une lookback), données de marché quantifiées
+  (spot, taux, volatilité), paramètres du pricer.*/
+PricingKey::PricingKey(const Option& option,
+    const std::string& model,
+    const std::vector<double>& market,
+    const std::vector<double>& settings,
+    const MarketBuckets& buckets)
+    : _optionType(typeid(option).name()), _model(model), _hash(0)
+{
+    if (option.isMultiAssetOption()) {
+        throw std::invalid_argument("Multi-asset options cannot be used as a pricing cache key (per-asset market data).");
+    }
+    if (market.size() != 3) {
+        throw std::invalid_argument("Market data must be (spot, rate, volatility).");
+    }
+
+    _values.push_back(option.getExpiry());
+    _values.push_back(strikeOf(option));
+    _values.push_back(option.isAmericanOption() ? 1.0 : 0.0);
+
+    if (const std::vector<double>* dates = datesOf(option)) {
+        _values.push_back(static_cast<double>(dates->size()));
+        _values.insert(_values.end(), dates->begin(), dates->end());
+    }
+    else {
+        _values.push_back(0.0);
+    }
+
+    if (const auto* barrier = dynamic_cast<const BarrierOption*>(&option)) {
+        _values.push_back(barrier->getBarrier());
+        _values.push_back(barrier->getRebate());
+        _values.push_back(static_cast<double>(barrier->getBarrierType()));
+    }
+    else if (const auto* lookback = dynamic_cast<const LookbackOption*>(&option)) {
+        _values.push_back(static_cast<double>(lookback->getStrikeType()));
+    }
+    else if (const auto* scripted = dynamic_cast<const ScriptedOption*>(&option)) {
+        _source = scripted->getScript().getSource();
+    }
+
+    _values.push_back(quantize(market[0], buckets.spotStep));
+    _values.push_back(quantize(market[1], buckets.rateStep));
+    _values.push_back(quantize(market[2], buckets.volatilityStep));
+    _values.insert(_values.end(), settings.begin(), settings.end());
+
+    _hash = std::hash<std::string>()(_optionType);
+    combine(_hash, std::hash<std::string>()(_source));
+    combine(_hash, std::hash<std::string>()(_model));
+    for (double v : _values) combine(_hash, hashDouble(v));
+}
+
+PricingKey PricingKey::blackScholes(const Option& option, double asset_price, double interest_rate,
+    double volatility, const MarketBuckets& buckets)
+{
+    return PricingKey(option, "BlackScholes", { asset_price, interest_rate, volatility }, {}, buckets);
+}
+
+// Paramètres : profondeur, demi-largeur de la bande, précision, largeur des tuiles et niveaux par bloc
+PricingKey PricingKey::crr(const Option& option, int depth, double asset_price, double interest_rate,
+    double volatility, const MarketBuckets& buckets, const CRRSettings& settings)
+{
+    return PricingKey(option, "CRR", { asset_price, interest_rate, volatility },
+        { static_cast<double>(depth), settings.pruneWidth, static_cast<double>(settings.precision),
+        static_cast<double>(settings.tileWidth), static_cast<double>(settings.blockLevels) }, buckets);
+}
+
+PricingKey PricingKey::monteCarlo(const Option& option, long long nb_paths, double asset_price,
+    double interest_rate, double volatility, const MarketBuckets& buckets)
+{
+    return PricingKey(option, "MonteCarlo", { asset_price, interest_rate, volatility },
+        { static_cast<double>(nb_paths) }, buckets);
+}
+
+bool PricingKey::operator==(const PricingKey& other) const {
+    if (_hash != other._hash || _optionType != other._optionType || _source != other._source || _model != other._model
+        || _values.size() != other._values.size()) {
+        return false;
+    }
+    for (std::size_t k = 0; k < _values.size(); ++k) {
+        if (!(_values[k] == other._values[k])) return false;
+    }
+    return true;
+}
+
+PricingCache::PricingCache(std::size_t capacity, std::size_t nb_shards)
+    : _shardCapacity(0), _hits(0), _misses(0), _evictions(0)
+{
+    if (capacity == 0) throw std::invalid_argument("Cache capacity must be positive.");
+    if (nb_shards == 0) throw std::invalid_argument("Number of shards must be positive.");
+    if (nb_shards > capacity) nb_shards = capacity;
+
+    _shardCapacity = (capacity + nb_shards - 1) / nb_shards;
+    for (std::size_t k = 0; k < nb_shards; ++k) {
+        _shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+PricingCache::Shard& PricingCache::shardFor(const PricingKey& key) const {
+    // Bits de poids fort du hash mélangés pour ne pas dépendre des bits bas utilisés par unordered_map
+    const std::size_t h = key.hash() * 0x9e3779b97f4a7c15ull;
+    return *_shards[(h >> 32) % _shards.size()];
+}
+
+std::optional<double> PricingCache::find(const PricingKey& key) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        _misses.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    _hits.fetch_add(1, std::memory_order_relaxed);
+    return it->second->second;
+}
+
+void PricingCache::insert(const PricingKey& key, double price) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        it->second->second = price;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+
+    if (shard.lru.size() >= _shardCapacity) {
+        shard.index.erase(shard.lru.back().first);
+        shard.lru.pop_back();
+        _evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    shard.lru.emplace_front(key, price);
+    shard.index.emplace(key, shard.lru.begin());
+}
+
+double PricingCache::getOrCompute(const PricingKey& key, const std::function<double()>& compute) {
+    if (const std::optional<double> cached = find(key)) {
+        return *cached;
+    }
+    const double price = compute();
+    insert(key, price);
+    return price;
+}
+
+bool PricingCache::invalidate(const PricingKey& key) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) return false;
+    shard.lru.erase(it->second);
+    shard.index.erase(it);
+    return true;
+}
+
+std::size_t PricingCache::invalidateIf(const std::function<bool(const PricingKey&)>& predicate) {
+    std::size_t removed = 0;
+    for (auto& shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (auto it = shard->lru.begin(); it != shard->lru.end();) {
+            if (predicate(it->first)) {
+                shard->index.erase(it->first);
+                it = shard->lru.erase(it);
+                ++removed;
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+    return removed;
+}
+
+void PricingCache::clear() {
+    for (auto& shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->lru.clear();
+    }
+}
+
+std::size_t PricingCache::size() const {
+    std::size_t total = 0;
+    for (const auto& shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total += shard->lru.size();
+    }
+    return total;
+}
+
+double PricingCache::hitRate() const {
+    const double hits = static_cast<double>(getHits());
+    const double total = hits + static_cast<double>(getMisses());
+    return total > 0.0 ? hits / total : 0.0;
+}
+
+void PricingCache::resetCounters() {
+    _hits.store(0, std::memory_order_relaxed);
+    _misses.store(0, std::memory_order_relaxed);
+    _evictions.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include "Option.h"
+#include "Precision.h"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*Pas de quantification des données de marché dans la clé de cache (0 = valeur exacte).
+	Deux requêtes dont le spot, le taux et la volatilité tombent dans les mêmes intervalles partagent
+	la même entrée : le prix retourné est celui calculé pour la première requête du groupe.*/
+struct MarketBuckets {
+	double spotStep = 0.0;
+	double rateStep = 0.0;
+	double volatilityStep = 0.0;
+};
+
+class CRRPricer;
+
+/*Réglages d'un CRRPricer qui modifient le prix calculé (ne serait-ce qu'à l'arrondi) : ils font partie de la clé.
+	Le nombre de threads du mode parallèle n'en fait pas partie (le découpage en tuiles ne dépend que de leur
+	largeur et du nombre de niveaux par bloc).*/
+struct CRRSettings {
+	double pruneWidth = 0.0;						// setPruning() (0 : arbre complet)
+	computePrecision precision = DoublePrecision;	// setPrecision()
+	int tileWidth = 0;								// setParallel() (0 : mode parallèle désactivé)
+	int blockLevels = 0;							// setParallel()
+
+	// Réglages courants d'un pricer
+	static CRRSettings of(const CRRPricer& pricer);
+};
+
+/*Clé canonique d'une requête de pricing : type concret de l'option, ses paramètres (maturité, strike,
+	dates d'observation, caractère américain, barrière, source d'un script...), le modèle utilisé et ses
+	paramètres (spot, taux, volatilité, profondeur, réglages de l'arbre, nombre de chemins...).
+	Les options multi-actifs, dont les données de marché sont propres à chaque sous-jacent, n'ont pas de clé.
+	Le hash est calculé une fois à la construction.*/
+class PricingKey {
+private:
+	std::string _optionType;			// type concret de l'option (typeid)
+	std::string _source;				// source du script d'une ScriptedOption (vide sinon)
+	std::string _model;					// pricer utilisé ("BlackScholes", "CRR", "MonteCarlo", ...)
+	std::vector<double> _values;		// paramètres de l'option puis du modèle, dans un ordre fixe
+	std::size_t _hash;
+
+public:
+	PricingKey(const Option& option, const std::string& model, const std::vector<double>& market,
+		const std::vector<double>& settings, const MarketBuckets& buckets = MarketBuckets());
+
+	// Clés des pricers existants (market = spot, taux, volatilité)
+	static PricingKey blackScholes(const Option& option, double asset_price, double interest_rate, double volatility,
+		const MarketBuckets& buckets = MarketBuckets());
+	static PricingKey crr(const Option& option, int depth, double asset_price, double interest_rate, double volatility,
+		const MarketBuckets& buckets = MarketBuckets(), const CRRSettings& settings = CRRSettings());
+	static PricingKey monteCarlo(const Option& option, long long nb_paths, double asset_price, double interest_rate,
+		double volatility, const MarketBuckets& buckets = MarketBuckets());
+
+	const std::string& getModel() const { return _model; }
+	const std::string& getOptionType() const { return _optionType; }
+	const std::string& getSource() const { return _source; }
+	const std::vector<double>& getValues() const { return _values; }
+	std::size_t hash() const { return _hash; }
+
+	bool operator==(const PricingKey& other) const;
+	bool operator!=(const PricingKey& other) const { return !(*this == other); }
+};
+
+/*Cache LRU borné et concurrent placé devant les pricers.
+	Le cache est découpé en segments indépendants (chacun avec son verrou et sa liste LRU) choisis par le hash
+	de la clé : des threads lisant des clés différentes ne se bloquent pas, il n'y a pas de verrou global.
+	Le calcul d'un prix manquant (getOrCompute) est fait hors verrou.*/
+class PricingCache {
+private:
+	struct KeyHash {
+		std::size_t operator()(const PricingKey& k) const { return k.hash(); }
+	};
+
+	typedef std::list<std::pair<PricingKey, double>> LruList;
+
+	// Segment : liste LRU (la plus récente en tête) et index vers ses éléments
+	struct Shard {
+		std::mutex mutex;
+		LruList lru;
+		std::unordered_map<PricingKey, LruList::iterator, KeyHash> index;
+	};
+
+	std::vector<std::unique_ptr<Shard>> _shards;
+	std::size_t _shardCapacity;			// nombre maximal d'entrées par segment
+
+	std::atomic<unsigned long long> _hits;
+	std::atomic<unsigned long long> _misses;
+	std::atomic<unsigned long long> _evictions;
+
+	Shard& shardFor(const PricingKey& key) const;
+
+public:
+	// capacity : nombre total d'entrées ; nb_shards : nombre de segments (verrous) indépendants.
+	explicit PricingCache(std::size_t capacity, std::size_t nb_shards = 16);
+
+	PricingCache(const PricingCache&) = delete;
+	PricingCache& operator=(const PricingCache&) = delete;
+
+	// Recherche d'un prix ; en cas de succès l'entrée devient la plus récente de son segment.
+	std::optional<double> find(const PricingKey& key);
+
+	// Insère (ou remplace) un prix, en évinçant l'entrée la moins récente si le segment est plein.
+	void insert(const PricingKey& key, double price);
+
+	// Retourne le prix en cache ou le calcule avec compute() puis l'insère.
+	// Deux threads manquant la même clé simultanément peuvent tous deux appeler compute().
+	double getOrCompute(const PricingKey& key, const std::function<double()>& compute);
+
+	// Invalidation d'une entrée, des entrées vérifiant un prédicat, ou de tout le cache.
+	bool invalidate(const PricingKey& key);
+	std::size_t invalidateIf(const std::function<bool(const PricingKey&)>& predicate);
+	void clear();
+
+	// Compteurs
+	std::size_t size() const;
+	unsigned long long getHits() const { return _hits.load(std::memory_order_relaxed); }
+	unsigned long long getMisses() const { return _misses.load(std::memory_order_relaxed); }
+	unsigned long long getEvictions() const { return _evictions.load(std::memory_order_relaxed); }
+	double hitRate() const;
+	void resetCounters();
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+// Avancement d'un calcul, transmis au callback de progression
+struct PricingProgress {
+	long long done = 0;		// niveaux induits (arbre) ou chemins simulés (Monte Carlo) depuis le début de l'appel
+	long long total = 0;	// niveaux ou chemins demandés par l'appel
+	double confidenceWidth = std::numeric_limits<double>::quiet_NaN();	// largeur de l'intervalle à 95 % (Monte Carlo)
+};
+
+// Exception levée à un point de contrôle lorsque le calcul a été annulé
+class PricingCancelled : public std::runtime_error {
+public:
+	PricingCancelled() : std::runtime_error("Pricing job cancelled.") {}
+};
+
+/*Contrôle coopératif d'un calcul long : annulation et suivi de l'avancement. Un pricer auquel un contrôle est
+	attaché (setControl()) appelle report() à ses points de contrôle : à chaque niveau de l'induction rétrograde
+	(CRRPricer::compute()), tous les CHECK_PATHS chemins (BlackScholesMCPricer::generate()), et une dernière fois
+	en fin d'appel. report() lève PricingCancelled si cancel() a été appelé, depuis n'importe quel thread ;
+	sinon il transmet l'avancement au callback, au plus une fois par intervalle (la fin d'un appel est toujours
+	transmise). Le callback est exécuté par le thread du calcul et doit être installé avant son démarrage.*/
+class PricingControl {
+private:
+	std::atomic<bool> _cancelled;	// annulation demandée
+	std::function<void(const PricingProgress&)> _onProgress;	// callback de progression (éventuellement vide)
+	std::chrono::steady_clock::duration _interval;	// délai minimal entre deux appels du callback
+	mutable std::chrono::steady_clock::time_point _lastReport;	// dernier appel du callback
+
+public:
+	static const int CHECK_PATHS = 1024;	// chemins Monte Carlo entre deux points de contrôle
+
+	PricingControl() : _cancelled(false), _interval(std::chrono::milliseconds(50)) {}
+
+	// Callback de progression, appelé au plus une fois tous les interval_seconds
+	void setProgressCallback(std::function<void(const PricingProgress&)> on_progress, double interval_seconds = 0.05) {
+		if (interval_seconds < 0.0) {
+			throw std::invalid_argument("Progress interval must be non-negative.");
+		}
+		_onProgress = std::move(on_progress);
+		_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::duration<double>(interval_seconds));
+	}
+
+	// Demande l'annulation : le calcul s'arrête à son prochain point de contrôle
+	void cancel() { _cancelled.store(true, std::memory_order_relaxed); }
+
+	bool isCancelled() const { return _cancelled.load(std::memory_order_relaxed); }
+
+	// Lève PricingCancelled si l'annulation a été demandée
+	void checkpoint() const {
+		if (isCancelled()) throw PricingCancelled();
+	}
+
+	// Point de contrôle avec avancement
+	void report(const PricingProgress& progress) const {
+		checkpoint();
+		if (!_onProgress) return;
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (progress.done < progress.total && now - _lastReport < _interval) return;
+		_lastReport = now;
+		_onProgress(progress);
+	}
+};
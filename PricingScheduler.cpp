@@ -0,0 +1,89 @@
+#include "PricingScheduler.h"
+#include <algorithm>
+#include <stdexcept>
+
+PricingScheduler::PricingScheduler(int nb_threads)
+    : _nextSequence(0),
+    _stopping(false)
+{
+    if (nb_threads < 0) {
+        throw std::invalid_argument("Number of threads must be non-negative.");
+    }
+    if (nb_threads == 0) {
+        nb_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    _running.resize(static_cast<std::size_t>(nb_threads));
+    for (int id = 0; id < nb_threads; ++id) {
+        _threads.emplace_back(&PricingScheduler::workerLoop, this, static_cast<std::size_t>(id));
+    }
+}
+
+// Les jobs en attente sont annulés puis dépilés par les threads (leur future reçoit PricingCancelled).
+PricingScheduler::~PricingScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    cancelAll();
+    _ready.notify_all();
+    for (std::thread& thread : _threads) {
+        thread.join();
+    }
+}
+
+// std::push_heap place en tête l'élément maximal : le plus prioritaire doit donc être le plus "grand".
+bool PricingScheduler::after(const Entry& a, const Entry& b) {
+    if (a.priority != b.priority) return a.priority > b.priority;
+    return a.sequence > b.sequence;
+}
+
+void PricingScheduler::enqueue(Entry entry) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stopping) {
+            throw std::runtime_error("Pricing scheduler is shutting down.");
+        }
+        entry.sequence = _nextSequence++;
+        _queue.push_back(std::move(entry));
+        std::push_heap(_queue.begin(), _queue.end(), after);
+    }
+    _ready.notify_one();
+}
+
+void PricingScheduler::workerLoop(std::size_t id) {
+    for (;;) {
+        Entry entry;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _ready.wait(lock, [&] { return _stopping || !_queue.empty(); });
+            if (_queue.empty()) return;	// arrêt, plus rien à dépiler
+
+            std::pop_heap(_queue.begin(), _queue.end(), after);
+            entry = std::move(_queue.back());
+            _queue.pop_back();
+            _running[id] = entry.control;
+        }
+
+        // Les exceptions du job sont capturées par sa packaged_task
+        entry.run();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running[id].reset();
+    }
+}
+
+void PricingScheduler::cancelAll() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const Entry& entry : _queue) {
+        entry.control->cancel();
+    }
+    for (const std::shared_ptr<PricingControl>& control : _running) {
+        if (control) control->cancel();
+    }
+}
+
+std::size_t PricingScheduler::getNbPending() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _queue.size();
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include "PricingControl.h"
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*Exécution asynchrone de calculs de prix sur un pool de threads, pour une interface graphique ou un serveur de
+	risque qui soumet des calculs longs et continue de répondre. Un job est une fonction job(PricingControl&)
+	qui construit ou reçoit ses pricers, leur attache le contrôle (setControl()) et retourne un résultat ;
+	submit() retourne immédiatement un ticket (future du résultat et contrôle du job).
+	Les jobs en attente sont servis par priorité (Interactive avant Batch), dans l'ordre de soumission à priorité
+	égale. Un job en cours n'est pas préempté : un job interactif attend qu'un thread se libère, et découper un
+	gros job batch (generate() par tranches, par exemple) borne cette attente.
+	L'annulation est coopérative : un job en attente annulé ne démarre pas, un job en cours s'arrête au prochain
+	point de contrôle de ses pricers ; dans les deux cas, la future lève PricingCancelled. Une exception du job
+	est transmise par la future. Les pricers et options utilisés par un job doivent lui survivre et ne pas être
+	partagés avec un autre job en cours. Le générateur MT est propre à chaque thread : MT::seed(),
+	BlackScholesMCPricer::getState() et saveCheckpoint() portent sur le moteur du thread appelant et doivent donc
+	être appelés depuis le job lui-même, pas depuis le thread qui l'a soumis.*/
+class PricingScheduler {
+public:
+	enum jobPriority { Interactive, Batch };
+
+	// Résultat d'une soumission
+	template <typename R>
+	struct Ticket {
+		std::future<R> result;						// résultat du job (ou son exception)
+		std::shared_ptr<PricingControl> control;	// annulation ; callback de progression installé par submit()
+
+		void cancel() { control->cancel(); }
+	};
+
+private:
+	// Job en attente : trié par priorité puis par numéro de soumission
+	struct Entry {
+		jobPriority priority;
+		unsigned long long sequence;
+		std::shared_ptr<PricingControl> control;
+		std::function<void()> run;	// exécute le job et remplit sa future
+	};
+
+	std::vector<std::thread> _threads;	// threads du pool
+	std::vector<Entry> _queue;			// tas des jobs en attente (le plus prioritaire en tête)
+	std::vector<std::shared_ptr<PricingControl>> _running;	// contrôle du job en cours de chaque thread
+	mutable std::mutex _mutex;
+	std::condition_variable _ready;		// un job est en attente, ou le pool s'arrête
+	unsigned long long _nextSequence;	// numéro de la prochaine soumission
+	bool _stopping;						// destruction en cours
+
+	// Ordre du tas : vrai si a doit passer après b
+	static bool after(const Entry& a, const Entry& b);
+
+	void enqueue(Entry entry);
+
+	// Boucle d'un thread du pool
+	void workerLoop(std::size_t id);
+
+public:
+	// nb_threads = 0 : nombre de coeurs disponibles
+	explicit PricingScheduler(int nb_threads = 0);
+
+	// Annule tous les jobs (en attente et en cours) et attend l'arrêt des threads
+	~PricingScheduler();
+
+	PricingScheduler(const PricingScheduler&) = delete;
+	PricingScheduler& operator=(const PricingScheduler&) = delete;
+
+	/*Soumet job(PricingControl&) ; on_progress (facultatif) reçoit l'avancement signalé par les pricers du job,
+	  au plus une fois tous les progress_interval secondes, depuis le thread du job.*/
+	template <typename F>
+	auto submit(F job, jobPriority priority = Batch,
+		std::function<void(const PricingProgress&)> on_progress = nullptr, double progress_interval = 0.05)
+		-> Ticket<std::invoke_result_t<F&, PricingControl&>>;
+
+	// Annule tous les jobs en attente et en cours
+	void cancelAll();
+
+	// Nombre de jobs en attente (non démarrés)
+	std::size_t getNbPending() const;
+
+	int getNbThreads() const { return static_cast<int>(_threads.size()); }
+};
+
+template <typename F>
+auto PricingScheduler::submit(F job, jobPriority priority,
+	std::function<void(const PricingProgress&)> on_progress, double progress_interval)
+	-> Ticket<std::invoke_result_t<F&, PricingControl&>> {
+	using R = std::invoke_result_t<F&, PricingControl&>;
+
+	auto control = std::make_shared<PricingControl>();
+	if (on_progress) {
+		control->setProgressCallback(std::move(on_progress), progress_interval);
+	}
+
+	// Un job annulé avant son démarrage lève PricingCancelled sans être exécuté
+	auto task = std::make_shared<std::packaged_task<R()>>([job = std::move(job), control]() mutable -> R {
+		control->checkpoint();
+		return job(*control);
+	});
+
+	Ticket<R> ticket{ task->get_future(), control };
+	enqueue(Entry{ priority, 0, control, [task]() { (*task)(); } });
+	return ticket;
+}
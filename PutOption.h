@@ -2,16 +2,16 @@
 #include "EuropeanVanillaOption.h"	
 #include <algorithm>
 
-// Option europenne vanille de type Put.
+// Option européenne vanille de type Put.
 class PutOption : public EuropeanVanillaOption {
 
 public:
 
-	// Constructeur : initialise la maturit et le strike via la classe mre.
+	// Constructeur : initialise la maturité et le strike via la classe mère.
 	PutOption(double expiry, double strike)
 		: EuropeanVanillaOption(expiry, strike) {}
 
-	// Payoff du Put europen : h(S) = max(K - S, 0).
+	// Payoff du Put européen : h(S) = max(K - S, 0).
 	double payoff(double spot) const override {
 		return std::max(getStrike() - spot, 0.0);
 	}
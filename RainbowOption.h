@@ -0,0 +1,25 @@
+#pragma once
+#include "MultiAssetOption.h"
+#include <algorithm>
+#include <cstddef>
+
+// Option arc-en-ciel : l'agrégat est le meilleur (best-of) ou le pire (worst-of) des sous-jacents à maturité.
+class RainbowOption : public MultiAssetOption {
+public:
+    // Meilleur ou pire des actifs
+    enum rainbowType { BestOf, WorstOf };
+
+    RainbowOption(double expiry, std::size_t nb_assets, rainbowType type, double strike)
+        : MultiAssetOption(expiry, nb_assets, strike), _type(type) {
+    }
+
+    rainbowType getRainbowType() const { return _type; }
+
+    double aggregate(const double* spots) const override {
+        const double* end = spots + getNbAssets();
+        return _type == BestOf ? *std::max_element(spots, end) : *std::min_element(spots, end);
+    }
+
+private:
+    rainbowType _type;
+};
@@ -0,0 +1,23 @@
+#pragma once
+#include "RainbowOption.h"
+#include <algorithm>
+#include <cstddef>
+
+// Option arc-en-ciel de type Put : max(K - x, 0), x = max_a S_a(T) (best-of) ou min_a S_a(T) (worst-of).
+class RainbowPutOption : public RainbowOption {
+public:
+    // Constructeur : maturité, nombre de sous-jacents, meilleur/pire des actifs et strike.
+    RainbowPutOption(double expiry, std::size_t nb_assets, rainbowType type, double strike)
+        : RainbowOption(expiry, nb_assets, type, strike) {
+    }
+
+    // Payoff sur le meilleur ou le pire des actifs
+    double payoff(double x) const override {
+        return std::max(getStrike() - x, 0.0);
+    }
+
+    // Indique que l'option est un Put.
+    optionType GetOptionType() const override {
+        return Put;
+    }
+};
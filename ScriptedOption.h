@@ -0,0 +1,70 @@
+#pragma once
+#include "Option.h"
+#include "PayoffScript.h"
+#include <string>
+#include <vector>
+
+/*Option dont le payoff est décrit par un script (voir PayoffScript), compilé une fois à la construction :
+	un nouveau produit ne demande ni sous-classe ni recompilation. Les observations S[0], ..., S[m-1] du script
+	sont les valeurs du sous-jacent aux dates observation_dates ; le payoff est versé à la dernière date.
+	Seules les dates dont le payoff dépend sont simulées (getSimulationDates()). BlackScholesMCPricer évalue
+	le bytecode par lots de chemins ; HestonMCPricer passe par payoffPath(). CRRPricer et ChebyshevPricer
+	n'acceptent qu'un script qui n'observe que l'échéance (observesExpiryOnly()).*/
+class ScriptedOption : public Option {
+private:
+	std::vector<double> _observationDates;	// dates déclarées (t_0, ..., t_{m-1})
+	PayoffScript _script;					// payoff compilé
+	std::vector<double> _simulationDates;	// dates des observations utilisées par le script
+
+public:
+	// Les dates doivent être positives et strictement croissantes ; une erreur de script lève std::invalid_argument.
+	ScriptedOption(const std::string& script, const std::vector<double>& observation_dates)
+		: Option(observation_dates.empty() ? 0.0 : observation_dates.back()),
+		_observationDates(observation_dates),
+		_script(script, observation_dates.size())
+	{
+		for (std::size_t k = 0; k < observation_dates.size(); ++k) {
+			if (observation_dates[k] < 0.0 || (k > 0 && observation_dates[k] <= observation_dates[k - 1])) {
+				throw std::invalid_argument("Observation dates must be non-negative and strictly increasing.");
+			}
+		}
+		for (const std::size_t k : _script.getUsedObservations()) {
+			_simulationDates.push_back(observation_dates[k]);
+		}
+	}
+
+	const PayoffScript& getScript() const { return _script; }
+	const std::vector<double>& getObservationDates() const { return _observationDates; }
+	const std::vector<double>& getSimulationDates() const { return _simulationDates; }
+
+	// Vrai si le payoff ne dépend que du sous-jacent à l'échéance (payoff(spot) est alors exact)
+	bool observesExpiryOnly() const {
+		const std::vector<std::size_t>& used = _script.getUsedObservations();
+		return used.empty() || (used.size() == 1 && used[0] + 1 == _observationDates.size());
+	}
+
+	// Payoff d'un chemin constant égal à spot (exact pour un script qui n'observe qu'une date)
+	double payoff(double spot) const override {
+		if (_simulationDates.size() == 1) return _script.evaluate(&spot);
+		const std::vector<double> path(_simulationDates.size(), spot);
+		return _script.evaluate(path.data());
+	}
+
+	// Chemin aux dates simulées (getSimulationDates()) ou à toutes les dates déclarées
+	double payoffPath(const std::vector<double>& path) const override {
+		const std::vector<std::size_t>& used = _script.getUsedObservations();
+		if (path.size() == used.size()) {
+			return _script.evaluate(path.data());
+		}
+		if (path.size() != _observationDates.size()) {
+			throw std::invalid_argument("Path size does not match the observation dates of the script.");
+		}
+		std::vector<double> values(used.size());
+		for (std::size_t j = 0; j < used.size(); ++j) {
+			values[j] = path[used[j]];
+		}
+		return _script.evaluate(values.data());
+	}
+
+	bool isScriptedOption() const override { return true; }
+};
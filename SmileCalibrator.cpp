@@ -0,0 +1,137 @@
+#include "SmileCalibrator.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+    // Plancher de volatilité : le polynôme peut devenir négatif loin de la monnaie
+    const double MIN_VOLATILITY = 1e-4;
+
+    // Fonction de répartition de la loi normale standard N(0,1)
+    inline double N(double x) {
+        return 0.5 * std::erfc(-x / std::sqrt(2.0));
+    }
+
+    /*Noyau Black-Scholes vectorisable : prix et vega de toutes les cotations en une passe, sans objet Option.
+      Mêmes formules que BlackScholesPricer (la parité call-put donne le put).*/
+    void priceAndVega(double S, double r, const std::vector<OptionQuote>& quotes, const std::vector<double>& sigma,
+        std::vector<double>& price, std::vector<double>& vega) {
+        static const double INV_SQRT_2PI = 1.0 / std::sqrt(2.0 * M_PI);
+        const std::size_t m = quotes.size();
+        price.resize(m);
+        vega.resize(m);
+        for (std::size_t i = 0; i < m; ++i) {
+            const double K = quotes[i].strike;
+            const double T = quotes[i].expiry;
+            const double sqrtT = std::sqrt(T);
+            const double d1 = (std::log(S / K) + (r + 0.5 * sigma[i] * sigma[i]) * T) / (sigma[i] * sqrtT);
+            const double d2 = d1 - sigma[i] * sqrtT;
+            const double discK = K * std::exp(-r * T);
+            const double call = S * N(d1) - discK * N(d2);
+            price[i] = quotes[i].isCall ? call : call - S + discK;
+            vega[i] = S * sqrtT * INV_SQRT_2PI * std::exp(-0.5 * d1 * d1);
+        }
+    }
+}
+
+SmileCalibrator::SmileCalibrator(const LevenbergMarquardt::Options& options) : _options(options) {}
+
+std::vector<double> SmileCalibrator::expiries(const CalibrationProblem& problem) {
+    std::vector<double> result;
+    for (const OptionQuote& quote : problem.quotes) result.push_back(quote.expiry);
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+double SmileCalibrator::volatility(const std::vector<double>& parameters, std::size_t expiry_index, double log_moneyness) {
+    const std::size_t base = expiry_index * PARAMETERS_PER_EXPIRY;
+    if (base + PARAMETERS_PER_EXPIRY > parameters.size()) {
+        throw std::out_of_range("Expiry index out of range.");
+    }
+    const double k = log_moneyness;
+    return std::max(parameters[base] + parameters[base + 1] * k + parameters[base + 2] * k * k, MIN_VOLATILITY);
+}
+
+std::vector<std::string> SmileCalibrator::parameterNames(const CalibrationProblem& problem) const {
+    std::vector<std::string> names;
+    for (const double T : expiries(problem)) {
+        const std::string suffix = "[T=" + std::to_string(T) + "]";
+        names.push_back("atm" + suffix);
+        names.push_back("skew" + suffix);
+        names.push_back("curvature" + suffix);
+    }
+    return names;
+}
+
+std::vector<double> SmileCalibrator::initialGuess(const CalibrationProblem& problem) const {
+    std::vector<double> guess;
+    for (std::size_t j = 0; j < expiries(problem).size(); ++j) {
+        guess.insert(guess.end(), { 0.2, 0.0, 0.0 });
+    }
+    return guess;
+}
+
+CalibrationResult SmileCalibrator::calibrate(const CalibrationProblem& problem, const std::vector<double>& initial) const {
+    if (problem.spot <= 0.0) {
+        throw std::invalid_argument("Spot must be positive.");
+    }
+    if (problem.quotes.empty()) {
+        throw std::invalid_argument("No quotes to calibrate.");
+    }
+
+    const std::vector<double> Ts = expiries(problem);
+    const std::size_t n = Ts.size() * PARAMETERS_PER_EXPIRY;
+    if (initial.size() != n) {
+        throw std::invalid_argument("Initial parameters do not match the number of expiries.");
+    }
+
+    // Pré-calculs par cotation, indépendants des paramètres : bloc de maturité et log-moneyness
+    const std::size_t m = problem.quotes.size();
+    std::vector<std::size_t> block(m);
+    std::vector<double> k(m);
+    for (std::size_t i = 0; i < m; ++i) {
+        const OptionQuote& q = problem.quotes[i];
+        if (q.strike <= 0.0 || q.expiry <= 0.0) {
+            throw std::invalid_argument("Quotes must have positive strike and expiry.");
+        }
+        block[i] = static_cast<std::size_t>(std::lower_bound(Ts.begin(), Ts.end(), q.expiry) - Ts.begin());
+        k[i] = std::log(q.strike / (problem.spot * std::exp(problem.rate * q.expiry)));
+    }
+
+    std::vector<double> sigma(m), price, vega;
+    auto residuals = [&](const std::vector<double>& p, std::vector<double>& r, std::vector<double>* J) {
+        for (std::size_t i = 0; i < m; ++i) sigma[i] = volatility(p, block[i], k[i]);
+        priceAndVega(problem.spot, problem.rate, problem.quotes, sigma, price, vega);
+
+        r.resize(m);
+        for (std::size_t i = 0; i < m; ++i) {
+            r[i] = problem.quotes[i].weight * (price[i] - problem.quotes[i].price);
+        }
+        if (J) {
+            // Seul le bloc de la maturité de la cotation est non nul ; dérivée nulle sous le plancher
+            J->assign(m * n, 0.0);
+            for (std::size_t i = 0; i < m; ++i) {
+                if (sigma[i] <= MIN_VOLATILITY) continue;
+                double* row = &(*J)[i * n + block[i] * PARAMETERS_PER_EXPIRY];
+                const double dC = problem.quotes[i].weight * vega[i];
+                row[0] = dC;
+                row[1] = dC * k[i];
+                row[2] = dC * k[i] * k[i];
+            }
+        }
+    };
+
+    const LevenbergMarquardt solver(_options);
+    const LevenbergMarquardt::Result fit = solver.solve(residuals, initial);
+
+    CalibrationResult result;
+    result.parameters = fit.parameters;
+    result.rmse = std::sqrt(2.0 * fit.cost / static_cast<double>(m));
+    result.iterations = fit.iterations;
+    result.converged = fit.converged;
+    return result;
+}
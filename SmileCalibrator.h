@@ -0,0 +1,28 @@
+#pragma once
+#include "Calibrator.h"
+#include "LevenbergMarquardt.h"
+
+/*Calibration d'un smile de volatilité Black-Scholes : pour chaque maturité distincte, la volatilité est un
+	polynôme de degré 2 en log-moneyness k = ln(K / F) :
+		sigma(k) = atm + skew k + curvature k^2
+	Les paramètres sont (atm, skew, curvature) pour chaque maturité, maturités triées par ordre croissant.
+	Toutes les cotations sont pricées en un lot et la jacobienne est analytique : dC/dp = vega * dsigma/dp.*/
+class SmileCalibrator : public Calibrator {
+private:
+	LevenbergMarquardt::Options _options;
+
+public:
+	static const int PARAMETERS_PER_EXPIRY = 3;
+
+	explicit SmileCalibrator(const LevenbergMarquardt::Options& options = LevenbergMarquardt::Options());
+
+	// Maturités distinctes des cotations, triées (une par bloc de paramètres)
+	static std::vector<double> expiries(const CalibrationProblem& problem);
+
+	// Volatilité du smile de la maturité d'indice expiry_index en log-moneyness k
+	static double volatility(const std::vector<double>& parameters, std::size_t expiry_index, double log_moneyness);
+
+	std::vector<std::string> parameterNames(const CalibrationProblem& problem) const override;
+	std::vector<double> initialGuess(const CalibrationProblem& problem) const override;
+	CalibrationResult calibrate(const CalibrationProblem& problem, const std::vector<double>& initial) const override;
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include "BasketCallOption.h"
+
+// Option sur écart de type Call : max(x - K, 0), x = S_1(T) - S_2(T) (panier de poids (1, -1)).
+class SpreadCallOption : public BasketCallOption {
+public:
+    // Constructeur : maturité et strike (K = 0 : option d'échange).
+    SpreadCallOption(double expiry, double strike)
+        : BasketCallOption(expiry, { 1.0, -1.0 }, strike) {
+    }
+};
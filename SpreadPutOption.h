@@ -0,0 +1,11 @@
+#pragma once
+#include "BasketPutOption.h"
+
+// Option sur écart de type Put : max(K - x, 0), x = S_1(T) - S_2(T) (panier de poids (1, -1)).
+class SpreadPutOption : public BasketPutOption {
+public:
+    // Constructeur : maturité et strike (K = 0 : option d'échange).
+    SpreadPutOption(double expiry, double strike)
+        : BasketPutOption(expiry, { 1.0, -1.0 }, strike) {
+    }
+};
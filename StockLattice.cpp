@@ -0,0 +1,79 @@
+#include "StockLattice.h"
+#include "Telemetry.h"
+#include <cmath>
+#include <stdexcept>
+
+// Constructeur : seule la validité des paramètres est vérifiée, l'arbre n'est pas encore construit.
+StockLattice::StockLattice(double asset_price, double up, double down, int depth,
+    std::pmr::memory_resource* resource)
+    : _S0(asset_price), _U(up), _D(down), _depth(depth), _built(false), _tree(resource)
+{
+    if (_depth < 0) {
+        throw std::invalid_argument("Depth must be non-negative.");
+    }
+    if (!(_D < _U)) {
+        throw std::invalid_argument("Lattice requires D < U.");
+    }
+}
+
+std::shared_ptr<const StockLattice> StockLattice::fromVolatility(double asset_price,
+    double volatility,
+    double expiry,
+    int depth)
+{
+    const double step = volatility * std::sqrt(expiry / depth);
+    return std::make_shared<const StockLattice>(asset_price, std::exp(step) - 1.0, std::exp(-step) - 1.0, depth);
+}
+
+void StockLattice::build() const {
+    std::call_once(_once, [this]() {
+        TELEMETRY_SCOPE(CRRConstruction);
+
+        _tree.setDepth(_depth);
+
+        const double u = 1.0 + _U;
+        const double d = 1.0 + _D;
+        const double ud = u / d;
+
+        double d_pow_n = 1.0; // d^0
+        for (int n = 0; n <= _depth; ++n) {
+            double S = _S0 * d_pow_n; // S(n,0)
+            for (int i = 0; i <= n; ++i) {
+                _tree.setNode(n, i, S);
+                S *= ud; //Prochain noeud au meme niveau
+            }
+            d_pow_n *= d; //Prochain niveau
+        }
+        TELEMETRY_COUNT(NodesVisited, (static_cast<long long>(_depth) + 1) * (_depth + 2) / 2);
+        _built.store(true, std::memory_order_release);
+    });
+}
+
+bool StockLattice::isBuilt() const {
+    return _built.load(std::memory_order_acquire);
+}
+
+double StockLattice::getNode(int n, int i) const {
+    build();
+    return _tree.getNode(n, i);
+}
+
+// Même suite de multiplications que build(), limitée à la ligne demandée.
+std::vector<double> StockLattice::level(int n) const {
+    if (n < 0 || n > _depth) {
+        throw std::out_of_range("Invalid lattice level");
+    }
+    const double d = 1.0 + _D;
+    const double ud = (1.0 + _U) / d;
+
+    double d_pow_n = 1.0;
+    for (int k = 0; k < n; ++k) d_pow_n *= d;
+
+    std::vector<double> values(n + 1);
+    double S = _S0 * d_pow_n;
+    for (int i = 0; i <= n; ++i) {
+        values[i] = S;
+        S *= ud;
+    }
+    return values;
+}
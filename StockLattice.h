@@ -0,0 +1,51 @@
+#pragma once
+#include "BinaryTree.h"
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+/*Arbre binomial des prix du sous-jacent, immuable et construit à la demande.
+	Il ne dépend que de (S0, U, D, N) : une même instance peut être partagée (std::shared_ptr)
+	par plusieurs CRRPricer portant sur des strikes ou des types d'options différents.
+	La construction est réalisée au premier accès à un noeud, une seule fois, y compris
+	en cas d'accès concurrent depuis plusieurs threads.*/
+class StockLattice {
+private:
+	double _S0;		// Prix initial du sous-jacent
+	double _U, _D;	// Rendements à la hausse et à la baisse
+	int _depth;		// Profondeur de l'arbre
+
+	mutable std::once_flag _once;		// Construction unique
+	mutable std::atomic<bool> _built;	// Vrai une fois l'arbre construit
+	mutable BinaryTree<double> _tree;	// Valeurs du sous-jacent S(n,i)
+
+	// Construit l'arbre : S(n,0) = S0 * (1+D)^n et S(n,i+1) = S(n,i) * (1+U)/(1+D)
+	void build() const;
+
+public:
+	// La mémoire de l'arbre provient de resource (voir PricingArena) ; par défaut le tas global.
+	StockLattice(double asset_price, double up, double down, int depth,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	// Arbre partagé à partir des paramètres Black-Scholes : U = exp(sigma*sqrt(dt)) - 1, D = exp(-sigma*sqrt(dt)) - 1, dt = T/N.
+	static std::shared_ptr<const StockLattice> fromVolatility(double asset_price, double volatility, double expiry, int depth);
+
+	StockLattice(const StockLattice&) = delete;
+	StockLattice& operator=(const StockLattice&) = delete;
+
+	double getS0() const { return _S0; }
+	double getU() const { return _U; }
+	double getD() const { return _D; }
+	int getDepth() const { return _depth; }
+
+	// Indique si l'arbre complet a déjà été construit
+	bool isBuilt() const;
+
+	// Valeur du sous-jacent au noeud (n,i) ; construit l'arbre au premier appel.
+	double getNode(int n, int i) const;
+
+	// Valeurs de la ligne n, calculées sans construire l'arbre complet (mêmes valeurs que getNode(n, .)).
+	std::vector<double> level(int n) const;
+};
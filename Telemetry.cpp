@@ -0,0 +1,114 @@
+#include "Telemetry.h"
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+
+namespace {
+    // Registre des blocs de threads actifs et cumul des threads terminés.
+    struct Registry {
+        std::mutex mutex;
+        std::vector<TelemetryBlock*> blocks;
+        TelemetrySnapshot retired;
+    };
+
+    Registry& registry() {
+        static Registry* r = new Registry(); // jamais détruit : utilisable jusqu'à la fin des threads
+        return *r;
+    }
+
+    void accumulate(TelemetrySnapshot& s, const TelemetryBlock& b) {
+        for (int k = 0; k < TELEMETRY_COUNTER_COUNT; ++k)
+            s.counters[k] += b.counters[k].load(std::memory_order_relaxed);
+        for (int k = 0; k < TELEMETRY_TIMER_COUNT; ++k) {
+            s.timerNanos[k] += b.timerNanos[k].load(std::memory_order_relaxed);
+            s.timerCalls[k] += b.timerCalls[k].load(std::memory_order_relaxed);
+        }
+    }
+
+    // Enregistre le bloc à la création du thread et le reverse dans le cumul à sa terminaison.
+    struct ThreadBlock {
+        TelemetryBlock block;
+
+        ThreadBlock() {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.blocks.push_back(&block);
+        }
+
+        ~ThreadBlock() {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            accumulate(r.retired, block);
+            r.blocks.erase(std::remove(r.blocks.begin(), r.blocks.end(), &block), r.blocks.end());
+        }
+    };
+}
+
+TelemetryBlock& Telemetry::local() {
+    thread_local ThreadBlock tb;
+    return tb.block;
+}
+
+TelemetrySnapshot Telemetry::snapshot() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    TelemetrySnapshot s = r.retired;
+    for (const TelemetryBlock* b : r.blocks) accumulate(s, *b);
+    return s;
+}
+
+void Telemetry::reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.retired = TelemetrySnapshot();
+    for (TelemetryBlock* b : r.blocks) {
+        for (auto& c : b->counters) c.store(0, std::memory_order_relaxed);
+        for (auto& t : b->timerNanos) t.store(0, std::memory_order_relaxed);
+        for (auto& t : b->timerCalls) t.store(0, std::memory_order_relaxed);
+    }
+}
+
+const char* Telemetry::name(TelemetryCounter c) {
+    switch (c) {
+    case TelemetryCounter::NodesVisited: return "nodes_visited";
+    case TelemetryCounter::PathsGenerated: return "paths_generated";
+    case TelemetryCounter::RngDraws: return "rng_draws";
+    case TelemetryCounter::Allocations: return "allocations";
+    default: return "unknown";
+    }
+}
+
+const char* Telemetry::name(TelemetryTimer t) {
+    switch (t) {
+    case TelemetryTimer::CRRConstruction: return "crr_construction";
+    case TelemetryTimer::CRRCompute: return "crr_compute";
+    case TelemetryTimer::CRRClosedForm: return "crr_closed_form";
+    case TelemetryTimer::MCGenerate: return "mc_generate";
+    case TelemetryTimer::MCRng: return "mc_rng";
+    case TelemetryTimer::MCPathBuild: return "mc_path_build";
+    case TelemetryTimer::MCPayoff: return "mc_payoff";
+    case TelemetryTimer::BlackScholes: return "black_scholes";
+    default: return "unknown";
+    }
+}
+
+void TelemetrySnapshot::report(std::ostream& os) const {
+    if (!Telemetry::enabled()) {
+        os << "Telemetry disabled (compile with PRICING_TELEMETRY)." << '\n';
+        return;
+    }
+    for (int k = 0; k < TELEMETRY_COUNTER_COUNT; ++k) {
+        os << std::left << std::setw(20) << Telemetry::name(static_cast<TelemetryCounter>(k))
+            << std::right << std::setw(16) << counters[k] << '\n';
+    }
+    for (int k = 0; k < TELEMETRY_TIMER_COUNT; ++k) {
+        if (timerCalls[k] == 0) continue;
+        const double total = 1e-9 * static_cast<double>(timerNanos[k]);
+        os << std::left << std::setw(20) << Telemetry::name(static_cast<TelemetryTimer>(k))
+            << std::right << std::setw(16) << timerCalls[k] << " calls"
+            << std::setw(14) << std::fixed << std::setprecision(6) << total << " s"
+            << std::setw(14) << std::setprecision(1) << 1e9 * total / static_cast<double>(timerCalls[k]) << " ns/call"
+            << std::defaultfloat << '\n';
+    }
+}
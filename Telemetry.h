@@ -0,0 +1,135 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/*Instrumentation des chemins critiques des pricers : chronomètres de portée et compteurs par thread.
+	L'instrumentation n'est compilée que si PRICING_TELEMETRY est défini ; sinon les macros
+	TELEMETRY_SCOPE / TELEMETRY_COUNT ne génèrent aucun code et snapshot() retourne des zéros.
+	Chaque thread écrit uniquement dans son propre bloc de compteurs (aucune contention) ;
+	snapshot() additionne les blocs de tous les threads. Un chronomètre coûte deux lectures d'horloge : il entoure
+	un bloc de chemins ou une boucle complète, jamais un pas ou un chemin isolé (seuls les compteurs y figurent).*/
+
+// Compteurs disponibles
+enum class TelemetryCounter {
+	NodesVisited,	// noeuds d'arbre construits ou évalués
+	PathsGenerated,	// trajectoires Monte Carlo simulées
+	RngDraws,		// tirages gaussiens
+	Allocations,	// allocations de structures (lignes d'arbre, chemins)
+	Count
+};
+
+// Chronomètres disponibles
+enum class TelemetryTimer {
+	CRRConstruction,	// construction de l'arbre du sous-jacent (StockLattice)
+	CRRCompute,			// induction rétrograde CRRPricer::compute()
+	CRRClosedForm,		// formule fermée CRR
+	MCGenerate,			// BlackScholesMCPricer::generate() complet
+	MCRng,				// tirages aléatoires des boucles par lots de generate()
+	MCPathBuild,		// construction des trajectoires des boucles par lots de generate()
+	MCPayoff,			// évaluation des payoffs des boucles par lots de generate()
+	BlackScholes,		// BlackScholesPricer (prix et delta)
+	Count
+};
+
+constexpr int TELEMETRY_COUNTER_COUNT = static_cast<int>(TelemetryCounter::Count);
+constexpr int TELEMETRY_TIMER_COUNT = static_cast<int>(TelemetryTimer::Count);
+
+// Photographie agrégée (tous threads) des compteurs et chronomètres.
+struct TelemetrySnapshot {
+	std::uint64_t counters[TELEMETRY_COUNTER_COUNT] = {};
+	std::uint64_t timerNanos[TELEMETRY_TIMER_COUNT] = {};	// temps cumulé
+	std::uint64_t timerCalls[TELEMETRY_TIMER_COUNT] = {};	// nombre de passages
+
+	std::uint64_t counter(TelemetryCounter c) const { return counters[static_cast<int>(c)]; }
+	double seconds(TelemetryTimer t) const { return 1e-9 * static_cast<double>(timerNanos[static_cast<int>(t)]); }
+	std::uint64_t calls(TelemetryTimer t) const { return timerCalls[static_cast<int>(t)]; }
+
+	// Rapport lisible : une ligne par compteur et par chronomètre utilisé
+	void report(std::ostream& os) const;
+};
+
+// Bloc de compteurs propre à un thread. Un seul écrivain (le thread propriétaire) : les mises à jour
+// sont de simples load/store relâchés, la lecture concurrente par snapshot() reste bien définie.
+struct TelemetryBlock {
+	std::atomic<std::uint64_t> counters[TELEMETRY_COUNTER_COUNT] = {};
+	std::atomic<std::uint64_t> timerNanos[TELEMETRY_TIMER_COUNT] = {};
+	std::atomic<std::uint64_t> timerCalls[TELEMETRY_TIMER_COUNT] = {};
+};
+
+// Point d'accès global (non instanciable, comme MT).
+class Telemetry {
+private:
+	Telemetry() = default;
+
+public:
+	Telemetry(const Telemetry&) = delete;
+	Telemetry& operator=(const Telemetry&) = delete;
+
+	// Indique si l'instrumentation a été compilée
+	static constexpr bool enabled() {
+#ifdef PRICING_TELEMETRY
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	// Bloc du thread courant (créé et enregistré au premier appel)
+	static TelemetryBlock& local();
+
+	// Agrège les compteurs de tous les threads (y compris ceux déjà terminés)
+	static TelemetrySnapshot snapshot();
+
+	// Remet tous les compteurs à zéro
+	static void reset();
+
+	static const char* name(TelemetryCounter c);
+	static const char* name(TelemetryTimer t);
+
+	static void add(TelemetryCounter c, std::uint64_t n) {
+		std::atomic<std::uint64_t>& slot = local().counters[static_cast<int>(c)];
+		slot.store(slot.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+	}
+
+	static void addTime(TelemetryTimer t, std::uint64_t nanos) {
+		TelemetryBlock& block = local();
+		std::atomic<std::uint64_t>& ns = block.timerNanos[static_cast<int>(t)];
+		std::atomic<std::uint64_t>& calls = block.timerCalls[static_cast<int>(t)];
+		ns.store(ns.load(std::memory_order_relaxed) + nanos, std::memory_order_relaxed);
+		calls.store(calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+};
+
+// Chronomètre de portée : ajoute le temps écoulé entre construction et destruction au chronomètre donné.
+class TelemetryScope {
+private:
+	TelemetryTimer _timer;
+	std::chrono::steady_clock::time_point _start;
+
+public:
+	explicit TelemetryScope(TelemetryTimer timer)
+		: _timer(timer), _start(std::chrono::steady_clock::now()) {}
+
+	TelemetryScope(const TelemetryScope&) = delete;
+	TelemetryScope& operator=(const TelemetryScope&) = delete;
+
+	~TelemetryScope() {
+		const auto elapsed = std::chrono::steady_clock::now() - _start;
+		Telemetry::addTime(_timer, static_cast<std::uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+	}
+};
+
+#define TELEMETRY_CONCAT_IMPL(a, b) a##b
+#define TELEMETRY_CONCAT(a, b) TELEMETRY_CONCAT_IMPL(a, b)
+
+#ifdef PRICING_TELEMETRY
+#define TELEMETRY_SCOPE(timer) TelemetryScope TELEMETRY_CONCAT(_telemetryScope, __LINE__)(TelemetryTimer::timer)
+#define TELEMETRY_COUNT(counter, n) Telemetry::add(TelemetryCounter::counter, static_cast<std::uint64_t>(n))
+#else
+#define TELEMETRY_SCOPE(timer) ((void)0)
+#define TELEMETRY_COUNT(counter, n) ((void)0)
+#endif
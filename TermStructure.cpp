@@ -0,0 +1,83 @@
+#include "TermStructure.h"
+#include <algorithm>
+#include <stdexcept>
+
+TermStructure::TermStructure(const std::vector<double>& times, const std::vector<double>& values)
+    : _times(times), _values(values)
+{
+    if (times.empty() || times.size() != values.size()) {
+        throw std::invalid_argument("Term structure requires as many values as pillar times (at least one).");
+    }
+
+    double t_prev = 0.0;
+    double cumulative = 0.0;
+    double cumulativeSquared = 0.0;
+    for (std::size_t j = 0; j < times.size(); ++j) {
+        const double dt = times[j] - t_prev;
+        if (dt <= 0.0) {
+            throw std::invalid_argument("Term structure pillar times must be positive and increasing.");
+        }
+        cumulative += values[j] * dt;
+        cumulativeSquared += values[j] * values[j] * dt;
+        _cumulative.push_back(cumulative);
+        _cumulativeSquared.push_back(cumulativeSquared);
+        t_prev = times[j];
+    }
+}
+
+TermStructure TermStructure::flat(double value) {
+    return TermStructure({ 1.0 }, { value });
+}
+
+std::size_t TermStructure::segment(double t) const {
+    // Premier pilier >= t (le morceau j couvre ]t_{j-1}, t_j]) ; au-delà, dernier morceau
+    const std::size_t j = static_cast<std::size_t>(std::lower_bound(_times.begin(), _times.end(), t) - _times.begin());
+    return std::min(j, _times.size() - 1);
+}
+
+double TermStructure::value(double t) const {
+    return _values[segment(t)];
+}
+
+double TermStructure::primitive(double t) const {
+    const std::size_t j = segment(t);
+    const double start = j == 0 ? 0.0 : _times[j - 1];
+    const double base = j == 0 ? 0.0 : _cumulative[j - 1];
+    return base + _values[j] * (t - start);
+}
+
+double TermStructure::primitiveSquared(double t) const {
+    const std::size_t j = segment(t);
+    const double start = j == 0 ? 0.0 : _times[j - 1];
+    const double base = j == 0 ? 0.0 : _cumulativeSquared[j - 1];
+    return base + _values[j] * _values[j] * (t - start);
+}
+
+double TermStructure::integral(double t0, double t1) const {
+    return primitive(t1) - primitive(t0);
+}
+
+double TermStructure::integralSquared(double t0, double t1) const {
+    return primitiveSquared(t1) - primitiveSquared(t0);
+}
+
+double TermStructure::inverseIntegralSquared(double target) const {
+    if (target <= 0.0) return 0.0;
+
+    // Premier pilier dont la variance cumulée atteint la cible ; au-delà, prolongement par la dernière valeur
+    std::size_t j = static_cast<std::size_t>(
+        std::lower_bound(_cumulativeSquared.begin(), _cumulativeSquared.end(), target) - _cumulativeSquared.begin());
+    j = std::min(j, _times.size() - 1);
+
+    const double start = j == 0 ? 0.0 : _times[j - 1];
+    const double base = j == 0 ? 0.0 : _cumulativeSquared[j - 1];
+    const double v2 = _values[j] * _values[j];
+    if (v2 <= 0.0) {
+        throw std::invalid_argument("Cannot invert integrated variance over a zero-volatility segment.");
+    }
+    return start + (target - base) / v2;
+}
+
+bool TermStructure::isFlat() const {
+    return std::all_of(_values.begin(), _values.end(), [this](double v) { return v == _values.front(); });
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+
+/*Courbe constante par morceaux (taux ou volatilité) : valeur v_j sur ]t_{j-1}, t_j], t_0 = 0,
+	prolongée par la dernière valeur au-delà du dernier pilier.
+	Les intégrales cumulées de v et de v^2 sont précalculées aux piliers : integral() et
+	integralSquared() coûtent une recherche dichotomique, indépendamment de l'intervalle demandé.*/
+class TermStructure {
+private:
+	std::vector<double> _times;		// piliers t_1 < ... < t_k
+	std::vector<double> _values;	// v_1, ..., v_k
+	std::vector<double> _cumulative;		// int_0^{t_j} v
+	std::vector<double> _cumulativeSquared;	// int_0^{t_j} v^2
+
+	// Indice du morceau contenant t
+	std::size_t segment(double t) const;
+
+	// Primitives de v et v^2 en t (depuis 0)
+	double primitive(double t) const;
+	double primitiveSquared(double t) const;
+
+public:
+	// Courbe à partir des piliers (strictement croissants, positifs) et des valeurs associées.
+	TermStructure(const std::vector<double>& times, const std::vector<double>& values);
+
+	// Courbe constante
+	static TermStructure flat(double value);
+
+	// Piliers et valeurs
+	const std::vector<double>& getTimes() const { return _times; }
+	const std::vector<double>& getValues() const { return _values; }
+
+	// Valeur instantanée en t
+	double value(double t) const;
+
+	// int_{t0}^{t1} v(s) ds
+	double integral(double t0, double t1) const;
+
+	// int_{t0}^{t1} v(s)^2 ds (variance intégrée pour une courbe de volatilité)
+	double integralSquared(double t0, double t1) const;
+
+	// Date tau telle que int_0^tau v^2 = target (inverse de la variance intégrée ; v doit être non nulle)
+	double inverseIntegralSquared(double target) const;
+
+	// Indique si la courbe est constante
+	bool isFlat() const;
+};
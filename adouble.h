@@ -0,0 +1,96 @@
+#pragma once
+#include "AADTape.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+/*Réel actif pour la différentiation automatique adjointe : une valeur et l'indice de son noeud sur la bande
+	active du thread (AADTape::active()). Une constante (construite depuis un double) n'a pas de noeud et
+	n'est pas enregistrée ; une opération entre constantes reste une constante. Sans bande active, adouble
+	se comporte comme un double.
+	Les comparaisons portent sur les valeurs : un branchement (exercice américain, max du payoff) n'est
+	pas dérivé, seule la branche suivie l'est (dérivée trajectorielle).*/
+class adouble {
+private:
+	double _value;
+	std::uint32_t _index;	// noeud sur la bande, AADTape::NO_PARENT pour une constante
+
+	adouble(double value, std::uint32_t index) : _value(value), _index(index) {}
+
+	// Résultat d'une opération unaire de dérivée d
+	static adouble unary(double value, const adouble& x, double d) {
+		AADTape* tape = AADTape::active();
+		if (!tape || x.isConstant()) return adouble(value);
+		return adouble(value, tape->record(x._index, d));
+	}
+
+	// Résultat d'une opération binaire de dérivées dx, dy
+	static adouble binary(double value, const adouble& x, double dx, const adouble& y, double dy) {
+		AADTape* tape = AADTape::active();
+		if (!tape || (x.isConstant() && y.isConstant())) return adouble(value);
+		if (x.isConstant()) return adouble(value, tape->record(y._index, dy));
+		if (y.isConstant()) return adouble(value, tape->record(x._index, dx));
+		return adouble(value, tape->record(x._index, dx, y._index, dy));
+	}
+
+public:
+	adouble(double value = 0.0) : _value(value), _index(AADTape::NO_PARENT) {}
+
+	// Entrée du calcul : noeud sans parent sur la bande active (dont on lira l'adjoint)
+	static adouble input(double value) {
+		AADTape* tape = AADTape::active();
+		return tape ? adouble(value, tape->record()) : adouble(value);
+	}
+
+	double value() const { return _value; }
+	std::uint32_t index() const { return _index; }
+	bool isConstant() const { return _index == AADTape::NO_PARENT; }
+
+	// Dérivée de la sortie par rapport à ce réel, après AADTape::propagate()
+	double adjoint() const {
+		AADTape* tape = AADTape::active();
+		return tape && !isConstant() ? tape->adjoint(_index) : 0.0;
+	}
+
+	/*Fonction boîte noire f (ex : Option::payoff) appliquée à x : dérivée locale par différence finie centrée
+	  de pas relatif h. Une seule évaluation supplémentaire de f par côté, quel que soit le nombre d'entrées.*/
+	static adouble blackBox(const std::function<double(double)>& f, const adouble& x, double h = 1e-6) {
+		const double value = f(x._value);
+		if (x.isConstant() || !AADTape::active()) return adouble(value);
+		const double step = h * std::max(1.0, std::abs(x._value));
+		const double d = (f(x._value + step) - f(x._value - step)) / (2.0 * step);
+		return unary(value, x, d);
+	}
+
+	friend adouble operator+(const adouble& x, const adouble& y) { return binary(x._value + y._value, x, 1.0, y, 1.0); }
+	friend adouble operator-(const adouble& x, const adouble& y) { return binary(x._value - y._value, x, 1.0, y, -1.0); }
+	friend adouble operator*(const adouble& x, const adouble& y) { return binary(x._value * y._value, x, y._value, y, x._value); }
+	friend adouble operator/(const adouble& x, const adouble& y) {
+		const double inv = 1.0 / y._value;
+		return binary(x._value * inv, x, inv, y, -x._value * inv * inv);
+	}
+	friend adouble operator-(const adouble& x) { return unary(-x._value, x, -1.0); }
+
+	adouble& operator+=(const adouble& y) { return *this = *this + y; }
+	adouble& operator-=(const adouble& y) { return *this = *this - y; }
+	adouble& operator*=(const adouble& y) { return *this = *this * y; }
+	adouble& operator/=(const adouble& y) { return *this = *this / y; }
+
+	friend bool operator<(const adouble& x, const adouble& y) { return x._value < y._value; }
+	friend bool operator>(const adouble& x, const adouble& y) { return x._value > y._value; }
+	friend bool operator<=(const adouble& x, const adouble& y) { return x._value <= y._value; }
+	friend bool operator>=(const adouble& x, const adouble& y) { return x._value >= y._value; }
+
+	friend adouble exp(const adouble& x) { const double e = std::exp(x._value); return unary(e, x, e); }
+	friend adouble log(const adouble& x) { return unary(std::log(x._value), x, 1.0 / x._value); }
+	friend adouble sqrt(const adouble& x) { const double s = std::sqrt(x._value); return unary(s, x, 0.5 / s); }
+	friend adouble pow(const adouble& x, double a) {
+		const double p = std::pow(x._value, a);
+		return unary(p, x, a * std::pow(x._value, a - 1.0));
+	}
+	friend adouble erfc(const adouble& x) {
+		// d/dx erfc(x) = -2 / sqrt(pi) exp(-x^2)
+		return unary(std::erfc(x._value), x, -1.1283791670955126 * std::exp(-x._value * x._value));
+	}
+	friend adouble max(const adouble& x, const adouble& y) { return x._value >= y._value ? x : y; }
+};
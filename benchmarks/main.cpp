@@ -0,0 +1,809 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "CallOption.h"
+#include "PutOption.h"
+#include "EuropeanDigitalCallOption.h"
+#include "AmericanPutOption.h"
+#include "AsianCallOption.h"
+#include "AsianAnalyticPricer.h"
+#include "BarrierCallOption.h"
+#include "BasketCallOption.h"
+#include "SpreadCallOption.h"
+#include "MultiAssetMCPricer.h"
+#include "BlackScholesPricer.h"
+#include "BlackScholesMCPricer.h"
+#include "CRRPricer.h"
+#include "CRRBatchPricer.h"
+#include "ChebyshevPricer.h"
+#include "HestonMCPricer.h"
+#include "HedgingSimulator.h"
+#include "PricingScheduler.h"
+#include "PricingCache.h"
+#include "ScriptedOption.h"
+#include "FourierPricer.h"
+#include "BlackScholesModel.h"
+#include "SmileCalibrator.h"
+#include "TermStructure.h"
+#include "LocalVolSurface.h"
+#include "BinaryTree.h"
+#include "MT.h"
+
+/*Suite de benchmarks des pricers.
+	Chaque benchmark mesure le temps par opération et le débit, et rapporte une colonne de précision
+	(valeur obtenue, valeur de référence, erreur). Les résultats sont écrits dans un fichier JSON
+	afin de pouvoir comparer les exécutions dans le temps.
+
+	Options : --out <fichier.json> (défaut : benchmark_results.json)
+	          --min-time <secondes> (durée minimale de mesure par benchmark, défaut : 0.5)
+	          --max-depth <N> (profondeur CRR maximale, défaut : 5000 ; 20000 demande plusieurs Go de mémoire)
+	          --filter <texte> (n'exécute que les benchmarks dont le nom contient le texte)*/
+
+namespace {
+
+    const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+    // Résultat d'une opération de benchmark : valeur mesurée et référence pour la colonne de précision.
+    // Sans référence, error peut porter une estimation de l'erreur (ex : demi-largeur de l'IC Monte Carlo).
+    struct Sample {
+        double value = NaN;
+        double reference = NaN;
+        double error = NaN;
+    };
+
+    double absError(const Sample& s) {
+        return std::isnan(s.error) ? std::fabs(s.value - s.reference) : s.error;
+    }
+
+    // Description d'un benchmark : run(iterations) exécute l'opération "iterations" fois.
+    struct Benchmark {
+        std::string name;
+        double itemsPerOp;                          // éléments traités par opération (chemins, noeuds, ...)
+        std::function<Sample(long long)> run;
+        std::function<double()> reference = {};    // référence coûteuse, calculée hors mesure (optionnelle)
+    };
+
+    struct Result {
+        std::string name;
+        long long iterations;
+        double nsPerOp;
+        double itemsPerSecond;
+        Sample sample;
+    };
+
+    volatile double sink = 0.0; // empêche l'élimination des calculs par le compilateur
+
+    // Exécute un benchmark en doublant le nombre d'itérations jusqu'à atteindre la durée minimale.
+    Result measure(const Benchmark& b, double minTime) {
+        long long iterations = 1;
+        for (;;) {
+            const auto t0 = std::chrono::steady_clock::now();
+            const Sample s = b.run(iterations);
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+            if (elapsed >= minTime || iterations >= (1LL << 40)) {
+                const double perOp = elapsed / static_cast<double>(iterations);
+                Result result{ b.name, iterations, perOp * 1e9, b.itemsPerOp / perOp, s };
+                if (b.reference) result.sample.reference = b.reference();
+                return result;
+            }
+            // Estimation du nombre d'itérations nécessaire (au plus x10 par tour)
+            const double factor = elapsed > 0.0 ? std::min(10.0, 1.4 * minTime / elapsed) : 10.0;
+            iterations = std::max(iterations + 1, static_cast<long long>(static_cast<double>(iterations) * factor));
+        }
+    }
+
+    std::string jsonNumber(double x) {
+        if (!std::isfinite(x)) return "null";
+        std::ostringstream os;
+        os << std::setprecision(17) << x;
+        return os.str();
+    }
+
+    void writeJson(const std::string& path, const std::vector<Result>& results) {
+        std::ofstream out(path);
+        if (!out) {
+            throw std::runtime_error("Cannot open file for writing: " + path);
+        }
+        out << "{\n  \"benchmarks\": [\n";
+        for (std::size_t k = 0; k < results.size(); ++k) {
+            const Result& r = results[k];
+            const double error = absError(r.sample);
+            out << "    {\"name\": \"" << r.name << "\""
+                << ", \"iterations\": " << r.iterations
+                << ", \"ns_per_op\": " << jsonNumber(r.nsPerOp)
+                << ", \"items_per_second\": " << jsonNumber(r.itemsPerSecond)
+                << ", \"value\": " << jsonNumber(r.sample.value)
+                << ", \"reference\": " << jsonNumber(r.sample.reference)
+                << ", \"abs_error\": " << jsonNumber(error)
+                << "}" << (k + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    void printResult(const Result& r) {
+        const double error = absError(r.sample);
+        std::cout << std::left << std::setw(44) << r.name << std::right
+            << std::setw(14) << std::setprecision(4) << std::scientific << r.nsPerOp
+            << std::setw(14) << r.itemsPerSecond
+            << std::setw(14) << std::defaultfloat << std::setprecision(6) << r.sample.value
+            << std::setw(14) << r.sample.reference
+            << std::setw(14) << std::setprecision(3) << error << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string outPath = "benchmark_results.json";
+    std::string filter;
+    double minTime = 0.5;
+    int maxDepth = 5000;
+
+    for (int a = 1; a < argc; ++a) {
+        const std::string arg = argv[a];
+        if (a + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        }
+        if (arg == "--out") outPath = argv[++a];
+        else if (arg == "--min-time") minTime = std::atof(argv[++a]);
+        else if (arg == "--max-depth") maxDepth = std::atoi(argv[++a]);
+        else if (arg == "--filter") filter = argv[++a];
+        else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    // Paramètres de marché communs
+    const double S0(100.), K(101.), T(1.0), r(0.01), sigma(0.2);
+
+    CallOption call(T, K);
+    PutOption put(T, K);
+    EuropeanDigitalCallOption digital(T, K);
+    AmericanPutOption americanPut(T, K);
+
+    const double callRef = BlackScholesPricer(&call, S0, r, sigma)();
+
+    // Références indépendantes pour la formule fermée : parité call-put, différences finies
+    const double parityRef = BlackScholesPricer(&put, S0, r, sigma)() + S0 - K * std::exp(-r * T);
+    const double h = 1e-4;
+    const double deltaRef = (BlackScholesPricer(&call, S0 + h, r, sigma)() - BlackScholesPricer(&call, S0 - h, r, sigma)()) / (2.0 * h);
+    CallOption callUp(T, K + h), callDown(T, K - h);
+    const double digitalRef = (BlackScholesPricer(&callDown, S0, r, sigma)() - BlackScholesPricer(&callUp, S0, r, sigma)()) / (2.0 * h);
+
+    std::vector<Benchmark> benchmarks;
+
+    // Black-Scholes : formule fermée (prix et delta)
+    benchmarks.push_back({ "BlackScholesPricer/call/price", 1.0, [&](long long n) {
+        double acc = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            BlackScholesPricer pricer(&call, S0 + 1e-9 * static_cast<double>(k & 7), r, sigma);
+            acc += pricer();
+        }
+        sink = acc;
+        return Sample{ BlackScholesPricer(&call, S0, r, sigma)(), parityRef };
+    } });
+    benchmarks.push_back({ "BlackScholesPricer/call/delta", 1.0, [&](long long n) {
+        double acc = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            BlackScholesPricer pricer(&call, S0 + 1e-9 * static_cast<double>(k & 7), r, sigma);
+            acc += pricer.delta();
+        }
+        sink = acc;
+        return Sample{ BlackScholesPricer(&call, S0, r, sigma).delta(), deltaRef };
+    } });
+    benchmarks.push_back({ "BlackScholesPricer/digital/price", 1.0, [&](long long n) {
+        double acc = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            BlackScholesPricer pricer(&digital, S0 + 1e-9 * static_cast<double>(k & 7), r, sigma);
+            acc += pricer();
+        }
+        sink = acc;
+        return Sample{ BlackScholesPricer(&digital, S0, r, sigma)(), digitalRef };
+    } });
+
+    // Sensibilités AAD (delta, rho, vega en une propagation) : la précision porte sur le delta
+    benchmarks.push_back({ "BlackScholesPricer/call/greeks_aad", 1.0, [&](long long n) {
+        Greeks greeks;
+        for (long long k = 0; k < n; ++k) {
+            greeks = BlackScholesPricer(&call, S0 + 1e-9 * static_cast<double>(k & 7), r, sigma).greeks();
+        }
+        sink = greeks.vega;
+        return Sample{ greeks.delta, deltaRef };
+    } });
+    benchmarks.push_back({ "CRRPricer/european/greeks_aad/N=500", 0.5 * 501.0 * 502.0, [&](long long n) {
+        Greeks greeks;
+        for (long long k = 0; k < n; ++k) {
+            greeks = CRRPricer(&call, 500, S0, r, sigma).greeks();
+        }
+        sink = greeks.vega;
+        return Sample{ greeks.delta, deltaRef };
+    } });
+    benchmarks.push_back({ "BlackScholesMCPricer/european_call/greeks_aad/paths", 10000.0, [&](long long n) {
+        BlackScholesMCPricer pricer(&call, S0, r, sigma);
+        Greeks greeks;
+        for (long long k = 0; k < n; ++k) greeks = pricer.greeks(10000);
+        return Sample{ greeks.delta, deltaRef };
+    } });
+
+    // CRR : construction + induction (européen et américain) et formule fermée, sur plusieurs profondeurs
+    for (int depth : { 100, 500, 1000, 2000, 5000, 10000, 20000 }) {
+        if (depth > maxDepth) continue;
+        const double nodes = 0.5 * (depth + 1.0) * (depth + 2.0);
+        const std::string d = std::to_string(depth);
+
+        benchmarks.push_back({ "CRRPricer/european/compute/N=" + d, nodes, [&, depth](long long n) {
+            double price = 0.0;
+            for (long long k = 0; k < n; ++k) {
+                CRRPricer pricer(&call, depth, S0, r, sigma);
+                price = pricer();
+            }
+            sink = price;
+            return Sample{ price, callRef };
+        } });
+        benchmarks.push_back({ "CRRPricer/european/closed_form/N=" + d, nodes, [&, depth](long long n) {
+            double price = 0.0;
+            for (long long k = 0; k < n; ++k) {
+                CRRPricer pricer(&call, depth, S0, r, sigma);
+                price = pricer(true);
+            }
+            sink = price;
+            return Sample{ price, callRef };
+        } });
+        benchmarks.push_back({ "CRRPricer/american_put/compute/N=" + d, nodes, [&, depth](long long n) {
+            double price = 0.0;
+            for (long long k = 0; k < n; ++k) {
+                CRRPricer pricer(&americanPut, depth, S0, r, sigma);
+                price = pricer();
+            }
+            sink = price;
+            return Sample{ price, NaN };
+        } });
+    }
+
+    // Induction parallèle par tuiles : écart au compute() séquentiel, puis passage à l'échelle de 1 à 64 threads
+    // sur un arbre 4 fois plus profond (la référence est le même calcul sur un seul thread)
+    const double serialAmericanRef = CRRPricer(&americanPut, maxDepth, S0, r, sigma)();
+    benchmarks.push_back({ "CRRPricer/american_put/tiled/N=" + std::to_string(maxDepth), 0.5 * (maxDepth + 1.0) * (maxDepth + 2.0), [&](long long n) {
+        double price = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            CRRPricer pricer(&americanPut, maxDepth, S0, r, sigma);
+            pricer.setParallel(1);
+            price = pricer();
+        }
+        return Sample{ price, serialAmericanRef };
+    } });
+    const int deepDepth = 4 * maxDepth;
+    for (int threads : { 1, 2, 4, 8, 16, 32, 64 }) {
+        benchmarks.push_back({ "CRRPricer/american_put/parallel/N=" + std::to_string(deepDepth) + "/threads=" + std::to_string(threads),
+            0.5 * (deepDepth + 1.0) * (deepDepth + 2.0), [&, threads, deepDepth](long long n) {
+            double price = 0.0;
+            for (long long k = 0; k < n; ++k) {
+                CRRPricer pricer(&americanPut, deepDepth, S0, r, sigma);
+                pricer.setParallel(threads);
+                price = pricer();
+            }
+            return Sample{ price, NaN };
+        }, [&, deepDepth]() {
+            CRRPricer pricer(&americanPut, deepDepth, S0, r, sigma);
+            pricer.setParallel(1);
+            return pricer();
+        } });
+    }
+
+    // Arbre de prix en simple précision : la précision est l'écart au compute() en double
+    benchmarks.push_back({ "CRRPricer/american_put/single_precision/N=" + std::to_string(maxDepth), 0.5 * (maxDepth + 1.0) * (maxDepth + 2.0), [&](long long n) {
+        double price = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            CRRPricer pricer(&americanPut, maxDepth, S0, r, sigma);
+            pricer.setPrecision(SinglePrecision);
+            price = pricer();
+        }
+        return Sample{ price, serialAmericanRef };
+    } });
+
+    // Arbre tronqué à +/- 8 écarts-types : même unité de travail que l'arbre complet, référence = compute() complet
+    const double fullCallRef = CRRPricer(&call, maxDepth, S0, r, sigma)();
+    benchmarks.push_back({ "CRRPricer/european/pruned_k8/N=" + std::to_string(maxDepth), 0.5 * (maxDepth + 1.0) * (maxDepth + 2.0), [&](long long n) {
+        double price = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            CRRPricer pricer(&call, maxDepth, S0, r, sigma);
+            pricer.setPruning(8.0);
+            price = pricer();
+        }
+        return Sample{ price, fullCallRef };
+    } });
+    benchmarks.push_back({ "CRRPricer/american_put/pruned_k8/N=" + std::to_string(maxDepth), 0.5 * (maxDepth + 1.0) * (maxDepth + 2.0), [&](long long n) {
+        double price = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            CRRPricer pricer(&americanPut, maxDepth, S0, r, sigma);
+            pricer.setPruning(8.0);
+            price = pricer();
+        }
+        return Sample{ price, serialAmericanRef };
+    } });
+
+    // Proxy de Chebyshev d'un put américain sur (S, sigma, tau) : construction (prix d'arbre par noeud de la grille),
+    // puis évaluation ; la précision de l'évaluation est l'écart au prix de l'arbre au même point
+    const ChebyshevPricer::Domain proxyDomain{ 0.8 * S0, 1.2 * S0, 0.75 * sigma, 1.5 * sigma, 0.25 * T, T };
+    benchmarks.push_back({ "ChebyshevPricer/american_put/build/nodes=16x8x8", 16.0 * 8.0 * 8.0, [&](long long n) {
+        double error = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            error = ChebyshevPricer(&americanPut, r, proxyDomain, 16, 8, 8, 200).getMaxError();
+        }
+        return Sample{ NaN, NaN, error };
+    } });
+    auto proxy = std::make_shared<ChebyshevPricer>(&americanPut, r, proxyDomain, 16, 8, 8, 200);
+    const double proxySpot = 0.97 * S0;
+    const double proxyRef = 0.5 * (CRRPricer(&americanPut, 200, proxySpot, r, sigma)() + CRRPricer(&americanPut, 201, proxySpot, r, sigma)());
+    benchmarks.push_back({ "ChebyshevPricer/american_put/eval", 1.0, [&, proxy](long long n) {
+        double price = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            price = (*proxy)(proxySpot + 1e-9 * static_cast<double>(k & 7), sigma, T);
+        }
+        sink = price;
+        return Sample{ price, proxyRef };
+    } });
+
+    // Lot de 64 puts américains (strikes, spots et volatilités différents) : CRRBatchPricer contre une boucle de
+    // CRRPricer ; la précision est l'écart maximal entre les deux (nul : mêmes opérations flottantes)
+    const int batchDepth = std::min(1000, maxDepth);
+    std::vector<std::unique_ptr<AmericanPutOption>> batchPuts;
+    for (int j = 0; j < 64; ++j) batchPuts.push_back(std::make_unique<AmericanPutOption>(T, 0.8 * K + 0.4 * j));
+    auto batchSpot = [S0](int j) { return S0 * (0.9 + 0.003 * j); };
+    auto batchVol = [sigma](int j) { return sigma * (0.75 + 0.01 * j); };
+    std::vector<double> loopPrices(batchPuts.size());
+    for (std::size_t j = 0; j < batchPuts.size(); ++j) {
+        loopPrices[j] = CRRPricer(batchPuts[j].get(), batchDepth, batchSpot(j), r, batchVol(j))();
+    }
+    benchmarks.push_back({ "CRRPricer/american_put/loop64/N=" + std::to_string(batchDepth), static_cast<double>(batchPuts.size()), [&](long long n) {
+        double acc = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            for (std::size_t j = 0; j < batchPuts.size(); ++j) {
+                acc += CRRPricer(batchPuts[j].get(), batchDepth, batchSpot(j), r, batchVol(j))();
+            }
+        }
+        sink = acc;
+        return Sample{ loopPrices[0], NaN };
+    } });
+    benchmarks.push_back({ "CRRBatchPricer/american_put/batch64/N=" + std::to_string(batchDepth), static_cast<double>(batchPuts.size()), [&](long long n) {
+        std::vector<double> prices;
+        for (long long k = 0; k < n; ++k) {
+            CRRBatchPricer batch(batchDepth);
+            for (std::size_t j = 0; j < batchPuts.size(); ++j) batch.add(batchPuts[j].get(), batchSpot(j), r, batchVol(j));
+            prices = batch();
+        }
+        double maxError = 0.0;
+        for (std::size_t j = 0; j < prices.size(); ++j) maxError = std::max(maxError, std::abs(prices[j] - loopPrices[j]));
+        return Sample{ maxError, 0.0 };
+    } });
+
+    // BinaryTree : coût unitaire de setNode / getNode
+    for (int depth : { 100, 1000 }) {
+        const double nodes = 0.5 * (depth + 1.0) * (depth + 2.0);
+        const std::string d = std::to_string(depth);
+        auto tree = std::make_shared<BinaryTree<double>>();
+        tree->setDepth(depth);
+
+        benchmarks.push_back({ "BinaryTree/setNode/N=" + d, nodes, [tree, depth](long long n) {
+            for (long long k = 0; k < n; ++k)
+                for (int i = 0; i <= depth; ++i)
+                    for (int j = 0; j <= i; ++j)
+                        tree->setNode(i, j, static_cast<double>(j));
+            return Sample{};
+        } });
+        benchmarks.push_back({ "BinaryTree/getNode/N=" + d, nodes, [tree, depth](long long n) {
+            double acc = 0.0;
+            for (long long k = 0; k < n; ++k)
+                for (int i = 0; i <= depth; ++i)
+                    for (int j = 0; j <= i; ++j)
+                        acc += tree->getNode(i, j);
+            sink = acc;
+            return Sample{};
+        } });
+        benchmarks.push_back({ "BinaryTree/setDepth/N=" + d, nodes, [tree, depth](long long n) {
+            for (long long k = 0; k < n; ++k) {
+                tree->setDepth(depth / 2);
+                tree->setDepth(depth);
+            }
+            return Sample{};
+        } });
+    }
+
+    // Monte Carlo : chemins par seconde ; la précision est l'écart au prix fermé (européen)
+    // ou la demi-largeur de l'intervalle de confiance (asiatique).
+    const int pathsPerOp = 10000;
+    benchmarks.push_back({ "BlackScholesMCPricer/european_call/paths", static_cast<double>(pathsPerOp), [&](long long n) {
+        BlackScholesMCPricer pricer(&call, S0, r, sigma);
+        for (long long k = 0; k < n; ++k) pricer.generate(pathsPerOp);
+        return Sample{ pricer(), callRef };
+    } });
+
+    benchmarks.push_back({ "BlackScholesMCPricer/european_call/single_precision/paths", static_cast<double>(pathsPerOp), [&](long long n) {
+        BlackScholesMCPricer pricer(&call, S0, r, sigma);
+        pricer.setPrecision(SinglePrecision);
+        for (long long k = 0; k < n; ++k) pricer.generate(pathsPerOp);
+        return Sample{ pricer(), callRef };
+    } });
+
+    // Point de reprise : un pricer rechargé depuis le fichier et prolongé donne exactement le prix du calcul non
+    // interrompu (mêmes tirages, générateur restauré) ; la valeur est le prix repris, la référence le prix continu.
+    const std::string checkpointPath = outPath + ".checkpoint";
+    benchmarks.push_back({ "BlackScholesMCPricer/european_call/checkpoint_resume/paths", static_cast<double>(pathsPerOp), [&](long long n) {
+        BlackScholesMCPricer uninterrupted(&call, S0, r, sigma);
+        double resumedPrice = NaN;
+        for (long long k = 0; k < n; ++k) {
+            uninterrupted.generate(pathsPerOp);
+            uninterrupted.saveCheckpoint(checkpointPath);
+            uninterrupted.generate(pathsPerOp);
+
+            BlackScholesMCPricer resumed(&call, S0, r, sigma);
+            resumed.loadCheckpoint(checkpointPath);
+            resumed.generate(pathsPerOp);
+            resumedPrice = resumed();
+        }
+        std::remove(checkpointPath.c_str());
+        return Sample{ resumedPrice, uninterrupted() };
+    } });
+
+    // Agrégation de deux exécutions de graines différentes : la référence est un seul pricer qui enchaîne les deux
+    // séries de tirages (l'écart n'est que l'arrondi de la formule de combinaison).
+    benchmarks.push_back({ "BlackScholesMCPricer/european_call/merge/paths", 2.0 * pathsPerOp, [&](long long n) {
+        BlackScholesMCPricer merged(&call, S0, r, sigma), sequential(&call, S0, r, sigma);
+        for (long long k = 0; k < n; ++k) {
+            const std::uint32_t seed = static_cast<std::uint32_t>(2 * k + 1);
+            BlackScholesMCPricer other(&call, S0, r, sigma);
+            MT::seed(seed);
+            merged.generate(pathsPerOp);
+            MT::seed(seed + 1);
+            other.generate(pathsPerOp);
+            merged.merge(other.getState());
+
+            MT::seed(seed);
+            sequential.generate(pathsPerOp);
+            MT::seed(seed + 1);
+            sequential.generate(pathsPerOp);
+        }
+        return Sample{ merged(), sequential() };
+    } });
+
+    // Digitale très hors de la monnaie : tirages simples contre échantillonnage préférentiel stratifié (Automatic).
+    // La précision est la demi-largeur de l'IC, à comparer entre les deux pour un même nombre de chemins.
+    EuropeanDigitalCallOption tailDigital(T, 1.5 * S0);
+    const double tailDigitalRef = BlackScholesPricer(&tailDigital, S0, r, sigma)();
+    for (const bool automatic : { false, true }) {
+        benchmarks.push_back({ std::string("BlackScholesMCPricer/otm_digital_call/") + (automatic ? "automatic" : "plain") + "/paths",
+            static_cast<double>(pathsPerOp), [&, automatic](long long n) {
+            BlackScholesMCPricer pricer(&tailDigital, S0, r, sigma);
+            pricer.setSampling(automatic ? BlackScholesMCPricer::Automatic : BlackScholesMCPricer::Plain);
+            for (long long k = 0; k < n; ++k) pricer.generate(pathsPerOp);
+            const std::vector<double> ci = pricer.confidenceInterval();
+            return Sample{ pricer(), tailDigitalRef, 0.5 * (ci[1] - ci[0]) };
+        } });
+    }
+
+    // Courbes constantes par morceaux de mêmes taux et variance intégrés que les paramètres constants, et surface
+    // de volatilité locale plate : le prix européen de référence est inchangé.
+    const TermStructure rateCurve({ 0.25 * T, T }, { 2.0 * r, 2.0 * r / 3.0 });
+    const TermStructure volatilityCurve({ 0.5 * T, T }, { 0.5 * sigma, std::sqrt(1.75) * sigma });
+    auto flatSurface = std::make_shared<const LocalVolSurface>([sigma](double, double) { return sigma; }, 0.1 * S0, 10.0 * S0, T);
+    benchmarks.push_back({ "BlackScholesMCPricer/european_call/term_structure/paths", static_cast<double>(pathsPerOp), [&](long long n) {
+        BlackScholesMCPricer pricer(&call, S0, r, sigma);
+        pricer.setTermStructures(rateCurve, volatilityCurve);
+        for (long long k = 0; k < n; ++k) pricer.generate(pathsPerOp);
+        return Sample{ pricer(), callRef };
+    } });
+    benchmarks.push_back({ "BlackScholesMCPricer/european_call/local_vol/paths", static_cast<double>(pathsPerOp), [&](long long n) {
+        BlackScholesMCPricer pricer(&call, S0, r, sigma);
+        pricer.setLocalVolatility(flatSurface, 52);
+        for (long long k = 0; k < n; ++k) pricer.generate(pathsPerOp);
+        return Sample{ pricer(), callRef };
+    } });
+    benchmarks.push_back({ "CRRPricer/european_call/term_structure/depth=" + std::to_string(std::min(1000, maxDepth)), 1.0, [&](long long n) {
+        double acc = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            CRRPricer pricer(&call, std::min(1000, maxDepth), S0, rateCurve, volatilityCurve);
+            acc += pricer();
+        }
+        sink = acc;
+        return Sample{ acc / static_cast<double>(n), callRef };
+    } });
+
+    // Fourier (Carr-Madan) : grille de 200 strikes en une FFT, comparée point par point à BlackScholesPricer
+    std::vector<double> strikeGrid;
+    for (int j = 0; j < 200; ++j) strikeGrid.push_back(0.5 * S0 + j * S0 / 200.0);
+    benchmarks.push_back({ "FourierPricer/call_grid/strikes=200", static_cast<double>(strikeGrid.size()), [&](long long n) {
+        double maxError = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            FourierPricer pricer(std::make_shared<BlackScholesModel>(sigma));
+            const std::vector<double> prices = pricer.callPrices(S0, r, T, strikeGrid);
+            if (k == 0) {
+                for (std::size_t j = 0; j < prices.size(); ++j) {
+                    CallOption option(T, strikeGrid[j]);
+                    maxError = std::max(maxError, std::abs(prices[j] - BlackScholesPricer(&option, S0, r, sigma)()));
+                }
+            }
+            sink = prices.back();
+        }
+        return Sample{ maxError, 0.0 };
+    } });
+
+    // Calibration d'un smile (4 maturités x 50 strikes) sur des prix générés par un smile connu : l'erreur est le RMSE prix
+    CalibrationProblem smileProblem{ S0, r, {} };
+    for (const double expiry : { 0.25, 0.5, 1.0, 2.0 }) {
+        for (int j = 0; j < 50; ++j) {
+            const double strike = S0 * (0.6 + 0.016 * j);
+            const double k = std::log(strike / (S0 * std::exp(r * expiry)));
+            CallOption option(expiry, strike);
+            const double price = BlackScholesPricer(&option, S0, r, 0.2 - 0.1 * k + 0.05 * k * k)();
+            smileProblem.quotes.push_back({ strike, expiry, price });
+        }
+    }
+    benchmarks.push_back({ "SmileCalibrator/quotes=200", 1.0, [&](long long n) {
+        SmileCalibrator calibrator;
+        CalibrationResult result;
+        for (long long k = 0; k < n; ++k) {
+            result = calibrator.calibrate(smileProblem, calibrator.initialGuess(smileProblem));
+        }
+        return Sample{ result.rmse, 0.0 };
+    } });
+
+    // Heston (schéma QE, threads) : la référence est le prix semi-analytique de Fourier
+    const HestonModel heston(sigma * sigma, 1.5, sigma * sigma, 0.5, -0.7);
+    benchmarks.push_back({ "HestonMCPricer/european_call/paths", static_cast<double>(pathsPerOp), [&](long long n) {
+        HestonMCPricer pricer(&call, S0, r, heston);
+        for (long long k = 0; k < n; ++k) pricer.generate(pathsPerOp);
+        return Sample{ pricer(), NaN };
+    }, [&]() {
+        return heston.callPrice(S0, r, K, T);
+    } });
+
+    // Couverture en delta hebdomadaire d'un call vendu, volatilité réelle égale à l'implicite : le P&L moyen
+    // actualisé tend vers 0 ; l'erreur rapportée est la demi-largeur de l'intervalle de confiance de la moyenne.
+    benchmarks.push_back({ "HedgingSimulator/call/rebalances=52/paths", static_cast<double>(pathsPerOp), [&](long long n) {
+        HedgingSimulator simulator(&call, S0, r, sigma, 52);
+        for (long long k = 0; k < n; ++k) simulator.generate(pathsPerOp);
+        return Sample{ simulator.mean(), 0.0, simulator.confidenceInterval()[1] - simulator.mean() };
+    } });
+
+    // Barrière down-and-out surveillée en continu : la formule de Reiner-Rubinstein est vérifiée par parité in/out,
+    // puis sert de référence aux méthodes numériques. Le Monte
+    // Carlo ne simule qu'un pas (pont brownien) et le CRR utilise la profondeur alignée sur la barrière.
+    BarrierCallOption downOut(T, K, 0.9 * S0, BarrierOption::DownAndOut);
+    BarrierCallOption downIn(T, K, 0.9 * S0, BarrierOption::DownAndIn);
+    const double barrierRef = BlackScholesPricer(&downOut, S0, r, sigma)();
+    const double inOutParityRef = callRef - BlackScholesPricer(&downIn, S0, r, sigma)();
+    benchmarks.push_back({ "BlackScholesPricer/down_out_call/price", 1.0, [&](long long n) {
+        double acc = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            BlackScholesPricer pricer(&downOut, S0 + 1e-9 * static_cast<double>(k & 7), r, sigma);
+            acc += pricer();
+        }
+        sink = acc;
+        return Sample{ barrierRef, inOutParityRef };
+    } });
+    benchmarks.push_back({ "BlackScholesMCPricer/down_out_call/bridge/paths", static_cast<double>(pathsPerOp), [&](long long n) {
+        BlackScholesMCPricer pricer(&downOut, S0, r, sigma);
+        for (long long k = 0; k < n; ++k) pricer.generate(pathsPerOp);
+        const std::vector<double> ci = pricer.confidenceInterval();
+        return Sample{ pricer(), barrierRef, 0.5 * (ci[1] - ci[0]) };
+    } });
+    benchmarks.push_back({ "CRRPricer/down_out_call/aligned/depth=" + std::to_string(std::min(1000, maxDepth)), 1.0, [&](long long n) {
+        double acc = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            CRRPricer pricer(&downOut, std::min(1000, maxDepth), S0, r, sigma);
+            acc += pricer();
+        }
+        sink = acc;
+        return Sample{ acc / static_cast<double>(n), barrierRef };
+    } });
+
+    // Multi-actifs : option d'échange (référence : formule de Margrabe) et panier de 5 actifs corrélés
+    const double rho = 0.4, sigma2 = 0.3;
+    const double exchangeVol = std::sqrt(sigma * sigma + sigma2 * sigma2 - 2.0 * rho * sigma * sigma2);
+    const double exchangeD1 = (std::log(S0 / K) + 0.5 * exchangeVol * exchangeVol * T) / (exchangeVol * std::sqrt(T));
+    const double margrabeRef = S0 * 0.5 * std::erfc(-exchangeD1 / std::sqrt(2.0))
+        - K * 0.5 * std::erfc(-(exchangeD1 - exchangeVol * std::sqrt(T)) / std::sqrt(2.0));
+    SpreadCallOption exchange(T, 0.0);
+    benchmarks.push_back({ "MultiAssetMCPricer/exchange/paths", static_cast<double>(pathsPerOp), [&](long long n) {
+        MultiAssetMCPricer pricer(&exchange, { S0, K }, r, { sigma, sigma2 }, { { 1.0, rho }, { rho, 1.0 } });
+        for (long long k = 0; k < n; ++k) pricer.generate(pathsPerOp);
+        const std::vector<double> ci = pricer.confidenceInterval();
+        return Sample{ pricer(), margrabeRef, 0.5 * (ci[1] - ci[0]) };
+    } });
+    BasketCallOption basket(T, std::vector<double>(5, 0.2), K);
+    std::vector<std::vector<double>> basketCorrelation(5, std::vector<double>(5, 0.5));
+    for (int a = 0; a < 5; ++a) basketCorrelation[a][a] = 1.0;
+    benchmarks.push_back({ "MultiAssetMCPricer/basket5/paths", static_cast<double>(pathsPerOp), [&](long long n) {
+        MultiAssetMCPricer pricer(&basket, std::vector<double>(5, S0), r, std::vector<double>(5, sigma), basketCorrelation);
+        for (long long k = 0; k < n; ++k) pricer.generate(pathsPerOp);
+        const std::vector<double> ci = pricer.confidenceInterval();
+        return Sample{ pricer(), NaN, 0.5 * (ci[1] - ci[0]) };
+    } });
+
+    for (int fixings : { 4, 12, 52, 252 }) {
+        std::vector<double> dates;
+        for (int k = 1; k <= fixings; ++k) dates.push_back(T * k / fixings);
+        auto asian = std::make_shared<AsianCallOption>(dates, K);
+
+        benchmarks.push_back({ "BlackScholesMCPricer/asian_call/paths/m=" + std::to_string(fixings),
+            static_cast<double>(pathsPerOp), [asian, S0, r, sigma, pathsPerOp](long long n) {
+            BlackScholesMCPricer pricer(asian.get(), S0, r, sigma);
+            for (long long k = 0; k < n; ++k) pricer.generate(pathsPerOp);
+            const std::vector<double> ci = pricer.confidenceInterval();
+            return Sample{ pricer(), NaN, 0.5 * (ci[1] - ci[0]) };
+        } });
+
+        // Même produit décrit par un script : bytecode évalué par lots de chemins
+        auto scripted = std::make_shared<ScriptedOption>("K = " + std::to_string(K) + "; max(average(S) - K, 0)", dates);
+        benchmarks.push_back({ "BlackScholesMCPricer/scripted_asian_call/paths/m=" + std::to_string(fixings),
+            static_cast<double>(pathsPerOp), [scripted, S0, r, sigma, pathsPerOp](long long n) {
+            BlackScholesMCPricer pricer(scripted.get(), S0, r, sigma);
+            for (long long k = 0; k < n; ++k) pricer.generate(pathsPerOp);
+            const std::vector<double> ci = pricer.confidenceInterval();
+            return Sample{ pricer(), NaN, 0.5 * (ci[1] - ci[0]) };
+        } });
+
+        // Payoff seul sur 4096 chemins fixes : appel virtuel par chemin contre une évaluation du bytecode par lot
+        // de 64 chemins (observations rangées par date) ; les deux moyennes doivent coïncider.
+        const int payoffPaths = 4096;
+        auto observations = std::make_shared<std::vector<double>>(static_cast<std::size_t>(fixings) * payoffPaths);
+        for (double& x : *observations) x = S0 * std::exp(sigma * MT::rand_norm());
+        benchmarks.push_back({ "AsianCallOption/payoffPath/m=" + std::to_string(fixings), static_cast<double>(payoffPaths),
+            [asian, observations, fixings, payoffPaths](long long n) {
+            std::vector<double> path(static_cast<std::size_t>(fixings));
+            double sum = 0.0;
+            for (long long k = 0; k < n; ++k) {
+                sum = 0.0;
+                for (int p = 0; p < payoffPaths; ++p) {
+                    for (int j = 0; j < fixings; ++j) path[j] = (*observations)[static_cast<std::size_t>(j) * payoffPaths + p];
+                    sum += asian->payoffPath(path);
+                }
+            }
+            return Sample{ sum / payoffPaths, NaN };
+        } });
+        benchmarks.push_back({ "PayoffScript/asian_call/eval/m=" + std::to_string(fixings), static_cast<double>(payoffPaths),
+            [scripted, observations, payoffPaths](long long n) {
+            std::vector<double> result(payoffPaths), workspace;
+            const int L = BlackScholesMCPricer::SCRIPT_LANES;
+            for (long long k = 0; k < n; ++k) {
+                for (int p = 0; p < payoffPaths; p += L) {
+                    scripted->getScript().evaluate(observations->data() + p, payoffPaths, L, result.data() + p, workspace);
+                }
+            }
+            double sum = 0.0;
+            for (const double x : result) sum += x;
+            return Sample{ sum / payoffPaths, NaN };
+        } });
+
+        // Pricer analytique : la référence est une estimation Monte Carlo longue
+        benchmarks.push_back({ "AsianAnalyticPricer/asian_call/m=" + std::to_string(fixings), 1.0,
+            [asian, S0, r, sigma](long long n) {
+            double acc = 0.0;
+            for (long long k = 0; k < n; ++k) {
+                AsianAnalyticPricer pricer(asian.get(), S0 + 1e-9 * static_cast<double>(k & 7), r, sigma);
+                acc += pricer();
+            }
+            sink = acc;
+            return Sample{ AsianAnalyticPricer(asian.get(), S0, r, sigma)(), NaN };
+        }, [asian, S0, r, sigma]() {
+            return AsianAnalyticPricer(asian.get(), S0, r, sigma).errorEstimate(200000).monteCarlo;
+        } });
+    }
+
+    // Générateur aléatoire : tirages gaussiens par seconde ; précision : écart de la moyenne empirique à 0
+    const int drawsPerOp = 100000;
+    benchmarks.push_back({ "MT/rand_norm", static_cast<double>(drawsPerOp), [&](long long n) {
+        double sum = 0.0;
+        long long count = 0;
+        for (long long k = 0; k < n; ++k) {
+            for (int j = 0; j < drawsPerOp; ++j) sum += MT::rand_norm();
+            count += drawsPerOp;
+        }
+        return Sample{ sum / static_cast<double>(count), 0.0 };
+    } });
+
+    // Exécution asynchrone : 64 puts américains soumis au pool, contrôle d'annulation attaché (surcoût des points
+    // de contrôle et de l'ordonnancement) ; la référence est le même arbre calculé de manière synchrone.
+    const int jobsPerOp = 64;
+    auto scheduler = std::make_shared<PricingScheduler>();
+    benchmarks.push_back({ "PricingScheduler/american_put/N=500/jobs", static_cast<double>(jobsPerOp), [&, scheduler](long long n) {
+        double value = 0.0;
+        for (long long k = 0; k < n; ++k) {
+            std::vector<PricingScheduler::Ticket<double>> tickets;
+            for (int j = 0; j < jobsPerOp; ++j) {
+                tickets.push_back(scheduler->submit([&](PricingControl& control) {
+                    CRRPricer pricer(&americanPut, 500, S0, r, sigma);
+                    pricer.setControl(&control);
+                    return pricer();
+                }));
+            }
+            for (PricingScheduler::Ticket<double>& ticket : tickets) value = ticket.result.get();
+        }
+        return Sample{ value, NaN };
+    }, [&]() {
+        return CRRPricer(&americanPut, 500, S0, r, sigma)();
+    } });
+
+    // Cache de prix avec intervalles de spot de 1 : les requêtes voisines tombent dans l'entrée de la première et
+    // retournent son prix sans recalcul (un recalcul au spot décalé s'écarterait de la référence).
+    benchmarks.push_back({ "PricingCache/black_scholes/bucket_hit", 1.0, [&](long long n) {
+        PricingCache cache(1024);
+        const MarketBuckets buckets{ 1.0, 0.0, 0.0 };
+        double value = NaN;
+        for (long long k = 0; k < n; ++k) {
+            const double spot = S0 + 0.4 * static_cast<double>(k % 2);
+            value = cache.getOrCompute(PricingKey::blackScholes(call, spot, r, sigma, buckets), [&]() {
+                return BlackScholesPricer(&call, spot, r, sigma)();
+            });
+        }
+        return Sample{ value, callRef };
+    } });
+
+    // Ordonnancement et annulation sur un pool d'un thread bloqué par un premier job : le job interactif passe
+    // devant le job batch soumis avant lui, et les deux jobs annulés (l'un en attente, l'autre en cours ou en
+    // attente selon le moment) lèvent PricingCancelled. Valeur : nombre de vérifications réussies sur 3.
+    benchmarks.push_back({ "PricingScheduler/priority_and_cancel/jobs", 4.0, [&](long long n) {
+        auto isCancelled = [](auto& ticket) {
+            try {
+                ticket.result.get();
+                return false;
+            }
+            catch (const PricingCancelled&) {
+                return true;
+            }
+        };
+        int passed = 0;
+        for (long long k = 0; k < n; ++k) {
+            PricingScheduler pool(1);
+            std::promise<void> open;
+            std::shared_future<void> gate = open.get_future().share();
+            std::vector<int> order;	// écrit par le seul thread du pool, lu après les futures
+
+            auto blocker = pool.submit([gate](PricingControl& control) {
+                gate.wait();
+                control.checkpoint();
+                return 0;
+            });
+            auto batch = pool.submit([&order](PricingControl&) { order.push_back(1); return 1; }, PricingScheduler::Batch);
+            auto dropped = pool.submit([&order](PricingControl&) { order.push_back(3); return 3; }, PricingScheduler::Batch);
+            auto interactive = pool.submit([&order](PricingControl&) { order.push_back(2); return 2; }, PricingScheduler::Interactive);
+            dropped.cancel();
+            blocker.cancel();
+            open.set_value();
+
+            passed = isCancelled(blocker) + isCancelled(dropped);
+            interactive.result.get();
+            batch.result.get();
+            passed += order == std::vector<int>{ 2, 1 };
+        }
+        return Sample{ static_cast<double>(passed), 3.0 };
+    } });
+
+    std::cout << std::left << std::setw(44) << "benchmark" << std::right
+        << std::setw(14) << "ns/op" << std::setw(14) << "items/s"
+        << std::setw(14) << "value" << std::setw(14) << "reference" << std::setw(14) << "abs_error" << std::endl;
+
+    std::vector<Result> results;
+    for (const Benchmark& b : benchmarks) {
+        if (!filter.empty() && b.name.find(filter) == std::string::npos) continue;
+        results.push_back(measure(b, minTime));
+        printResult(results.back());
+    }
+
+    writeJson(outPath, results);
+    std::cout << std::endl << "Results written to " << outPath << std::endl;
+    return 0;
+}